@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Arena.h"
+
+#include <cstdint>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+constexpr size_t RequestArena::c_defaultBlockSize;
+
+RequestArena::Block::Block(size_t size)
+	: data(new char[size])
+	, size(size)
+	, used(0)
+	, allocations(0)
+{
+}
+
+void* RequestArena::Block::tryAllocate(size_t bytes, size_t alignment)
+{
+	const auto address = reinterpret_cast<std::uintptr_t>(data.get());
+	auto offset = used.load(std::memory_order_relaxed);
+	size_t padding;
+
+	do
+	{
+		padding = (alignment - ((address + offset) % alignment)) % alignment;
+
+		if (padding + bytes > size - offset)
+		{
+			return nullptr;
+		}
+	} while (!used.compare_exchange_weak(offset, offset + padding + bytes, std::memory_order_relaxed));
+
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	return data.get() + offset + padding;
+}
+
+RequestArena::RequestArena(size_t blockSize)
+	: _blockSize(blockSize)
+	, _current(nullptr)
+{
+}
+
+void* RequestArena::allocate(size_t bytes, size_t alignment)
+{
+	// Anything bigger than a quarter of a block gets a block of its own, so it doesn't waste the
+	// rest of the current one.
+	const bool ownBlock = (bytes + alignment > _blockSize / 4);
+
+	if (!ownBlock)
+	{
+		auto current = _current.load(std::memory_order_acquire);
+
+		if (current != nullptr)
+		{
+			auto result = current->tryAllocate(bytes, alignment);
+
+			if (result != nullptr)
+			{
+				return result;
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (ownBlock)
+	{
+		std::unique_ptr<Block> block(new Block(bytes + alignment));
+		auto result = block->tryAllocate(bytes, alignment);
+
+		_blocks.push_back(std::move(block));
+
+		return result;
+	}
+
+	// Another thread may have started a new block while this one was waiting for the lock.
+	auto current = _current.load(std::memory_order_relaxed);
+
+	if (current != nullptr)
+	{
+		auto result = current->tryAllocate(bytes, alignment);
+
+		if (result != nullptr)
+		{
+			return result;
+		}
+	}
+
+	std::unique_ptr<Block> block(new Block(_blockSize));
+	auto result = block->tryAllocate(bytes, alignment);
+
+	_current.store(block.get(), std::memory_order_release);
+	_blocks.push_back(std::move(block));
+
+	return result;
+}
+
+size_t RequestArena::getAllocatedBytes() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t allocatedBytes = 0;
+
+	for (const auto& block : _blocks)
+	{
+		allocatedBytes += block->used.load(std::memory_order_relaxed);
+	}
+
+	return allocatedBytes;
+}
+
+size_t RequestArena::getAllocationCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t allocationCount = 0;
+
+	for (const auto& block : _blocks)
+	{
+		allocationCount += block->allocations.load(std::memory_order_relaxed);
+	}
+
+	return allocationCount;
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
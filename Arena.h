@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// RequestArena is a monotonic buffer for the short-lived allocations in a single operation. It
+// hands out memory from large blocks and never frees anything until the arena itself goes away,
+// so the whole operation is released in one shot. It's safe to allocate from several threads:
+// most allocations just bump an atomic offset in the current block, and only starting a new block
+// takes the lock. The operation owns the arena and keeps it alive until every field is resolved.
+class RequestArena : public std::enable_shared_from_this<RequestArena>
+{
+public:
+	static constexpr size_t c_defaultBlockSize = 16 * 1024;
+
+	explicit RequestArena(size_t blockSize = c_defaultBlockSize);
+
+	void* allocate(size_t bytes, size_t alignment);
+
+	// Allocate an object and its shared_ptr control block from the arena. Unlike the rest of the
+	// arena, the control block holds a reference to it, so it's still safe to keep the object after
+	// the operation is done. The arena must be owned by a shared_ptr to use this.
+	template <typename _Type, typename... _Args>
+	std::shared_ptr<_Type> make_shared(_Args&&... args);
+
+	// Bytes handed out by the arena, including any padding for alignment.
+	size_t getAllocatedBytes() const;
+	size_t getAllocationCount() const;
+
+private:
+	struct Block
+	{
+		explicit Block(size_t size);
+
+		void* tryAllocate(size_t bytes, size_t alignment);
+
+		const std::unique_ptr<char[]> data;
+		const size_t size;
+		std::atomic<size_t> used;
+		std::atomic<size_t> allocations;
+	};
+
+	const size_t _blockSize;
+
+	// The current block is only replaced, never freed, while the arena is alive, so threads which
+	// are still bumping the old one don't need the lock.
+	std::atomic<Block*> _current;
+
+	mutable std::mutex _mutex;
+	std::vector<std::unique_ptr<Block>> _blocks;
+};
+
+// ArenaAllocator lets standard containers and promises use a RequestArena. It only holds a pointer
+// to the arena, so copying it is free, and deallocate does nothing. The arena has to outlive
+// everything allocated from it.
+template <typename _Type>
+class ArenaAllocator
+{
+public:
+	using value_type = _Type;
+
+	explicit ArenaAllocator(RequestArena& arena) noexcept
+		: _arena(&arena)
+	{
+	}
+
+	template <typename _Other>
+	ArenaAllocator(const ArenaAllocator<_Other>& other) noexcept
+		: _arena(other._arena)
+	{
+	}
+
+	_Type* allocate(size_t count)
+	{
+		return static_cast<_Type*>(_arena->allocate(count * sizeof(_Type), alignof(_Type)));
+	}
+
+	void deallocate(_Type* /*pointer*/, size_t /*count*/) noexcept
+	{
+	}
+
+	template <typename _Other>
+	bool operator==(const ArenaAllocator<_Other>& other) const noexcept
+	{
+		return _arena == other._arena;
+	}
+
+	template <typename _Other>
+	bool operator!=(const ArenaAllocator<_Other>& other) const noexcept
+	{
+		return _arena != other._arena;
+	}
+
+private:
+	template <typename _Other>
+	friend class ArenaAllocator;
+
+	RequestArena* _arena;
+};
+
+// SharedArenaAllocator is what RequestArena::make_shared gives std::allocate_shared. The copy in
+// the control block keeps the arena alive for as long as the object is.
+template <typename _Type>
+class SharedArenaAllocator
+{
+public:
+	using value_type = _Type;
+
+	explicit SharedArenaAllocator(std::shared_ptr<RequestArena> arena) noexcept
+		: _arena(std::move(arena))
+	{
+	}
+
+	template <typename _Other>
+	SharedArenaAllocator(const SharedArenaAllocator<_Other>& other) noexcept
+		: _arena(other._arena)
+	{
+	}
+
+	_Type* allocate(size_t count)
+	{
+		return static_cast<_Type*>(_arena->allocate(count * sizeof(_Type), alignof(_Type)));
+	}
+
+	void deallocate(_Type* /*pointer*/, size_t /*count*/) noexcept
+	{
+	}
+
+	template <typename _Other>
+	bool operator==(const SharedArenaAllocator<_Other>& other) const noexcept
+	{
+		return _arena == other._arena;
+	}
+
+	template <typename _Other>
+	bool operator!=(const SharedArenaAllocator<_Other>& other) const noexcept
+	{
+		return _arena != other._arena;
+	}
+
+private:
+	template <typename _Other>
+	friend class SharedArenaAllocator;
+
+	std::shared_ptr<RequestArena> _arena;
+};
+
+template <typename _Type, typename... _Args>
+std::shared_ptr<_Type> RequestArena::make_shared(_Args&&... args)
+{
+	return std::allocate_shared<_Type>(SharedArenaAllocator<_Type>(shared_from_this()), std::forward<_Args>(args)...);
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "CacheControl.h"
+
+#include <algorithm>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+void CachePolicy::addHint(const CacheHint& hint)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (!_hasHints
+		|| hint.maxAge < _hint.maxAge)
+	{
+		_hint.maxAge = hint.maxAge;
+	}
+
+	if (hint.scope == CacheScope::Private)
+	{
+		_hint.scope = CacheScope::Private;
+	}
+
+	_hasHints = true;
+}
+
+bool CachePolicy::isCacheable() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _hasHints
+		&& _hint.maxAge > 0;
+}
+
+CacheHint CachePolicy::getHint() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _hint;
+}
+
+web::json::value CachePolicy::toJson(const CacheHint& hint)
+{
+	return web::json::value::object({
+		{ _XPLATSTR("maxAge"), web::json::value::number(static_cast<int64_t>(hint.maxAge)) },
+		{ _XPLATSTR("scope"), web::json::value::string((hint.scope == CacheScope::Private)
+			? _XPLATSTR("PRIVATE")
+			: _XPLATSTR("PUBLIC")) }
+		}, true);
+}
+
+CacheHint CachedResult::getRemainingHint(std::chrono::steady_clock::time_point now) const
+{
+	const auto maxAge = stored + std::chrono::seconds(hint.maxAge);
+
+	if (maxAge <= now)
+	{
+		return { 0, hint.scope };
+	}
+
+	return { static_cast<size_t>(std::chrono::duration_cast<std::chrono::seconds>(maxAge - now).count()), hint.scope };
+}
+
+constexpr size_t MemoryResultCache::c_defaultMaxEntries;
+
+MemoryResultCache::MemoryResultCache(size_t maxEntries)
+	: _maxEntries(maxEntries)
+{
+}
+
+std::shared_ptr<const CachedResult> MemoryResultCache::find(const std::string& key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto itr = _entries.find(key);
+
+	if (itr == _entries.end())
+	{
+		return nullptr;
+	}
+
+	if (itr->second.expires <= Clock::now())
+	{
+		_entries.erase(itr);
+		return nullptr;
+	}
+
+	return itr->second.result;
+}
+
+void MemoryResultCache::store(const std::string& key, std::shared_ptr<const CachedResult> result)
+{
+	if (_maxEntries == 0)
+	{
+		return;
+	}
+
+	const auto now = Clock::now();
+	const auto expires = result->stored + std::chrono::seconds(result->hint.maxAge);
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_entries.find(key) == _entries.end()
+		&& _entries.size() >= _maxEntries)
+	{
+		evict(now);
+	}
+
+	_entries[key] = { std::move(result), expires };
+}
+
+size_t MemoryResultCache::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _entries.size();
+}
+
+void MemoryResultCache::evict(Clock::time_point now)
+{
+	for (auto itr = _entries.begin(); itr != _entries.end();)
+	{
+		if (itr->second.expires <= now)
+		{
+			itr = _entries.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
+
+	if (!_entries.empty()
+		&& _entries.size() >= _maxEntries)
+	{
+		auto soonest = std::min_element(_entries.begin(), _entries.end(),
+			[](const std::pair<const std::string, Entry>& lhs, const std::pair<const std::string, Entry>& rhs)
+		{
+			return lhs.second.expires < rhs.second.expires;
+		});
+
+		_entries.erase(soonest);
+	}
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
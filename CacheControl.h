@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// CachePolicy combines all of the cache hints which were added while resolving an operation. It's
+// only cacheable if there was at least one hint and none of them had a maxAge of 0.
+class CachePolicy
+{
+public:
+	void addHint(const CacheHint& hint);
+
+	bool isCacheable() const;
+	CacheHint getHint() const;
+
+	// Returns an object with the maxAge and scope, for extensions.cacheControl in the response.
+	static web::json::value toJson(const CacheHint& hint);
+
+private:
+	mutable std::mutex _mutex;
+	bool _hasHints = false;
+	CacheHint _hint { 0, CacheScope::Public };
+};
+
+// A response in the ResultCache, along with the policy it was cached with and when it was stored.
+// Responses served from the cache only report the part of the maxAge which is left.
+struct CachedResult
+{
+	web::json::value data;
+	CacheHint hint;
+	std::chrono::steady_clock::time_point stored;
+
+	CacheHint getRemainingHint(std::chrono::steady_clock::time_point now) const;
+};
+
+// ResultCache stores the data for query responses which were cacheable, so later requests with the
+// same query, operation name, variables, and scope can skip executing them. Keys are SHA-256 hashes
+// in lowercase hex. Implementations should stop returning a result once its maxAge has passed.
+class ResultCache
+{
+public:
+	virtual ~ResultCache() = default;
+
+	virtual std::shared_ptr<const CachedResult> find(const std::string& key) = 0;
+	virtual void store(const std::string& key, std::shared_ptr<const CachedResult> result) = 0;
+};
+
+// MemoryResultCache keeps up to maxEntries results in memory until they expire. When it's full, it
+// drops the expired results first, and then the ones which expire soonest. It's safe to share
+// between threads.
+class MemoryResultCache : public ResultCache
+{
+public:
+	static constexpr size_t c_defaultMaxEntries = 1000;
+
+	explicit MemoryResultCache(size_t maxEntries = c_defaultMaxEntries);
+
+	std::shared_ptr<const CachedResult> find(const std::string& key) override;
+	void store(const std::string& key, std::shared_ptr<const CachedResult> result) override;
+
+	size_t size() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		std::shared_ptr<const CachedResult> result;
+		Clock::time_point expires;
+	};
+
+	void evict(Clock::time_point now);
+
+	const size_t _maxEntries;
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, Entry> _entries;
+};
+
+// FieldCache lets an expensive getter reuse its values across operations for the maxAge in its
+// hint. Each call adds a cache hint for however long the value has left, so a response is never
+// cached for longer than the values in it. Expired values are replaced the next time they're
+// requested, or dropped all at once with clear.
+template <typename _Key, typename _Value>
+class FieldCache
+{
+public:
+	explicit FieldCache(CacheHint hint)
+		: _hint(hint)
+	{
+	}
+
+	// Return the cached value for the key if it hasn't expired, otherwise call the loader outside of
+	// the lock and cache what it returns.
+	template <typename _Loader>
+	_Value get(const FieldParams& params, const _Key& key, _Loader&& loader)
+	{
+		const auto now = Clock::now();
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto itr = _entries.find(key);
+
+			if (itr != _entries.end()
+				&& itr->second.expires > now)
+			{
+				addCacheHint(params.operation, { getRemainingAge(itr->second.expires, now), _hint.scope });
+				return itr->second.value;
+			}
+		}
+
+		_Value value = loader(key);
+		const auto expires = now + std::chrono::seconds(_hint.maxAge);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			_entries[key] = { value, expires };
+		}
+
+		addCacheHint(params.operation, _hint);
+
+		return value;
+	}
+
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_entries.clear();
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		_Value value;
+		Clock::time_point expires;
+	};
+
+	static size_t getRemainingAge(Clock::time_point expires, Clock::time_point now)
+	{
+		return static_cast<size_t>(std::chrono::duration_cast<std::chrono::seconds>(expires - now).count());
+	}
+
+	const CacheHint _hint;
+
+	std::mutex _mutex;
+	std::map<_Key, Entry> _entries;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
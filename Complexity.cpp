@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Complexity.h"
+
+#include <limits>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+namespace {
+
+size_t saturatingAdd(size_t lhs, size_t rhs)
+{
+	return (lhs > std::numeric_limits<size_t>::max() - rhs)
+		? std::numeric_limits<size_t>::max()
+		: lhs + rhs;
+}
+
+size_t saturatingMultiply(size_t lhs, size_t rhs)
+{
+	return (rhs != 0 && lhs > std::numeric_limits<size_t>::max() / rhs)
+		? std::numeric_limits<size_t>::max()
+		: lhs * rhs;
+}
+
+class ComplexityVisitor
+{
+public:
+	ComplexityVisitor(const web::json::object& variables, const ComplexityLimits& limits)
+		: _variables(variables)
+		, _limits(limits)
+	{
+	}
+
+	OperationComplexity getComplexity() const
+	{
+		return { _maxDepth, _cost };
+	}
+
+	void visit(const SelectionSetPlan& selection, size_t depth, size_t multiplier)
+	{
+		if (depth > _maxDepth)
+		{
+			_maxDepth = depth;
+		}
+
+		// Deferred fragments still get resolved eventually, so they count at the same depth.
+		for (const auto& deferred : selection.deferred)
+		{
+			visit(*deferred.selection, depth, multiplier);
+		}
+
+		for (const auto& field : selection.fields)
+		{
+			if (field.skip)
+			{
+				continue;
+			}
+
+			_cost = saturatingAdd(_cost, saturatingMultiply(multiplier, getFieldCost(field.name)));
+
+			if ((_limits.maxCost != 0 && _cost > _limits.maxCost)
+				|| (_limits.maxDepth != 0 && _maxDepth > _limits.maxDepth))
+			{
+				// There's no need to keep walking a plan which is already over the limit.
+				return;
+			}
+
+			if (field.selection)
+			{
+				visit(*field.selection, depth + 1, saturatingMultiply(multiplier, getListSize(field)));
+			}
+		}
+	}
+
+private:
+	size_t getFieldCost(const std::string& name) const
+	{
+		auto itr = _limits.fieldCosts.find(name);
+
+		return (itr == _limits.fieldCosts.cend())
+			? 1
+			: itr->second;
+	}
+
+	// Connections take the number of edges in first or last, anything else just counts once.
+	size_t getListSize(const FieldPlan& field) const
+	{
+		size_t listSize = 1;
+
+		const auto checkSize = [&listSize](const web::json::value& value)
+		{
+			if (value.is_integer()
+				&& value.as_integer() > 0
+				&& static_cast<size_t>(value.as_integer()) > listSize)
+			{
+				listSize = static_cast<size_t>(value.as_integer());
+			}
+		};
+
+		for (const auto name : { _XPLATSTR("first"), _XPLATSTR("last") })
+		{
+			const auto& arguments = field.arguments.as_object();
+			auto itr = arguments.find(name);
+
+			if (itr != arguments.cend())
+			{
+				checkSize(itr->second);
+			}
+		}
+
+		for (const auto& argument : field.variableArguments)
+		{
+			if (argument.first == _XPLATSTR("first")
+				|| argument.first == _XPLATSTR("last"))
+			{
+				ValueVisitor visitor(_variables);
+
+				argument.second->accept(&visitor);
+				checkSize(visitor.getValue());
+			}
+		}
+
+		return listSize;
+	}
+
+	const web::json::object& _variables;
+	const ComplexityLimits& _limits;
+
+	size_t _maxDepth = 0;
+	size_t _cost = 0;
+};
+
+} /* namespace */
+
+OperationComplexity measureComplexity(const SelectionSetPlan& selection, const web::json::object& variables, const ComplexityLimits& limits)
+{
+	ComplexityVisitor visitor(variables, limits);
+
+	visitor.visit(selection, 1, 1);
+
+	return visitor.getComplexity();
+}
+
+void checkComplexity(const SelectionSetPlan& selection, const web::json::object& variables, const ComplexityLimits& limits)
+{
+	const auto complexity = measureComplexity(selection, variables, limits);
+
+	if (limits.maxDepth != 0
+		&& complexity.depth > limits.maxDepth)
+	{
+		std::ostringstream error;
+
+		error << "Query is too deep, depth: " << complexity.depth
+			<< " limit: " << limits.maxDepth;
+
+		throw schema_exception({ error.str() });
+	}
+
+	if (limits.maxCost != 0
+		&& complexity.cost > limits.maxCost)
+	{
+		std::ostringstream error;
+
+		error << "Query is too complex, cost: " << complexity.cost
+			<< " limit: " << limits.maxCost;
+
+		throw schema_exception({ error.str() });
+	}
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// ComplexityLimits are checked against every operation before any of its resolvers run. Each field
+// costs 1 unless it's in fieldCosts, and if it has a first or last argument, everything beneath it
+// is multiplied by that many elements. A limit of 0 means there's no limit.
+struct ComplexityLimits
+{
+	size_t maxDepth;
+	size_t maxCost;
+	std::unordered_map<std::string, size_t> fieldCosts;
+};
+
+// The measured complexity of a single operation. If the cost goes over the limit, measuring stops
+// early and cost is just somewhere past maxCost.
+struct OperationComplexity
+{
+	size_t depth;
+	size_t cost;
+};
+
+// Measure the depth and cost of a selection set, resolving any first or last arguments which
+// refer to variables. Type conditions and @skip or @include directives which depend on variables
+// aren't evaluated, so every field which might be resolved is counted.
+OperationComplexity measureComplexity(const SelectionSetPlan& selection, const web::json::object& variables, const ComplexityLimits& limits);
+
+// Throw a schema_exception if the operation is too deep or too expensive.
+void checkComplexity(const SelectionSetPlan& selection, const web::json::object& variables, const ComplexityLimits& limits);
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// DataLoaderScope holds the pending keys and memoized values for every DataLoader used in a single
+// operation. Request creates one for each operation, so nothing is shared between requests.
+class DataLoaderScope
+{
+public:
+	// Find or create the state for one DataLoader.
+	template <typename _State>
+	std::shared_ptr<_State> getState(const void* loader)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& state = _states[loader];
+
+		if (!state)
+		{
+			state = std::make_shared<_State>();
+		}
+
+		return std::static_pointer_cast<_State>(state);
+	}
+
+private:
+	std::mutex _mutex;
+	std::unordered_map<const void*, std::shared_ptr<void>> _states;
+};
+
+// DataLoader collects the keys which field getters ask for and loads them all with a single call
+// to the batch function the first time one of them is joined. Since every field in a selection
+// set, and every object in a list, is started before any of them are joined, even with an
+// executor or std::launch::async, that's usually all of the keys at the same depth in the
+// response. Values are memoized for the rest of the operation, and the same DataLoader can be
+// shared by every request.
+template <typename _Key, typename _Value>
+class DataLoader
+{
+public:
+	// The batch function gets each of the keys once and returns the values in the same order.
+	using BatchFunction = std::function<std::vector<_Value>(const std::vector<_Key>& keys)>;
+
+	explicit DataLoader(BatchFunction&& batch)
+		: _batch(std::move(batch))
+	{
+	}
+
+	FieldResult<_Value> load(const FieldParams& params, const _Key& key) const
+	{
+		auto state = params.operation.loaders.getState<State>(this);
+		std::shared_ptr<Entry> entry;
+
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			auto& found = state->entries[key];
+
+			if (found
+				&& found->loaded
+				&& !found->error)
+			{
+				return _Value(found->value);
+			}
+
+			if (!found)
+			{
+				found = std::make_shared<Entry>();
+				state->pendingKeys.push_back(key);
+				state->pendingEntries.push_back(found);
+			}
+
+			entry = found;
+		}
+
+		return std::async(std::launch::deferred,
+			[this, state, entry]()
+		{
+			return join(*state, *entry);
+		});
+	}
+
+	FieldResult<std::vector<_Value>> loadMany(const FieldParams& params, const std::vector<_Key>& keys) const
+	{
+		std::vector<FieldResult<_Value>> results;
+
+		results.reserve(keys.size());
+
+		for (const auto& key : keys)
+		{
+			results.push_back(load(params, key));
+		}
+
+		return std::async(std::launch::deferred,
+			[](std::vector<FieldResult<_Value>>&& resultsArg)
+		{
+			std::vector<_Value> values;
+
+			values.reserve(resultsArg.size());
+
+			for (auto& result : resultsArg)
+			{
+				values.push_back(result.get());
+			}
+
+			return values;
+		}, std::move(results));
+	}
+
+private:
+	struct Entry
+	{
+		bool dispatched = false;
+		bool loaded = false;
+		_Value value;
+		std::exception_ptr error;
+	};
+
+	struct State
+	{
+		std::mutex mutex;
+		std::condition_variable loaded;
+		std::map<_Key, std::shared_ptr<Entry>> entries;
+		std::vector<_Key> pendingKeys;
+		std::vector<std::shared_ptr<Entry>> pendingEntries;
+	};
+
+	_Value join(State& state, Entry& entry) const
+	{
+		std::unique_lock<std::mutex> lock(state.mutex);
+
+		if (!entry.dispatched)
+		{
+			dispatch(state, lock);
+		}
+
+		state.loaded.wait(lock, [&entry]()
+		{
+			return entry.loaded;
+		});
+
+		if (entry.error)
+		{
+			std::rethrow_exception(entry.error);
+		}
+
+		return entry.value;
+	}
+
+	// Call the batch function with all of the pending keys, without holding the lock so other
+	// threads can keep adding keys for the next batch.
+	void dispatch(State& state, std::unique_lock<std::mutex>& lock) const
+	{
+		auto keys = std::move(state.pendingKeys);
+		auto entries = std::move(state.pendingEntries);
+
+		state.pendingKeys.clear();
+		state.pendingEntries.clear();
+
+		for (const auto& entry : entries)
+		{
+			entry->dispatched = true;
+		}
+
+		lock.unlock();
+
+		std::vector<_Value> values;
+		std::exception_ptr error;
+
+		try
+		{
+			values = _batch(keys);
+
+			if (values.size() != keys.size())
+			{
+				throw schema_exception({ "DataLoader batch function returned the wrong number of values" });
+			}
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		lock.lock();
+
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			entries[i]->loaded = true;
+
+			if (error)
+			{
+				entries[i]->error = error;
+			}
+			else
+			{
+				entries[i]->value = std::move(values[i]);
+			}
+		}
+
+		state.loaded.notify_all();
+	}
+
+	const BatchFunction _batch;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,110 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "DocumentCache.h"
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+constexpr size_t DocumentCache::c_defaultMaxEntries;
+constexpr size_t DocumentCache::c_defaultMaxBytes;
+constexpr size_t DocumentCache::c_estimatedBytesPerCharacter;
+
+DocumentCache::DocumentCache(size_t maxEntries, size_t maxBytes)
+	: _maxEntries(maxEntries)
+	, _maxBytes(maxBytes)
+{
+}
+
+size_t DocumentCache::estimateBytes(const std::string& query)
+{
+	return sizeof(Entry) + sizeof(ParsedDocument) + query.size() * c_estimatedBytesPerCharacter;
+}
+
+std::shared_ptr<const ParsedDocument> DocumentCache::get(const std::string& query, bool* hit)
+{
+	if (hit != nullptr)
+	{
+		*hit = false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto itr = _entries.find(query);
+
+		if (itr != _entries.end())
+		{
+			if (hit != nullptr)
+			{
+				*hit = true;
+			}
+
+			++_hits;
+			_lru.splice(_lru.begin(), _lru, itr->second.lru);
+			return itr->second.document;
+		}
+
+		++_misses;
+	}
+
+	// Parse outside of the lock so a slow document doesn't block every other request.
+	auto document = ParsedDocument::parse(query);
+	const size_t bytes = estimateBytes(query);
+
+	if (_maxEntries == 0
+		|| bytes > _maxBytes)
+	{
+		return document;
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto result = _entries.insert({ query, Entry { document, bytes, _lru.end() } });
+
+	if (!result.second)
+	{
+		// Another thread parsed the same query text first, share its copy.
+		_lru.splice(_lru.begin(), _lru, result.first->second.lru);
+		return result.first->second.document;
+	}
+
+	result.first->second.lru = _lru.insert(_lru.begin(), &result.first->first);
+	_bytes += bytes;
+	evict();
+
+	return document;
+}
+
+void DocumentCache::evict()
+{
+	while (!_lru.empty()
+		&& (_entries.size() > _maxEntries || _bytes > _maxBytes))
+	{
+		auto itr = _entries.find(*_lru.back());
+
+		_lru.pop_back();
+		_bytes -= itr->second.bytes;
+		_entries.erase(itr);
+		++_evictions;
+	}
+}
+
+void DocumentCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_entries.clear();
+	_lru.clear();
+	_bytes = 0;
+}
+
+DocumentCacheStats DocumentCache::getStats() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return { _hits, _misses, _evictions, _entries.size(), _bytes };
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
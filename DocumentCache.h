@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <list>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Snapshot of the DocumentCache counters.
+struct DocumentCacheStats
+{
+	size_t hits;
+	size_t misses;
+	size_t evictions;
+	size_t entries;
+	size_t bytes;
+};
+
+// DocumentCache keeps the most recently used ParsedDocument for each distinct query text, so
+// repeated requests skip parsing and compiling the execution plans. It is bounded both by the
+// number of entries and by an estimate of the memory they use, and it is safe to share between
+// threads. Documents which fail to parse are never cached.
+class DocumentCache
+{
+public:
+	static constexpr size_t c_defaultMaxEntries = 1000;
+	static constexpr size_t c_defaultMaxBytes = 16 * 1024 * 1024;
+
+	explicit DocumentCache(size_t maxEntries = c_defaultMaxEntries, size_t maxBytes = c_defaultMaxBytes);
+
+	// Return the cached document for this query text, parsing and adding it if it's not cached.
+	// Throws a schema_exception if the query text has syntax errors. If hit isn't null, it's set
+	// to whether the document was already cached.
+	std::shared_ptr<const ParsedDocument> get(const std::string& query, bool* hit = nullptr);
+
+	void clear();
+
+	DocumentCacheStats getStats() const;
+
+private:
+	// We can't measure the AST and the execution plans directly, so estimate them at a fixed
+	// multiple of the query text.
+	static constexpr size_t c_estimatedBytesPerCharacter = 16;
+
+	static size_t estimateBytes(const std::string& query);
+
+	void evict();
+
+	using LruList = std::list<const std::string*>;
+
+	struct Entry
+	{
+		std::shared_ptr<const ParsedDocument> document;
+		size_t bytes;
+		LruList::iterator lru;
+	};
+
+	const size_t _maxEntries;
+	const size_t _maxBytes;
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, Entry> _entries;
+	LruList _lru;
+	size_t _bytes = 0;
+	size_t _hits = 0;
+	size_t _misses = 0;
+	size_t _evictions = 0;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
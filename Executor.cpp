@@ -0,0 +1,232 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Executor.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+namespace {
+
+// Let the worker threads find their own queue when they post or help with tasks.
+thread_local ThreadPool* t_threadPool = nullptr;
+thread_local size_t t_queueIndex = 0;
+
+} /* namespace */
+
+Executor::~Executor()
+{
+}
+
+ThreadPool::ThreadPool(size_t threadCount)
+	: _nextQueue(0)
+{
+	threadCount = std::max<size_t>(threadCount, 1);
+	_queues.reserve(threadCount);
+	_threads.reserve(threadCount);
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		_queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+	}
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		_threads.push_back(std::thread(&ThreadPool::work, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_stopping = true;
+	}
+
+	_wake.notify_all();
+
+	for (auto& thread : _threads)
+	{
+		thread.join();
+	}
+}
+
+size_t ThreadPool::getThreadCount() const
+{
+	return _threads.size();
+}
+
+void ThreadPool::post(std::function<void()>&& task)
+{
+	const size_t index = (t_threadPool == this)
+		? t_queueIndex
+		: (_nextQueue++ % _queues.size());
+
+	// Count the task before anyone can steal it, otherwise popTask could decrement _pending first.
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		++_pending;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+
+		_queues[index]->tasks.push_back(std::move(task));
+	}
+
+	_wake.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+	std::function<void()> task;
+
+	if (!popTask((t_threadPool == this) ? t_queueIndex : 0, task))
+	{
+		return false;
+	}
+
+	task();
+	return true;
+}
+
+void ThreadPool::work(size_t index)
+{
+	t_threadPool = this;
+	t_queueIndex = index;
+
+	for (;;)
+	{
+		std::function<void()> task;
+
+		if (popTask(index, task))
+		{
+			task();
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+
+		if (_pending == 0)
+		{
+			if (_stopping)
+			{
+				break;
+			}
+
+			_wake.wait(lock, [this]()
+			{
+				return _stopping || _pending > 0;
+			});
+		}
+	}
+}
+
+bool ThreadPool::popTask(size_t index, std::function<void()>& task)
+{
+	// Take the newest task from our own queue first, then steal the oldest from everyone else.
+	for (size_t i = 0; i < _queues.size(); ++i)
+	{
+		auto& queue = *_queues[(index + i) % _queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (queue.tasks.empty())
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+
+		std::lock_guard<std::mutex> pendingLock(_mutex);
+
+		--_pending;
+		return true;
+	}
+
+	return false;
+}
+
+OperationExecutor::OperationExecutor(Executor& executor, size_t maxConcurrentTasks)
+	: _executor(executor)
+	, _maxConcurrentTasks(maxConcurrentTasks)
+	, _inFlight(std::make_shared<std::atomic<size_t>>(0))
+{
+}
+
+std::future<web::json::value> OperationExecutor::submit(std::function<web::json::value()>&& task)
+{
+	auto inFlight = _inFlight;
+
+	if (inFlight->fetch_add(1) >= _maxConcurrentTasks
+		&& _maxConcurrentTasks > 0)
+	{
+		inFlight->fetch_sub(1);
+
+		std::packaged_task<web::json::value()> inlineTask(std::move(task));
+		auto future = inlineTask.get_future();
+
+		inlineTask();
+		return future;
+	}
+
+	// Release the slot before the result is published, by then the caller might be gone.
+	auto scheduledTask = std::make_shared<std::packaged_task<web::json::value()>>([inFlight, task]()
+	{
+		struct InFlightGuard
+		{
+			~InFlightGuard()
+			{
+				inFlight->fetch_sub(1);
+			}
+
+			std::shared_ptr<std::atomic<size_t>> inFlight;
+		} guard { inFlight };
+
+		return task();
+	});
+	auto future = scheduledTask->get_future();
+
+	_executor.post([scheduledTask]()
+	{
+		(*scheduledTask)();
+	});
+
+	return future;
+}
+
+void OperationExecutor::wait(std::future<web::json::value>& future)
+{
+	while (future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout)
+	{
+		if (!_executor.runPendingTask())
+		{
+			// Everything else is already running, whoever is running it will help with any nested tasks.
+			future.wait();
+		}
+	}
+}
+
+web::json::value OperationExecutor::join(std::future<web::json::value>& future)
+{
+	wait(future);
+	return future.get();
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cpprest/json.h>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Executor runs the tasks for resolving fields on other threads. Anyone waiting for a task should
+// keep calling runPendingTask until it's done, so a bounded number of threads can't deadlock
+// waiting on tasks which are still in the queue.
+class Executor
+{
+public:
+	virtual ~Executor();
+
+	virtual void post(std::function<void()>&& task) = 0;
+
+	// Run one of the queued tasks on the calling thread, returns false if there weren't any.
+	virtual bool runPendingTask() = 0;
+};
+
+// ThreadPool is the default Executor, with a fixed number of worker threads which can be shared by
+// every request. Each worker has its own queue, tasks posted from a worker go on its own queue and
+// idle workers steal from the others, so nested fields tend to stay on the same thread.
+class ThreadPool : public Executor
+{
+public:
+	explicit ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+	~ThreadPool() override;
+
+	size_t getThreadCount() const;
+
+	void post(std::function<void()>&& task) override;
+	bool runPendingTask() override;
+
+private:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	void work(size_t index);
+	bool popTask(size_t index, std::function<void()>& task);
+
+	std::vector<std::unique_ptr<TaskQueue>> _queues;
+	std::vector<std::thread> _threads;
+	std::atomic<size_t> _nextQueue;
+
+	std::mutex _mutex;
+	std::condition_variable _wake;
+	size_t _pending = 0;
+	bool _stopping = false;
+};
+
+// OperationExecutor schedules the tasks for a single operation on a shared Executor. Once the
+// operation has maxConcurrentTasks in flight, new tasks run on the calling thread instead, which
+// keeps one big request from taking over the whole pool. A limit of 0 is unbounded.
+class OperationExecutor
+{
+public:
+	OperationExecutor(Executor& executor, size_t maxConcurrentTasks);
+
+	std::future<web::json::value> submit(std::function<web::json::value()>&& task);
+
+	// Run other tasks while waiting for this one to finish.
+	void wait(std::future<web::json::value>& future);
+	web::json::value join(std::future<web::json::value>& future);
+
+private:
+	Executor& _executor;
+	const size_t _maxConcurrentTasks;
+	std::shared_ptr<std::atomic<size_t>> _inFlight;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -2,9 +2,24 @@
 // Licensed under the MIT License.
 
 #include "GraphQLService.h"
+#include "DocumentCache.h"
+#include "Executor.h"
+#include "DataLoader.h"
+#include "Tracing.h"
+#include "Complexity.h"
+#include "PersistedQueries.h"
+#include "Incremental.h"
+#include "CacheControl.h"
+#include "Validation.h"
+#include "Metrics.h"
+
+#include <graphqlparser/GraphQLParser.h>
 
 #include <iostream>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
 
 namespace facebook {
 namespace graphql {
@@ -27,6 +42,11 @@ const web::json::value& schema_exception::getErrors() const noexcept
 	return _errors;
 }
 
+null_propagation_exception::null_propagation_exception()
+	: schema_exception({})
+{
+}
+
 Fragment::Fragment(const ast::FragmentDefinition& fragmentDefinition)
 	: _type(fragmentDefinition.getTypeCondition().getName().getValue())
 	, _selection(fragmentDefinition.getSelectionSet())
@@ -152,8 +172,16 @@ web::json::value ModifiedResult<web::json::value>::convert(const web::json::valu
 }
 
 template <>
-web::json::value ModifiedResult<std::vector<unsigned char>>::convert(const std::vector<unsigned char>& result, ResolverParams&&)
+web::json::value ModifiedResult<std::vector<unsigned char>>::convert(const std::vector<unsigned char>& result, ResolverParams&& params)
 {
+	// Binary encodings can write the bytes directly, without expanding them to base64 first.
+	if (params.operation.writer != nullptr
+		&& params.operation.writer->getEncoding() != ResponseEncoding::Json)
+	{
+		params.operation.writer->addBytes(result);
+		return web::json::value::null();
+	}
+
 	try
 	{
 		return web::json::value::string(utility::conversions::to_base64(result));
@@ -182,255 +210,2261 @@ web::json::value ModifiedResult<Object>::convert(const std::shared_ptr<Object>&
 		return web::json::value::object();
 	}
 
-	return result->resolve(*params.selection, params.fragments, params.variables);
+	return result->start(*params.selection, params.operation, params.path).join();
 }
 
-Object::Object(TypeNames&& typeNames, ResolverMap&& resolvers)
-	: _typeNames(std::move(typeNames))
-	, _resolvers(std::move(resolvers))
+web::json::value ResponsePath::toJson() const
 {
-}
+	std::vector<const ResponsePath*> segments;
 
-web::json::value Object::resolve(const ast::SelectionSet& selection, const FragmentMap& fragments, const web::json::object& variables) const
-{
-	auto result = web::json::value::object(selection.getSelections().size());
+	for (auto segment = this; segment != nullptr; segment = segment->parent)
+	{
+		segments.push_back(segment);
+	}
 
-	for (const auto& entry : selection.getSelections())
+	auto result = web::json::value::array(segments.size());
+	auto& entries = result.as_array();
+	size_t index = 0;
+
+	for (auto itr = segments.crbegin(); itr != segments.crend(); ++itr)
 	{
-		SelectionVisitor visitor(fragments, variables, _typeNames, _resolvers);
+		entries[index++] = ((*itr)->alias != nullptr)
+			? web::json::value::string(*(*itr)->alias)
+			: web::json::value::number(static_cast<int64_t>((*itr)->index));
+	}
+
+	return result;
+}
+
+FieldErrors::FieldErrors(Metrics* metrics)
+	: _metrics(metrics)
+{
+}
 
-		entry->accept(&visitor);
+void FieldErrors::add(const schema_exception& ex, const yy::location* location, const ResponsePath* path)
+{
+	std::vector<web::json::value> errors;
 
-		auto values = visitor.getValues();
+	for (const auto& error : ex.getErrors().as_array())
+	{
+		// Copy the members into a new object, the exception might be thrown again somewhere else.
+		auto entry = web::json::value::object(true);
 
-		if (values.is_object())
+		if (error.is_object())
 		{
-			for (auto& value : values.as_object())
+			for (const auto& member : error.as_object())
 			{
-				result[value.first] = std::move(value.second);
+				entry[member.first] = member.second;
 			}
 		}
+
+		if (location != nullptr)
+		{
+			entry[_XPLATSTR("locations")] = web::json::value::array({
+				web::json::value::object({
+					{ _XPLATSTR("line"), web::json::value::number(static_cast<int>(location->begin.line)) },
+					{ _XPLATSTR("column"), web::json::value::number(static_cast<int>(location->begin.column)) }
+					}, true)
+				});
+		}
+
+		if (path != nullptr)
+		{
+			entry[_XPLATSTR("path")] = path->toJson();
+		}
+
+		errors.push_back(std::move(entry));
 	}
 
-	return result;
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::move(errors.begin(), errors.end(), std::back_inserter(_errors));
 }
 
-Request::Request(TypeMap&& operationTypes)
-	: _operations(std::move(operationTypes))
+void FieldErrors::countField(const std::string& typeName, const std::string& fieldName)
 {
+	if (_metrics != nullptr)
+	{
+		_metrics->addFieldError(typeName, fieldName);
+	}
 }
 
-web::json::value Request::resolve(const ast::Node& document, const std::string& operationName, const web::json::object& variables) const
+bool FieldErrors::empty() const
 {
-	FragmentDefinitionVisitor fragmentVisitor;
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _errors.empty();
+}
+
+web::json::value FieldErrors::takeErrors(const schema_exception* ex)
+{
+	std::vector<web::json::value> errors;
+
+	if (ex != nullptr)
+	{
+		const auto& exceptionErrors = ex->getErrors().as_array();
 
-	document.accept(&fragmentVisitor);
+		errors.assign(exceptionErrors.begin(), exceptionErrors.end());
+	}
 
-	auto fragments = fragmentVisitor.getFragments();
-	OperationDefinitionVisitor operationVisitor(_operations, operationName, variables, fragments);
+	std::lock_guard<std::mutex> lock(_mutex);
 
-	document.accept(&operationVisitor);
+	std::move(_errors.begin(), _errors.end(), std::back_inserter(errors));
+	_errors.clear();
 
-	return operationVisitor.getValue();
+	return web::json::value::array(errors);
 }
 
-SelectionVisitor::SelectionVisitor(const FragmentMap& fragments, const web::json::object& variables, const TypeNames& typeNames, const ResolverMap& resolvers)
-	: _fragments(fragments)
-	, _variables(variables)
-	, _typeNames(typeNames)
-	, _resolvers(resolvers)
-	, _values(web::json::value::object(true))
+web::json::value handleFieldError(const OperationParams& params, const schema_exception& ex, bool nullable, const yy::location* location, const ResponsePath* path)
 {
+	if (params.errors == nullptr)
+	{
+		throw;
+	}
+
+	// Errors which are propagating from a non-null field beneath this one were already added.
+	if (dynamic_cast<const null_propagation_exception*>(&ex) == nullptr)
+	{
+		params.errors->add(ex, location, path);
+	}
+
+	if (!nullable)
+	{
+		throw null_propagation_exception();
+	}
+
+	return web::json::value::null();
 }
 
-web::json::value SelectionVisitor::getValues()
+size_t FieldTable::find(const std::string& name) const
 {
-	web::json::value result(std::move(_values));
-	return result;
+	const auto end = names + size;
+	auto itr = std::lower_bound(names, end, name.c_str(),
+		[](const char* lhs, const char* rhs)
+	{
+		return std::strcmp(lhs, rhs) < 0;
+	});
+
+	return (itr == end || name != *itr)
+		? size
+		: static_cast<size_t>(itr - names);
 }
 
-bool SelectionVisitor::visitField(const ast::Field& field)
+bool FieldTable::isNullable(size_t index) const
 {
-	const std::string name(field.getName().getValue());
-	const std::string alias((field.getAlias() != nullptr) ? field.getAlias()->getValue() : name);
-	auto itr = _resolvers.find(name);
+	return nullable == nullptr
+		|| index >= size
+		|| nullable[index];
+}
 
-	if (itr == _resolvers.cend())
-	{
-		std::ostringstream error;
+Object::Object(std::string&& typeName, TypeNames&& typeNames, ResolverMap&& resolvers)
+	: _ownedType(new ObjectType { std::move(typeName), std::move(typeNames), { nullptr, 0, nullptr } })
+	, _type(*_ownedType)
+	, _resolvers(std::move(resolvers))
+{
+}
 
-		error << "Unknown field name: " << name
-			<< " line: " << field.getLocation().begin.line
-			<< " column: " << field.getLocation().begin.column;
+Object::Object(const ObjectType& type)
+	: _type(type)
+{
+}
 
-		throw schema_exception({ error.str() });
+std::future<web::json::value> Object::resolveField(size_t index, ResolverParams&&) const
+{
+	std::ostringstream error;
+
+	error << "Missing resolver for field index: " << index
+		<< " type: " << _type.typeName;
+
+	throw schema_exception({ error.str() });
+}
+
+std::future<web::json::value> Object::callResolver(const Resolver* resolver, size_t index, ResolverParams&& params) const
+{
+	if (params.operation.errors == nullptr)
+	{
+		return (resolver != nullptr)
+			? (*resolver)(std::move(params))
+			: resolveField(index, std::move(params));
 	}
 
-	if (shouldSkip(field.getDirectives()))
+	try
 	{
-		return false;
+		return (resolver != nullptr)
+			? (*resolver)(std::move(params))
+			: resolveField(index, std::move(params));
 	}
+	catch (const schema_exception&)
+	{
+		// Let the error surface when the field is joined, so it's handled the same way as an error
+		// from the future.
+		std::promise<web::json::value> promise;
 
-	auto arguments = web::json::value::object(true);
+		promise.set_exception(std::current_exception());
 
-	if (field.getArguments() != nullptr)
+		return promise.get_future();
+	}
+}
+
+const std::string& Object::getTypeName() const
+{
+	return _type.typeName;
+}
+
+PendingFields::PendingFields(const OperationParams& params)
+	: _params(params)
+	, _arguments(ArenaAllocator<web::json::value>(params.arena))
+	, _fields(_arguments.get_allocator())
+	, _result(web::json::value::object(true))
+	, _paths(_arguments.get_allocator())
+{
+}
+
+PendingFields::~PendingFields()
+{
+	// Anything still running on another thread refers to the arguments and the plan, so let it
+	// finish before they go away.
+	for (; _joined < _fields.size(); ++_joined)
 	{
-		ValueVisitor visitor(_variables);
+		waitDispatched(_params, _fields[_joined].value);
+	}
+}
 
-		for (const auto& argument : *field.getArguments())
-		{
-			argument->getValue().accept(&visitor);
-			arguments[utility::conversions::to_string_t(argument->getName().getValue())] = visitor.getValue();
-		}
+void PendingFields::reserve(size_t fieldCount)
+{
+	if (_params.arguments == nullptr)
+	{
+		_arguments.reserve(fieldCount);
 	}
 
-	_values[utility::conversions::to_string_t(alias)] = itr->second({ arguments.as_object(), field.getSelectionSet(), _fragments, _variables });
+	_fields.reserve(fieldCount);
 
-	return false;
+	if (_params.tracer != nullptr
+		|| _params.incremental != nullptr
+		|| _params.errors != nullptr)
+	{
+		_paths.reserve(fieldCount);
+	}
 }
 
-bool SelectionVisitor::visitFragmentSpread(const ast::FragmentSpread &fragmentSpread)
+void PendingFields::joinStarted()
 {
-	const std::string name(fragmentSpread.getName().getValue());
-	auto itr = _fragments.find(name);
+	if (_params.writer != nullptr
+		&& !_writing)
+	{
+		_params.writer->startObject();
+		_writing = true;
+	}
 
-	if (itr == _fragments.cend())
+	// Every field has been started by now, so the ones which are still deferred can be joined in
+	// parallel without splitting up a DataLoader batch.
+	for (; _dispatched < _fields.size(); ++_dispatched)
 	{
-		std::ostringstream error;
+		auto& field = _fields[_dispatched];
 
-		error << "Unknown fragment name: " << name
-			<< " line: " << fragmentSpread.getLocation().begin.line
-			<< " column: " << fragmentSpread.getLocation().begin.column;
+		field.value = dispatchDeferred(_params, std::move(field.value));
+	}
 
-		throw schema_exception({ error.str() });
+	for (; _joined < _fields.size(); ++_joined)
+	{
+		auto& field = _fields[_joined];
+
+		if (_params.writer != nullptr)
+		{
+			_params.writer->addKey(field.plan->alias);
+			joinField(field);
+		}
+		else
+		{
+			_result[field.plan->alias] = joinField(field);
+		}
 	}
+}
+
+web::json::value PendingFields::joinField(PendingField& field)
+{
+	const auto writer = _params.writer;
+	const auto valueCount = (writer != nullptr) ? writer->getValueCount() : 0;
+	const auto depth = (writer != nullptr) ? writer->getDepth() : 0;
 
-	if (!shouldSkip(fragmentSpread.getDirectives())
-		&& _typeNames.count(itr->second.getType()) > 0)
+	try
 	{
-		itr->second.getSelection().accept(this);
+		if (writer != nullptr)
+		{
+			writer->addResult(valueCount, field.value.get());
+			return web::json::value::null();
+		}
+
+		return joinDispatched(_params, field.value);
 	}
+	catch (const schema_exception& ex)
+	{
+		// Count the field which failed, not every field the null propagates through.
+		if (_params.errors != nullptr
+			&& _typeName != nullptr
+			&& dynamic_cast<const null_propagation_exception*>(&ex) == nullptr)
+		{
+			_params.errors->countField(*_typeName, field.plan->name);
+		}
 
-	return false;
+		auto value = handleFieldError(_params, ex, field.nullable, &field.plan->location, field.path);
+
+		// Anything the field wrote before the error is closed, and if it didn't write anything it's null.
+		if (writer != nullptr)
+		{
+			writer->unwind(depth);
+			writer->addResult(valueCount, value);
+		}
+
+		return value;
+	}
 }
 
-bool SelectionVisitor::visitInlineFragment(const ast::InlineFragment &inlineFragment)
+web::json::value PendingFields::join()
 {
-	if (!shouldSkip(inlineFragment.getDirectives())
-		&& (inlineFragment.getTypeCondition() == nullptr
-			|| _typeNames.count(inlineFragment.getTypeCondition()->getName().getValue()) > 0))
+	joinStarted();
+
+	if (_params.writer != nullptr)
 	{
-		inlineFragment.getSelectionSet().accept(this);
+		_params.writer->endObject();
+		return web::json::value::null();
 	}
 
-	return false;
+	return std::move(_result);
 }
 
-bool SelectionVisitor::shouldSkip(const std::vector<std::unique_ptr<ast::Directive>>* directives) const
+PendingFields Object::start(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, bool serial) const
 {
-	if (directives == nullptr)
+	PendingFields pending(params);
+
+	pending._typeName = &_type.typeName;
+
+	if (selection.deferred.empty())
 	{
-		return false;
+		pending.reserve(selection.fields.size());
+		startFields(selection, params, path, serial, pending);
+
+		return pending;
 	}
 
-	for (const auto& directive : *directives)
+	std::vector<const SelectionSetPlan*> selections;
+	size_t fieldCount = 0;
+
+	collectSelections(selection, params, path, selections);
+
+	for (auto fields : selections)
 	{
-		const std::string name(directive->getName().getValue());
-		const bool include = (name == "include");
-		const bool skip = (!include && (name == "skip"));
+		fieldCount += fields->fields.size();
+	}
 
-		if (!include && !skip)
+	pending.reserve(fieldCount);
+
+	for (auto fields : selections)
+	{
+		startFields(*fields, params, path, serial, pending);
+	}
+
+	return pending;
+}
+
+bool Object::matchesFragment(const std::vector<std::string>& typeConditions, const DirectiveConditions& fragmentConditions, const web::json::object& variables) const
+{
+	return std::all_of(typeConditions.cbegin(), typeConditions.cend(),
+		[this](const std::string& typeCondition)
+	{
+		return _type.typeNames.count(typeCondition) > 0;
+	}) && std::none_of(fragmentConditions.cbegin(), fragmentConditions.cend(),
+		[&variables](const DirectiveCondition& condition)
+	{
+		return condition.shouldSkip(variables);
+	});
+}
+
+void Object::collectSelections(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, std::vector<const SelectionSetPlan*>& selections) const
+{
+	selections.push_back(&selection);
+
+	for (const auto& deferred : selection.deferred)
+	{
+		if (!matchesFragment(deferred.typeConditions, deferred.fragmentConditions, params.variables))
 		{
 			continue;
 		}
 
-		const auto argument = (directive->getArguments() != nullptr && directive->getArguments()->size() == 1)
-			? directive->getArguments()->front().get()
-			: nullptr;
-		const std::string argumentName((argument != nullptr) ? argument->getName().getValue() : "");
+		if (params.incremental != nullptr
+			&& deferred.shouldDefer(params.variables))
+		{
+			auto object = shared_from_this();
 
-		if (argumentName != "if")
+			params.incremental->defer(path, deferred.label, deferred.selection.get(),
+				[object](ResolverParams&& paramsArg)
+			{
+				return object->start(*paramsArg.selection, paramsArg.operation, paramsArg.path).join();
+			});
+			continue;
+		}
+
+		// Without incremental delivery, deferred fragments are resolved with everything else.
+		collectSelections(*deferred.selection, params, path, selections);
+	}
+}
+
+void Object::startFields(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, bool serial, PendingFields& pending) const
+{
+	const auto& variables = params.variables;
+	const bool trackPaths = (params.tracer != nullptr || params.incremental != nullptr || params.errors != nullptr);
+
+	for (const auto& field : selection.fields)
+	{
+		if (!matchesFragment(field.typeConditions, field.fragmentConditions, variables))
 		{
-			std::ostringstream error;
+			continue;
+		}
 
-			error << "Unknown argument to directive: " << name;
+		const Resolver* resolver = nullptr;
+		size_t fieldIndex = _type.fields.size;
 
-			if (!argumentName.empty())
-			{
-				error << " name: " << argumentName;
-			}
+		if (_type.fields.names != nullptr)
+		{
+			fieldIndex = _type.fields.find(field.name);
+		}
+		else
+		{
+			auto itr = _resolvers.find(field.name);
 
-			if (argument != nullptr)
+			if (itr != _resolvers.cend())
 			{
-				error << " line: " << argument->getLocation().begin.line
-					<< " column: " << argument->getLocation().begin.column;
+				resolver = &itr->second;
 			}
+		}
+
+		if (resolver == nullptr
+			&& fieldIndex == _type.fields.size)
+		{
+			std::ostringstream error;
+
+			error << "Unknown field name: " << field.name
+				<< " line: " << field.location.begin.line
+				<< " column: " << field.location.begin.column;
 
 			throw schema_exception({ error.str() });
 		}
 
-		ValueVisitor visitor(_variables);
+		if (field.skip
+			|| std::any_of(field.conditions.cbegin(), field.conditions.cend(),
+				[&variables](const DirectiveCondition& condition)
+		{
+			return condition.shouldSkip(variables);
+		}))
+		{
+			continue;
+		}
+
+		const web::json::value* fieldArguments = &field.arguments;
+
+		if (!field.variableArguments.empty())
+		{
+			if (params.arguments != nullptr)
+			{
+				fieldArguments = &params.arguments->get(field, variables);
+			}
+			else
+			{
+				pending._arguments.push_back(field.evaluateArguments(variables));
+				fieldArguments = &pending._arguments.back();
+			}
+		}
 
-		argument->getValue().accept(&visitor);
+		const bool nullable = _type.fields.isNullable(fieldIndex);
+		const ResponsePath* fieldPath = nullptr;
 
-		auto value = visitor.getValue();
+		if (trackPaths)
+		{
+			pending._paths.push_back({ path, &field.alias, 0 });
+			fieldPath = &pending._paths.back();
+		}
 
-		if (!value.is_boolean())
+		if (params.tracer != nullptr)
 		{
-			std::ostringstream error;
+			// Count the time spent in the resolver and the time spent joining it, but not the time
+			// spent on the other fields in between.
+			FieldTrace trace { _type.typeName, field.name, *fieldPath, std::chrono::steady_clock::now() };
 
-			error << "Invalid argument to directive: " << name
-				<< " name: if line: " << argument->getLocation().begin.line
-				<< " column: " << argument->getLocation().begin.column;
+			params.tracer->startField(trace);
 
-			throw schema_exception({ error.str() });
+			auto future = callResolver(resolver, fieldIndex, { fieldArguments->as_object(), field.selection.get(), params, fieldPath, field.stream.get() });
+			const auto elapsed = std::chrono::steady_clock::now() - trace.start;
+
+			pending._fields.push_back({ &field, nullable, fieldPath, std::async(std::launch::deferred,
+				[this, &field, &params, fieldPath, elapsed](std::chrono::steady_clock::time_point start, std::future<web::json::value>&& futureArg)
+			{
+				const auto joinStart = std::chrono::steady_clock::now();
+				auto result = futureArg.get();
+
+				params.tracer->endField({ _type.typeName, field.name, *fieldPath, start }, elapsed + (std::chrono::steady_clock::now() - joinStart));
+				return result;
+			}, trace.start, std::move(future)) });
+		}
+		else
+		{
+			pending._fields.push_back({ &field, nullable, fieldPath, callResolver(resolver, fieldIndex, { fieldArguments->as_object(), field.selection.get(), params, fieldPath, field.stream.get() }) });
 		}
 
-		if (value.as_bool() == skip)
+		if (serial)
 		{
-			// Skip this item
-			return true;
+			pending.joinStarted();
 		}
 	}
+}
 
-	return false;
+web::json::value Object::resolve(const SelectionSetPlan& selection, const OperationParams& params, bool serial) const
+{
+	return start(selection, params, nullptr, serial).join();
 }
 
-ValueVisitor::ValueVisitor(const web::json::object& variables)
+SelectionLookahead::SelectionLookahead(const SelectionSetPlan* selection, const web::json::object& variables)
 	: _variables(variables)
 {
+	if (selection != nullptr)
+	{
+		_selections.push_back(selection);
+	}
 }
 
-web::json::value ValueVisitor::getValue()
+SelectionLookahead::SelectionLookahead(std::vector<const SelectionSetPlan*>&& selections, const web::json::object& variables)
+	: _selections(std::move(selections))
+	, _variables(variables)
 {
-	web::json::value result(std::move(_value));
-	return result;
 }
 
-bool ValueVisitor::visitVariable(const ast::Variable& variable)
+bool SelectionLookahead::isSelected(const std::string& fieldName) const
 {
-	const std::string name(variable.getName().getValue());
-	auto itr = _variables.find(utility::conversions::to_string_t(name));
-
-	if (itr == _variables.cend())
+	return std::any_of(_selections.cbegin(), _selections.cend(),
+		[this, &fieldName](const SelectionSetPlan* selection)
 	{
-		std::ostringstream error;
+		return isSelected(*selection, fieldName, nullptr);
+	});
+}
 
-		error << "Unknown variable name: " << name
-			<< " line: " << variable.getLocation().begin.line
-			<< " column: " << variable.getLocation().begin.column;
+SelectionLookahead SelectionLookahead::getChild(const std::string& fieldName) const
+{
+	std::vector<const SelectionSetPlan*> children;
 
-		throw schema_exception({ error.str() });
+	for (auto selection : _selections)
+	{
+		isSelected(*selection, fieldName, &children);
 	}
 
-	_value = itr->second;
-
-	return false;
+	return SelectionLookahead(std::move(children), _variables);
 }
 
-bool ValueVisitor::visitIntValue(const ast::IntValue& intValue)
+bool SelectionLookahead::isSelected(const SelectionSetPlan& selection, const std::string& fieldName, std::vector<const SelectionSetPlan*>* children) const
 {
-	_value = web::json::value::number(std::atoi(intValue.getValue()));
+	if (selection.fieldNames.find(fieldName) == selection.fieldNames.cend())
+	{
+		return false;
+	}
+
+	bool result = false;
+
+	for (const auto& field : selection.fields)
+	{
+		if (field.name != fieldName
+			|| field.skip
+			|| !isIncluded(field.fragmentConditions)
+			|| !isIncluded(field.conditions))
+		{
+			continue;
+		}
+
+		result = true;
+
+		if (children == nullptr)
+		{
+			return true;
+		}
+		else if (field.selection)
+		{
+			children->push_back(field.selection.get());
+		}
+	}
+
+	for (const auto& deferred : selection.deferred)
+	{
+		if (isIncluded(deferred.fragmentConditions)
+			&& isSelected(*deferred.selection, fieldName, children))
+		{
+			result = true;
+
+			if (children == nullptr)
+			{
+				return true;
+			}
+		}
+	}
+
+	return result;
+}
+
+bool SelectionLookahead::isIncluded(const DirectiveConditions& conditions) const
+{
+	return std::none_of(conditions.cbegin(), conditions.cend(),
+		[this](const DirectiveCondition& condition)
+	{
+		return condition.shouldSkip(_variables);
+	});
+}
+
+SelectionLookahead FieldParams::lookahead() const
+{
+	return SelectionLookahead(selection, operation.variables);
+}
+
+web::json::value FieldPlan::evaluateArguments(const web::json::object& variables) const
+{
+	auto result = arguments;
+	ValueVisitor visitor(variables);
+
+	for (const auto& argument : variableArguments)
+	{
+		argument.second->accept(&visitor);
+		result[argument.first] = visitor.getValue();
+	}
+
+	return result;
+}
+
+const web::json::value& ArgumentCache::get(const FieldPlan& field, const web::json::object& variables)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto itr = _arguments.find(&field);
+
+		if (itr != _arguments.cend())
+		{
+			return *itr->second;
+		}
+	}
+
+	// Evaluate them outside of the lock, if another thread got there first we'll keep its copy.
+	std::unique_ptr<const web::json::value> evaluated(new web::json::value(field.evaluateArguments(variables)));
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& entry = _arguments[&field];
+
+	if (!entry)
+	{
+		entry = std::move(evaluated);
+	}
+
+	return *entry;
+}
+
+bool DirectiveCondition::shouldSkip(const web::json::object& variables) const
+{
+	ValueVisitor visitor(variables);
+
+	argument->getValue().accept(&visitor);
+
+	auto value = visitor.getValue();
+
+	if (!value.is_boolean())
+	{
+		std::ostringstream error;
+
+		error << "Invalid argument to directive: " << (skip ? "skip" : "include")
+			<< " name: if line: " << argument->getLocation().begin.line
+			<< " column: " << argument->getLocation().begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	return value.as_bool() == skip;
+}
+
+namespace {
+
+web::json::value getDirectiveArgument(const ast::Value* argument, const web::json::object& variables)
+{
+	ValueVisitor visitor(variables);
+
+	argument->accept(&visitor);
+
+	return visitor.getValue();
+}
+
+void throwInvalidDirectiveArgument(const char* directive, const char* name, const ast::Value& argument)
+{
+	std::ostringstream error;
+
+	error << "Invalid argument to directive: " << directive
+		<< " name: " << name
+		<< " line: " << argument.getLocation().begin.line
+		<< " column: " << argument.getLocation().begin.column;
+
+	throw schema_exception({ error.str() });
+}
+
+} /* namespace */
+
+bool DeferredPlan::shouldDefer(const web::json::object& variables) const
+{
+	if (condition == nullptr)
+	{
+		return true;
+	}
+
+	auto value = getDirectiveArgument(condition, variables);
+
+	if (!value.is_boolean())
+	{
+		throwInvalidDirectiveArgument("defer", "if", *condition);
+	}
+
+	return value.as_bool();
+}
+
+size_t StreamPlan::getInitialCount(const web::json::object& variables, size_t size) const
+{
+	if (condition != nullptr)
+	{
+		auto value = getDirectiveArgument(condition, variables);
+
+		if (!value.is_boolean())
+		{
+			throwInvalidDirectiveArgument("stream", "if", *condition);
+		}
+
+		if (!value.as_bool())
+		{
+			return size;
+		}
+	}
+
+	if (initialCount == nullptr)
+	{
+		return 0;
+	}
+
+	auto value = getDirectiveArgument(initialCount, variables);
+
+	if (!value.is_integer()
+		|| value.as_integer() < 0)
+	{
+		throwInvalidDirectiveArgument("stream", "initialCount", *initialCount);
+	}
+
+	return std::min(size, static_cast<size_t>(value.as_integer()));
+}
+
+size_t getInitialCount(const ResolverParams& params, size_t size)
+{
+	return (params.stream == nullptr
+			|| params.operation.incremental == nullptr)
+		? size
+		: params.stream->getInitialCount(params.operation.variables, size);
+}
+
+void addStreamElement(const ResolverParams& params, size_t index, IncrementalResolver&& resolver)
+{
+	const ResponsePath path { params.path, nullptr, index };
+
+	params.operation.incremental->stream(&path, params.stream->label, params.selection, std::move(resolver));
+}
+
+std::future<web::json::value> dispatchDeferred(const OperationParams& params, std::future<web::json::value>&& value)
+{
+	if (params.writer != nullptr
+		|| !value.valid()
+		|| value.wait_for(std::chrono::seconds(0)) != std::future_status::deferred)
+	{
+		return std::move(value);
+	}
+
+	if (params.executor != nullptr)
+	{
+		// The task needs to own the deferred future, and std::function can only hold something it can
+		// copy. Executors may destroy the task after the operation is done, so it can't use the arena.
+		auto deferred = std::make_shared<std::future<web::json::value>>(std::move(value));
+
+		return params.executor->submit([deferred]()
+		{
+			return deferred->get();
+		});
+	}
+
+	if (params.launch == std::launch::async)
+	{
+		return std::async(std::launch::async,
+			[](std::future<web::json::value>&& valueArg)
+		{
+			return valueArg.get();
+		}, std::move(value));
+	}
+
+	return std::move(value);
+}
+
+web::json::value joinDispatched(const OperationParams& params, std::future<web::json::value>& value)
+{
+	return (params.executor != nullptr)
+		? params.executor->join(value)
+		: value.get();
+}
+
+void waitDispatched(const OperationParams& params, std::future<web::json::value>& value)
+{
+	if (!value.valid()
+		|| value.wait_for(std::chrono::seconds(0)) == std::future_status::deferred)
+	{
+		return;
+	}
+
+	if (params.executor != nullptr)
+	{
+		params.executor->wait(value);
+	}
+	else
+	{
+		value.wait();
+	}
+}
+
+bool shouldResolveInParallel(const ResolverParams& params, size_t size)
+{
+	return params.operation.executor != nullptr
+		&& params.operation.writer == nullptr
+		&& params.operation.parallelListThreshold != 0
+		&& size >= params.operation.parallelListThreshold;
+}
+
+web::json::value resolveListInParallel(const ResolverParams& params, size_t size, bool nullable, const ListElementStarter& start)
+{
+	const size_t chunkSize = params.operation.parallelListThreshold;
+	std::vector<std::future<web::json::value>> chunks;
+
+	chunks.reserve((size + chunkSize - 1) / chunkSize);
+
+	for (size_t begin = 0; begin < size; begin += chunkSize)
+	{
+		const size_t end = std::min(size, begin + chunkSize);
+
+		chunks.push_back(params.operation.executor->submit([&params, &start, nullable, begin, end]()
+		{
+			OperationParams chunkOperation(params.operation);
+
+			chunkOperation.executor = nullptr;
+
+			// Start the whole chunk before joining any of it, so a DataLoader still gets a batch of keys.
+			std::vector<ResponsePath> paths;
+			std::vector<std::future<web::json::value>> elements;
+
+			paths.reserve(end - begin);
+			elements.reserve(end - begin);
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const ResponsePath* elementPath = nullptr;
+
+				if (params.path != nullptr)
+				{
+					paths.push_back({ params.path, nullptr, i });
+					elementPath = &paths.back();
+				}
+
+				elements.push_back(start(i, { params.arguments, params.selection, chunkOperation, elementPath, nullptr }));
+			}
+
+			auto value = web::json::value::array(elements.size());
+
+			for (size_t i = 0; i < elements.size(); ++i)
+			{
+				try
+				{
+					value[i] = elements[i].get();
+				}
+				catch (const schema_exception& ex)
+				{
+					value[i] = handleFieldError(params.operation, ex, nullable, nullptr, paths.empty() ? nullptr : &paths[i]);
+				}
+			}
+
+			return value;
+		}));
+	}
+
+	auto value = web::json::value::array(size);
+	auto itr = value.as_array().begin();
+	std::exception_ptr error;
+
+	// The chunks refer to the params, so they all need to finish before an error is rethrown.
+	for (auto& chunk : chunks)
+	{
+		try
+		{
+			auto elements = params.operation.executor->join(chunk);
+			auto& array = elements.as_array();
+
+			itr = std::move(array.begin(), array.end(), itr);
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+
+	return value;
+}
+
+void addCacheHint(const OperationParams& params, const CacheHint& hint)
+{
+	if (params.cachePolicy != nullptr)
+	{
+		params.cachePolicy->addHint(hint);
+	}
+}
+
+ParsedDocument::ParsedDocument(std::unique_ptr<ast::Node>&& document, std::string query)
+	: _ownedDocument(std::move(document))
+	, _document(*_ownedDocument)
+	, _query(std::move(query))
+{
+	compile();
+}
+
+ParsedDocument::ParsedDocument(const ast::Node& document)
+	: _document(document)
+{
+	compile();
+}
+
+void ParsedDocument::compile()
+{
+	FragmentDefinitionVisitor fragmentVisitor;
+
+	_document.accept(&fragmentVisitor);
+	_fragments = fragmentVisitor.getFragments();
+
+	OperationDefinitionVisitor operationVisitor;
+
+	_document.accept(&operationVisitor);
+
+	for (auto operationDefinition : operationVisitor.getOperations())
+	{
+		OperationPlan plan { operationDefinition, nullptr, nullptr };
+
+		try
+		{
+			SelectionPlanVisitor planVisitor(_fragments);
+
+			operationDefinition->getSelectionSet().accept(&planVisitor);
+			plan.selection = planVisitor.getPlan();
+		}
+		catch (const schema_exception& ex)
+		{
+			plan.error = std::make_shared<const schema_exception>(ex);
+		}
+
+		_operations.push_back(std::move(plan));
+	}
+}
+
+std::shared_ptr<const ParsedDocument> ParsedDocument::parse(const std::string& query)
+{
+	const char* error = nullptr;
+	auto document = parseString(query.c_str(), &error);
+
+	if (!document)
+	{
+		std::string message(error != nullptr ? error : "Unknown syntax error");
+
+		free(const_cast<char*>(error));
+		throw schema_exception({ message });
+	}
+
+	return std::make_shared<const ParsedDocument>(std::move(document), query);
+}
+
+const ast::Node& ParsedDocument::getDocument() const
+{
+	return _document;
+}
+
+const FragmentMap& ParsedDocument::getFragments() const
+{
+	return _fragments;
+}
+
+const std::string& ParsedDocument::getQuery() const
+{
+	return _query;
+}
+
+const OperationPlan& ParsedDocument::getOperation(const std::string& operationName) const
+{
+	const OperationPlan* result = nullptr;
+
+	for (const auto& operation : _operations)
+	{
+		const auto operationDefinition = operation.definition;
+		const std::string name((operationDefinition->getName() != nullptr) ? operationDefinition->getName()->getValue() : "");
+
+		if (!operationName.empty()
+			&& name != operationName)
+		{
+			// Skip the operations that don't match the name
+			continue;
+		}
+
+		if (result != nullptr)
+		{
+			const yy::location& location = name.empty() ? operationDefinition->getLocation() : operationDefinition->getName()->getLocation();
+			std::ostringstream error;
+
+			if (operationName.empty())
+			{
+				error << "No operationName specified with extra operation";
+			}
+			else
+			{
+				error << "Duplicate operation";
+			}
+
+			if (!name.empty())
+			{
+				error << " name: " << name;
+			}
+
+			error << " line: " << location.begin.line
+				<< " column: " << location.begin.column;
+
+			throw schema_exception({ error.str() });
+		}
+
+		result = &operation;
+	}
+
+	if (result == nullptr)
+	{
+		std::ostringstream error;
+
+		error << "Missing operation";
+
+		if (!operationName.empty())
+		{
+			error << " name: " << operationName;
+		}
+
+		throw schema_exception({ error.str() });
+	}
+
+	return *result;
+}
+
+void ParsedDocument::validate(const ValidationSchema& schema) const
+{
+	std::unique_lock<std::mutex> lock(_validationMutex);
+
+	if (_validatedSchemaId != schema.getId())
+	{
+		lock.unlock();
+
+		auto errors = schema.validate(*this);
+		auto validationError = errors.empty()
+			? nullptr
+			: std::make_shared<const schema_exception>(std::move(errors));
+
+		lock.lock();
+		_validatedSchemaId = schema.getId();
+		_validationError = std::move(validationError);
+	}
+
+	if (_validationError)
+	{
+		throw *_validationError;
+	}
+}
+
+Request::Request(TypeMap&& operationTypes, RequestOptions options)
+	: _operations(std::move(operationTypes))
+	, _options(std::move(options))
+{
+}
+
+web::json::value Request::resolve(const ast::Node& document, const std::string& operationName, const web::json::object& variables, std::launch launch) const
+{
+	return resolve(ParsedDocument(document), operationName, variables, launch);
+}
+
+web::json::value Request::resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, std::launch launch) const
+{
+	return execute(document, operationName, variables, nullptr, launch);
+}
+
+web::json::value Request::resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, const std::string& cacheScope, std::launch launch) const
+{
+	return execute(document, operationName, variables, nullptr, launch, nullptr, cacheScope);
+}
+
+void Request::resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const
+{
+	execute(document, operationName, variables, &writer, std::launch::deferred);
+	writer.flush();
+}
+
+void Request::resolveIncremental(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, const PayloadCallback& callback, std::launch launch) const
+{
+	IncrementalScope incremental(callback);
+	auto result = execute(document, operationName, variables, nullptr, launch, &incremental);
+
+	if (!incremental.hasStarted())
+	{
+		// The operation failed before there was anything to deliver.
+		result[_XPLATSTR("hasNext")] = web::json::value::boolean(false);
+		callback(std::move(result));
+	}
+}
+
+void Request::resolveIncremental(const std::string& query, const std::string& operationName, const web::json::object& variables, const PayloadCallback& callback, std::launch launch) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		auto result = getErrorResponse(ex);
+
+		result[_XPLATSTR("hasNext")] = web::json::value::boolean(false);
+		callback(std::move(result));
+		return;
+	}
+
+	resolveIncremental(*document, operationName, variables, callback, launch);
+}
+
+namespace {
+
+// RequestMetrics counts an operation as active while it's executing and records how long it took,
+// even if something other than a schema_exception escapes from a resolver.
+class RequestMetrics
+{
+public:
+	explicit RequestMetrics(Metrics* metrics)
+		: _metrics(metrics)
+	{
+		if (_metrics != nullptr)
+		{
+			_start = std::chrono::steady_clock::now();
+			_metrics->add(MetricCounter::Requests);
+			_metrics->startRequest();
+		}
+	}
+
+	~RequestMetrics()
+	{
+		if (_metrics != nullptr)
+		{
+			if (_arena)
+			{
+				_metrics->add(MetricCounter::ArenaAllocations, _arena->getAllocationCount());
+				_metrics->add(MetricCounter::ArenaBytes, _arena->getAllocatedBytes());
+			}
+
+			_metrics->recordLatency(MetricStage::Execute, std::chrono::steady_clock::now() - _start - _excluded);
+			_metrics->endRequest();
+		}
+	}
+
+	// Stages with their own histogram, like validation, are left out of Execute.
+	void exclude(std::chrono::steady_clock::duration duration)
+	{
+		_excluded += duration;
+	}
+
+	// Count what the operation allocated from its arena once it's done with it.
+	void setArena(std::shared_ptr<const RequestArena> arena)
+	{
+		_arena = std::move(arena);
+	}
+
+private:
+	Metrics* const _metrics;
+	std::shared_ptr<const RequestArena> _arena;
+	std::chrono::steady_clock::time_point _start;
+	std::chrono::steady_clock::duration _excluded = std::chrono::steady_clock::duration::zero();
+};
+
+} /* namespace */
+
+web::json::value Request::execute(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, ResponseWriter* writer, std::launch launch, IncrementalScope* incremental, const std::string& cacheScope, DataLoaderScope* sharedLoaders) const
+{
+	const auto metrics = _options.metrics.get();
+	RequestMetrics requestMetrics(metrics);
+	web::json::value result;
+	size_t depth = 0;
+	size_t bytesWritten = 0;
+	std::unique_ptr<FieldTracer> tracer;
+	CachePolicy policy;
+	std::unique_ptr<CacheHint> cacheHint;
+	FieldErrors fieldErrors(metrics);
+
+	if (_options.instrumentation)
+	{
+		tracer = _options.instrumentation->startOperation();
+	}
+
+	if (writer != nullptr)
+	{
+		bytesWritten = writer->getBytesWritten();
+		writer->startObject();
+		writer->addKey(_XPLATSTR("data"));
+		depth = writer->getDepth();
+	}
+
+	try
+	{
+		if (metrics != nullptr
+			&& _options.validateDocuments)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			validate(document);
+
+			const auto duration = std::chrono::steady_clock::now() - start;
+
+			metrics->recordLatency(MetricStage::Validate, duration);
+			requestMetrics.exclude(duration);
+		}
+		else
+		{
+			validate(document);
+		}
+
+		const auto& plan = document.getOperation(operationName);
+		const auto& operationDefinition = *plan.definition;
+		std::string operation(operationDefinition.getOperation());
+		auto itr = _operations.find(operation);
+
+		if (itr == _operations.cend())
+		{
+			const std::string name((operationDefinition.getName() != nullptr) ? operationDefinition.getName()->getValue() : "");
+			const yy::location& location = name.empty() ? operationDefinition.getLocation() : operationDefinition.getName()->getLocation();
+			std::ostringstream error;
+
+			error << "Unknown operation type: " << operation;
+
+			if (!name.empty())
+			{
+				error << " name: " << name;
+			}
+
+			error << " line: " << location.begin.line
+				<< " column: " << location.begin.column;
+
+			throw schema_exception({ error.str() });
+		}
+
+		if (plan.error)
+		{
+			throw *plan.error;
+		}
+
+		auto operationVariables = getOperationVariables(operationDefinition, variables);
+
+		if (_options.complexityLimits)
+		{
+			checkComplexity(*plan.selection, operationVariables.as_object(), *_options.complexityLimits);
+		}
+
+		// Mutations must be resolved serially, everything else can start all of the fields at once.
+		const bool serial = (operation == "mutation");
+		std::unique_ptr<OperationExecutor> executor;
+
+		if (_options.executor
+			&& writer == nullptr)
+		{
+			// The executor decides which thread each field runs on, so convert them wherever they're joined.
+			executor.reset(new OperationExecutor(*_options.executor, _options.maxConcurrentTasks));
+			launch = std::launch::deferred;
+		}
+
+		// Only cache whole responses which are returned as a single value, and only if we can tell
+		// which query text they came from.
+		const bool useResultCache = (_options.resultCache
+			&& !tracer
+			&& writer == nullptr
+			&& incremental == nullptr
+			&& operation == "query"
+			&& !document.getQuery().empty());
+		std::shared_ptr<const CachedResult> cached;
+
+		if (useResultCache)
+		{
+			// Public results are shared by every caller, so look for those first.
+			cached = _options.resultCache->find(getResultCacheKey(document, operationName, operationVariables, {}));
+
+			if (!cached
+				&& !cacheScope.empty())
+			{
+				cached = _options.resultCache->find(getResultCacheKey(document, operationName, operationVariables, cacheScope));
+			}
+
+			if (metrics != nullptr)
+			{
+				metrics->add(cached ? MetricCounter::ResultCacheHits : MetricCounter::ResultCacheMisses);
+			}
+		}
+
+		if (cached)
+		{
+			result = web::json::value::object({
+				{ _XPLATSTR("data"), cached->data }
+				}, true);
+			cacheHint.reset(new CacheHint(cached->getRemainingHint(std::chrono::steady_clock::now())));
+		}
+		else if (_options.cacheIntrospection
+			&& !tracer
+			&& incremental == nullptr
+			&& operation == "query"
+			&& operationDefinition.getVariableDefinitions() == nullptr
+			&& isIntrospection(plan))
+		{
+			auto introspection = resolveIntrospection(document, operationName, plan, *itr->second, operationVariables.as_object());
+
+			if (writer != nullptr
+				&& writer->getEncoding() != ResponseEncoding::Json)
+			{
+				writer->addValue(introspection->data);
+			}
+			else if (writer != nullptr)
+			{
+				writer->addSerializedValue(introspection->serialized);
+			}
+			else
+			{
+				result = web::json::value::object({
+					{ _XPLATSTR("data"), introspection->data }
+					}, true);
+			}
+		}
+		else
+		{
+			DataLoaderScope loaders;
+			ArgumentCache arguments;
+			bool partialResult = false;
+			auto arena = std::make_shared<RequestArena>();
+
+			if (metrics != nullptr)
+			{
+				requestMetrics.setArena(arena);
+			}
+
+			OperationParams params { operationVariables.as_object(), writer, launch, executor.get(), (sharedLoaders != nullptr) ? *sharedLoaders : loaders, tracer.get(), *arena, incremental,
+				(incremental == nullptr) ? &policy : nullptr, _options.parallelListThreshold, &arguments, &fieldErrors };
+
+			if (writer != nullptr)
+			{
+				itr->second->start(*plan.selection, params, nullptr, serial).join();
+
+				if (!fieldErrors.empty())
+				{
+					partialResult = true;
+					writer->addKey(_XPLATSTR("errors"));
+					writer->addValue(fieldErrors.takeErrors());
+				}
+			}
+			else if (incremental != nullptr)
+			{
+				incremental->deliver(itr->second->start(*plan.selection, params, nullptr, serial).join(), params);
+			}
+			else
+			{
+				auto data = itr->second->start(*plan.selection, params, nullptr, serial).join();
+
+				// Partial results are only good for this response, don't cache them.
+				if (useResultCache
+					&& fieldErrors.empty()
+					&& policy.isCacheable())
+				{
+					const auto hint = policy.getHint();
+
+					// Private results can only be cached if we know who they belong to.
+					if (hint.scope == CacheScope::Public
+						|| !cacheScope.empty())
+					{
+						_options.resultCache->store(getResultCacheKey(document, operationName, operationVariables, (hint.scope == CacheScope::Public) ? std::string() : cacheScope),
+							std::make_shared<const CachedResult>(CachedResult { data, hint, std::chrono::steady_clock::now() }));
+					}
+				}
+
+				result = web::json::value::object({
+					{ _XPLATSTR("data"), std::move(data) }
+					}, true);
+
+				if (!fieldErrors.empty())
+				{
+					partialResult = true;
+					result[_XPLATSTR("errors")] = fieldErrors.takeErrors();
+				}
+			}
+
+			if (!partialResult
+				&& policy.isCacheable())
+			{
+				cacheHint.reset(new CacheHint(policy.getHint()));
+			}
+		}
+	}
+	catch (const schema_exception& ex)
+	{
+		// If a non-null field at the root failed, the errors from the fields are all that's left.
+		if (writer != nullptr)
+		{
+			writer->unwind(depth);
+			writer->addKey(_XPLATSTR("errors"));
+			writer->addValue(fieldErrors.takeErrors(&ex));
+		}
+		else
+		{
+			result = web::json::value::object({
+				{ _XPLATSTR("data"),  web::json::value::null() },
+				{ _XPLATSTR("errors"), fieldErrors.takeErrors(&ex) }
+				}, true);
+		}
+	}
+
+	if (tracer
+		|| cacheHint)
+	{
+		auto extensions = tracer
+			? tracer->getExtensions()
+			: web::json::value::object(true);
+
+		if (cacheHint)
+		{
+			if (!extensions.is_object())
+			{
+				extensions = web::json::value::object(true);
+			}
+
+			extensions[_XPLATSTR("cacheControl")] = CachePolicy::toJson(*cacheHint);
+		}
+
+		if (extensions.is_object()
+			&& extensions.size() > 0)
+		{
+			if (writer != nullptr)
+			{
+				writer->addKey(_XPLATSTR("extensions"));
+				writer->addValue(extensions);
+			}
+			else
+			{
+				result[_XPLATSTR("extensions")] = std::move(extensions);
+			}
+		}
+	}
+
+	if (writer != nullptr)
+	{
+		writer->endObject();
+
+		if (metrics != nullptr)
+		{
+			metrics->add(MetricCounter::BytesWritten, writer->getBytesWritten() - bytesWritten);
+		}
+	}
+
+	return result;
+}
+
+web::json::value Request::resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, std::launch launch) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		return getErrorResponse(ex);
+	}
+
+	return resolve(*document, operationName, variables, launch);
+}
+
+web::json::value Request::resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, const std::string& cacheScope, std::launch launch) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		return getErrorResponse(ex);
+	}
+
+	return resolve(*document, operationName, variables, cacheScope, launch);
+}
+
+void Request::resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		writeErrorResponse(ex, writer);
+		return;
+	}
+
+	resolve(*document, operationName, variables, writer);
+}
+
+web::json::value Request::resolve(const PersistedQuery& query, const std::string& operationName, const web::json::object& variables, std::launch launch) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		return getErrorResponse(ex);
+	}
+
+	return resolve(*document, operationName, variables, launch);
+}
+
+void Request::resolve(const PersistedQuery& query, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const
+{
+	std::shared_ptr<const ParsedDocument> document;
+
+	try
+	{
+		document = getDocument(query);
+	}
+	catch (const schema_exception& ex)
+	{
+		writeErrorResponse(ex, writer);
+		return;
+	}
+
+	resolve(*document, operationName, variables, writer);
+}
+
+std::string Request::getResultCacheKey(const ParsedDocument& document, const std::string& operationName, const web::json::value& variables, const std::string& cacheScope)
+{
+	std::ostringstream key;
+
+	key << operationName << '\n'
+		<< cacheScope << '\n'
+		<< utility::conversions::to_utf8string(variables.serialize()) << '\n'
+		<< document.getQuery();
+
+	return sha256Hex(key.str());
+}
+
+std::vector<web::json::value> Request::resolveBatch(const std::vector<BatchOperation>& operations, std::launch launch) const
+{
+	std::vector<web::json::value> results(operations.size());
+	std::vector<std::shared_ptr<const ParsedDocument>> documents(operations.size());
+	std::unordered_map<std::string, std::shared_ptr<const ParsedDocument>> parsed;
+
+	for (size_t i = 0; i < operations.size(); ++i)
+	{
+		auto& document = parsed[operations[i].query];
+
+		try
+		{
+			if (!document)
+			{
+				document = getDocument(operations[i].query);
+			}
+
+			documents[i] = document;
+		}
+		catch (const schema_exception& ex)
+		{
+			results[i] = getErrorResponse(ex);
+		}
+	}
+
+	DataLoaderScope sharedLoaders;
+	const auto resolveOperation = [this, &operations, &documents, &sharedLoaders, launch](size_t index)
+	{
+		const auto& operation = operations[index];
+		const auto variables = operation.variables.is_object()
+			? operation.variables
+			: web::json::value::object();
+
+		return execute(*documents[index], operation.operationName, variables.as_object(), nullptr, launch, nullptr, {},
+			operation.shareLoaders ? &sharedLoaders : nullptr);
+	};
+
+	if (!_options.executor)
+	{
+		for (size_t i = 0; i < operations.size(); ++i)
+		{
+			if (documents[i])
+			{
+				results[i] = resolveOperation(i);
+			}
+		}
+
+		return results;
+	}
+
+	OperationExecutor executor(*_options.executor, _options.maxConcurrentTasks);
+	std::vector<std::future<web::json::value>> futures(operations.size());
+
+	for (size_t i = 0; i < operations.size(); ++i)
+	{
+		if (documents[i])
+		{
+			futures[i] = executor.submit([&resolveOperation, i]()
+			{
+				return resolveOperation(i);
+			});
+		}
+	}
+
+	// The tasks refer to the operations and the shared DataLoaderScope, so wait for all of them
+	// before passing along an exception.
+	std::exception_ptr error;
+
+	for (size_t i = 0; i < operations.size(); ++i)
+	{
+		if (!futures[i].valid())
+		{
+			continue;
+		}
+
+		try
+		{
+			results[i] = executor.join(futures[i]);
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+
+	return results;
+}
+
+std::shared_ptr<const ParsedDocument> Request::getDocument(const std::string& query) const
+{
+	if (!_options.metrics)
+	{
+		return _options.documentCache
+			? _options.documentCache->get(query)
+			: ParsedDocument::parse(query);
+	}
+
+	// Only documents which were actually parsed count towards the Parse latency.
+	const auto start = std::chrono::steady_clock::now();
+	bool hit = false;
+	auto document = _options.documentCache
+		? _options.documentCache->get(query, &hit)
+		: ParsedDocument::parse(query);
+
+	if (_options.documentCache)
+	{
+		_options.metrics->add(hit ? MetricCounter::DocumentCacheHits : MetricCounter::DocumentCacheMisses);
+	}
+
+	if (!hit)
+	{
+		_options.metrics->recordLatency(MetricStage::Parse, std::chrono::steady_clock::now() - start);
+	}
+
+	return document;
+}
+
+std::shared_ptr<const ParsedDocument> Request::getDocument(const PersistedQuery& query) const
+{
+	if (_options.persistedQueries)
+	{
+		auto document = _options.persistedQueries->find(query.sha256Hash);
+
+		if (document)
+		{
+			return document;
+		}
+
+		if (query.query.empty())
+		{
+			// The client should retry with the query text so it can be registered.
+			throw schema_exception({ "PersistedQueryNotFound" });
+		}
+
+		if (_options.persistedQueries->getAutoRegister())
+		{
+			document = _options.persistedQueries->add(query.sha256Hash, query.query);
+
+			// Once the store is full, clients which send the query text still get a response.
+			if (document)
+			{
+				return document;
+			}
+		}
+	}
+	else if (query.query.empty())
+	{
+		throw schema_exception({ "PersistedQueryNotSupported" });
+	}
+
+	return getDocument(query.query);
+}
+
+web::json::value Request::getErrorResponse(const schema_exception& ex)
+{
+	return web::json::value::object({
+		{ _XPLATSTR("data"),  web::json::value::null() },
+		{ _XPLATSTR("errors"), ex.getErrors() }
+		}, true);
+}
+
+void Request::writeErrorResponse(const schema_exception& ex, ResponseWriter& writer)
+{
+	writer.startObject();
+	writer.addKey(_XPLATSTR("data"));
+	writer.addValue(web::json::value::null());
+	writer.addKey(_XPLATSTR("errors"));
+	writer.addValue(ex.getErrors());
+	writer.endObject();
+	writer.flush();
+}
+
+void Request::validate(const ParsedDocument& document) const
+{
+	if (!_options.validateDocuments)
+	{
+		return;
+	}
+
+	const auto schema = getValidationSchema();
+
+	if (schema)
+	{
+		document.validate(*schema);
+	}
+}
+
+const RequestOptions& Request::getOptions() const
+{
+	return _options;
+}
+
+size_t Request::getIntrospectionCacheSize() const
+{
+	std::lock_guard<std::mutex> lock(_introspectionMutex);
+
+	return _introspectionResponses.size();
+}
+
+constexpr size_t Request::c_maxIntrospectionResponses;
+
+bool Request::isIntrospection(const OperationPlan& plan)
+{
+	return plan.selection->deferred.empty()
+		&& std::all_of(plan.selection->fields.cbegin(), plan.selection->fields.cend(),
+		[](const FieldPlan& field)
+	{
+		return field.name.size() > 2
+			&& field.name[0] == '_'
+			&& field.name[1] == '_';
+	});
+}
+
+std::shared_ptr<const Request::IntrospectionResponse> Request::resolveIntrospection(const ParsedDocument& document, const std::string& operationName, const OperationPlan& plan, Object& query, const web::json::object& variables) const
+{
+	// Documents built from an AST don't have any query text to key them on, so they aren't cached.
+	const bool cacheable = !document.getQuery().empty();
+	std::string key;
+
+	if (cacheable)
+	{
+		key = operationName + '\n' + document.getQuery();
+
+		std::lock_guard<std::mutex> lock(_introspectionMutex);
+		auto itr = _introspectionResponses.find(key);
+
+		if (itr != _introspectionResponses.cend())
+		{
+			return itr->second;
+		}
+	}
+
+	auto response = std::make_shared<IntrospectionResponse>();
+	DataLoaderScope loaders;
+	auto arena = std::make_shared<RequestArena>();
+	OperationParams params { variables, nullptr, std::launch::deferred, nullptr, loaders, nullptr, *arena, nullptr, nullptr, 0, nullptr, nullptr };
+
+	response->data = query.start(*plan.selection, params, nullptr).join();
+	response->serialized = utility::conversions::to_utf8string(response->data.serialize());
+
+	if (!cacheable)
+	{
+		return response;
+	}
+
+	std::lock_guard<std::mutex> lock(_introspectionMutex);
+
+	if (_introspectionResponses.size() >= c_maxIntrospectionResponses)
+	{
+		_introspectionResponses.clear();
+	}
+
+	return _introspectionResponses.emplace(std::move(key), std::move(response)).first->second;
+}
+
+std::shared_ptr<const ValidationSchema> Request::getValidationSchema() const
+{
+	std::lock_guard<std::mutex> lock(_validationMutex);
+
+	if (_loadedValidationSchema)
+	{
+		return _validationSchema;
+	}
+
+	_loadedValidationSchema = true;
+
+	auto itr = _operations.find("query");
+
+	if (itr == _operations.cend())
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		static const auto document = ParsedDocument::parse(ValidationSchema::getIntrospectionQuery());
+		const auto& plan = document->getOperation({});
+		const web::json::object variables;
+		DataLoaderScope loaders;
+		auto arena = std::make_shared<RequestArena>();
+		OperationParams params { variables, nullptr, std::launch::deferred, nullptr, loaders, nullptr, *arena, nullptr, nullptr, 0, nullptr, nullptr };
+		const auto data = itr->second->start(*plan.selection, params, nullptr).join();
+
+		_validationSchema = std::make_shared<const ValidationSchema>(data.at(_XPLATSTR("__schema")));
+	}
+	catch (const schema_exception&)
+	{
+		// Leave it empty and skip validation, the same errors will come back when executing.
+	}
+	catch (const web::json::json_exception&)
+	{
+		// The response didn't have a __schema field, there's nothing to validate against.
+	}
+
+	return _validationSchema;
+}
+
+constexpr size_t SelectionPlanVisitor::c_maxFieldCount;
+
+SelectionPlanVisitor::SelectionPlanVisitor(const FragmentMap& fragments)
+	: _fragments(fragments)
+	, _fragmentStack(_ownFragmentStack)
+	, _fieldCount(_ownFieldCount)
+	, _plan(std::make_shared<SelectionSetPlan>())
+{
+}
+
+SelectionPlanVisitor::SelectionPlanVisitor(const FragmentMap& fragments, std::vector<std::string>& fragmentStack, size_t& fieldCount)
+	: _fragments(fragments)
+	, _fragmentStack(fragmentStack)
+	, _fieldCount(fieldCount)
+	, _plan(std::make_shared<SelectionSetPlan>())
+{
+}
+
+std::shared_ptr<const SelectionSetPlan> SelectionPlanVisitor::getPlan()
+{
+	for (const auto& field : _plan->fields)
+	{
+		if (!field.skip)
+		{
+			_plan->fieldNames.insert(field.name);
+		}
+	}
+
+	for (const auto& deferred : _plan->deferred)
+	{
+		_plan->fieldNames.insert(deferred.selection->fieldNames.cbegin(), deferred.selection->fieldNames.cend());
+	}
+
+	std::shared_ptr<const SelectionSetPlan> result(std::move(_plan));
+	return result;
+}
+
+bool SelectionPlanVisitor::visitField(const ast::Field& field)
+{
+	if (++_fieldCount > c_maxFieldCount)
+	{
+		std::ostringstream error;
+
+		error << "Too many fields after expanding fragments, limit: " << c_maxFieldCount
+			<< " line: " << field.getLocation().begin.line
+			<< " column: " << field.getLocation().begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	FieldPlan plan;
+
+	plan.name = field.getName().getValue();
+	plan.alias = utility::conversions::to_string_t((field.getAlias() != nullptr) ? field.getAlias()->getValue() : plan.name);
+	plan.location = field.getLocation();
+	plan.typeConditions = _typeConditions;
+	plan.fragmentConditions = _fragmentConditions;
+	plan.skip = shouldSkip(field.getDirectives(), plan.conditions);
+	plan.arguments = web::json::value::object(true);
+
+	if (plan.skip)
+	{
+		// We still need to check the field name when it's resolved, but nothing else.
+		_plan->fields.push_back(std::move(plan));
+		return false;
+	}
+
+	if (field.getArguments() != nullptr)
+	{
+		const auto noVariables = web::json::value::object();
+		ValueVisitor visitor(noVariables.as_object());
+
+		for (const auto& argument : *field.getArguments())
+		{
+			auto name = utility::conversions::to_string_t(argument->getName().getValue());
+			VariableReferenceVisitor variableVisitor;
+
+			argument->getValue().accept(&variableVisitor);
+
+			if (variableVisitor.hasVariables())
+			{
+				plan.variableArguments.push_back({ std::move(name), &argument->getValue() });
+			}
+			else
+			{
+				argument->getValue().accept(&visitor);
+				plan.arguments[name] = visitor.getValue();
+			}
+		}
+	}
+
+	if (field.getSelectionSet() != nullptr)
+	{
+		SelectionPlanVisitor visitor(_fragments, _fragmentStack, _fieldCount);
+
+		field.getSelectionSet()->accept(&visitor);
+		plan.selection = visitor.getPlan();
+	}
+
+	plan.stream = getStream(field.getDirectives());
+	_plan->fields.push_back(std::move(plan));
+
+	return false;
+}
+
+bool SelectionPlanVisitor::visitFragmentSpread(const ast::FragmentSpread &fragmentSpread)
+{
+	const std::string name(fragmentSpread.getName().getValue());
+	auto itr = _fragments.find(name);
+
+	if (itr == _fragments.cend())
+	{
+		std::ostringstream error;
+
+		error << "Unknown fragment name: " << name
+			<< " line: " << fragmentSpread.getLocation().begin.line
+			<< " column: " << fragmentSpread.getLocation().begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	if (std::find(_fragmentStack.cbegin(), _fragmentStack.cend(), name) != _fragmentStack.cend())
+	{
+		std::ostringstream error;
+
+		error << "Fragment cycle with fragment name: " << name
+			<< " line: " << fragmentSpread.getLocation().begin.line
+			<< " column: " << fragmentSpread.getLocation().begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	const auto conditionCount = _fragmentConditions.size();
+
+	if (!shouldSkip(fragmentSpread.getDirectives(), _fragmentConditions))
+	{
+		_fragmentStack.push_back(name);
+		_typeConditions.push_back(itr->second.getType());
+		visitFragment(fragmentSpread.getDirectives(), itr->second.getSelection());
+		_typeConditions.pop_back();
+		_fragmentStack.pop_back();
+	}
+
+	_fragmentConditions.resize(conditionCount);
+
+	return false;
+}
+
+bool SelectionPlanVisitor::visitInlineFragment(const ast::InlineFragment &inlineFragment)
+{
+	const auto conditionCount = _fragmentConditions.size();
+
+	if (!shouldSkip(inlineFragment.getDirectives(), _fragmentConditions))
+	{
+		const bool hasTypeCondition = (inlineFragment.getTypeCondition() != nullptr);
+
+		if (hasTypeCondition)
+		{
+			_typeConditions.push_back(inlineFragment.getTypeCondition()->getName().getValue());
+		}
+
+		visitFragment(inlineFragment.getDirectives(), inlineFragment.getSelectionSet());
+
+		if (hasTypeCondition)
+		{
+			_typeConditions.pop_back();
+		}
+	}
+
+	_fragmentConditions.resize(conditionCount);
+
+	return false;
+}
+
+void SelectionPlanVisitor::visitFragment(const std::vector<std::unique_ptr<ast::Directive>>* directives, const ast::SelectionSet& selection)
+{
+	std::string label;
+	const ast::Value* condition = nullptr;
+
+	if (!findDirective(directives, "defer", { "if", "label" }, label, condition, nullptr))
+	{
+		selection.accept(this);
+		return;
+	}
+
+	// The deferred fields still need the type conditions and directives from every fragment
+	// they're nested in, but they go in a separate selection set.
+	SelectionPlanVisitor visitor(_fragments, _fragmentStack, _fieldCount);
+
+	visitor._typeConditions = _typeConditions;
+	visitor._fragmentConditions = _fragmentConditions;
+	selection.accept(&visitor);
+
+	_plan->deferred.push_back({ std::move(label), condition, _typeConditions, _fragmentConditions, visitor.getPlan() });
+}
+
+std::shared_ptr<const StreamPlan> SelectionPlanVisitor::getStream(const std::vector<std::unique_ptr<ast::Directive>>* directives)
+{
+	std::string label;
+	const ast::Value* condition = nullptr;
+	const ast::Value* initialCount = nullptr;
+
+	if (!findDirective(directives, "stream", { "if", "label", "initialCount" }, label, condition, &initialCount))
+	{
+		return nullptr;
+	}
+
+	return std::make_shared<StreamPlan>(StreamPlan { std::move(label), initialCount, condition });
+}
+
+bool SelectionPlanVisitor::findDirective(const std::vector<std::unique_ptr<ast::Directive>>* directives, const char* name,
+	std::initializer_list<const char*> argumentNames, std::string& label, const ast::Value*& condition, const ast::Value** initialCount)
+{
+	if (directives == nullptr)
+	{
+		return false;
+	}
+
+	auto itr = std::find_if(directives->cbegin(), directives->cend(),
+		[name](const std::unique_ptr<ast::Directive>& directive)
+	{
+		return std::strcmp(directive->getName().getValue(), name) == 0;
+	});
+
+	if (itr == directives->cend())
+	{
+		return false;
+	}
+
+	if ((*itr)->getArguments() == nullptr)
+	{
+		return true;
+	}
+
+	for (const auto& argument : *(*itr)->getArguments())
+	{
+		const std::string argumentName(argument->getName().getValue());
+
+		if (std::none_of(argumentNames.begin(), argumentNames.end(),
+			[&argumentName](const char* allowed)
+		{
+			return argumentName == allowed;
+		}))
+		{
+			std::ostringstream error;
+
+			error << "Unknown argument to directive: " << name
+				<< " name: " << argumentName
+				<< " line: " << argument->getLocation().begin.line
+				<< " column: " << argument->getLocation().begin.column;
+
+			throw schema_exception({ error.str() });
+		}
+
+		if (argumentName == "label")
+		{
+			// Labels identify the patches, so they can't depend on the variables.
+			const auto noVariables = web::json::value::object();
+			auto value = getDirectiveArgument(&argument->getValue(), noVariables.as_object());
+
+			if (!value.is_string())
+			{
+				throwInvalidDirectiveArgument(name, "label", argument->getValue());
+			}
+
+			label = utility::conversions::to_utf8string(value.as_string());
+		}
+		else if (argumentName == "if")
+		{
+			condition = &argument->getValue();
+		}
+		else if (initialCount != nullptr)
+		{
+			*initialCount = &argument->getValue();
+		}
+	}
+
+	return true;
+}
+
+bool SelectionPlanVisitor::shouldSkip(const std::vector<std::unique_ptr<ast::Directive>>* directives, DirectiveConditions& conditions)
+{
+	if (directives == nullptr)
+	{
+		return false;
+	}
+
+	for (const auto& directive : *directives)
+	{
+		const std::string name(directive->getName().getValue());
+		const bool include = (name == "include");
+		const bool skip = (!include && (name == "skip"));
+
+		if (!include && !skip)
+		{
+			continue;
+		}
+
+		const auto argument = (directive->getArguments() != nullptr && directive->getArguments()->size() == 1)
+			? directive->getArguments()->front().get()
+			: nullptr;
+		const std::string argumentName((argument != nullptr) ? argument->getName().getValue() : "");
+
+		if (argumentName != "if")
+		{
+			std::ostringstream error;
+
+			error << "Unknown argument to directive: " << name;
+
+			if (!argumentName.empty())
+			{
+				error << " name: " << argumentName;
+			}
+
+			if (argument != nullptr)
+			{
+				error << " line: " << argument->getLocation().begin.line
+					<< " column: " << argument->getLocation().begin.column;
+			}
+
+			throw schema_exception({ error.str() });
+		}
+
+		DirectiveCondition condition { skip, argument };
+		VariableReferenceVisitor variableVisitor;
+
+		argument->getValue().accept(&variableVisitor);
+
+		if (variableVisitor.hasVariables())
+		{
+			// We'll need to check this one later when we know the variables.
+			conditions.push_back(condition);
+		}
+		else if (condition.shouldSkip(web::json::value::object().as_object()))
+		{
+			// Skip this item
+			return true;
+		}
+	}
+
+	return false;
+}
+
+ValueVisitor::ValueVisitor(const web::json::object& variables)
+	: _variables(variables)
+{
+}
+
+web::json::value ValueVisitor::getValue()
+{
+	web::json::value result(std::move(_value));
+	return result;
+}
+
+bool ValueVisitor::visitVariable(const ast::Variable& variable)
+{
+	const std::string name(variable.getName().getValue());
+	auto itr = _variables.find(utility::conversions::to_string_t(name));
+
+	if (itr == _variables.cend())
+	{
+		std::ostringstream error;
+
+		error << "Unknown variable name: " << name
+			<< " line: " << variable.getLocation().begin.line
+			<< " column: " << variable.getLocation().begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	_value = itr->second;
+
+	return false;
+}
+
+bool ValueVisitor::visitIntValue(const ast::IntValue& intValue)
+{
+	_value = web::json::value::number(std::atoi(intValue.getValue()));
 	return false;
 }
 
@@ -496,155 +2530,211 @@ bool ValueVisitor::visitObjectValue(const ast::ObjectValue& objectValue)
 	return false;
 }
 
-FragmentDefinitionVisitor::FragmentDefinitionVisitor()
-{
-}
+namespace {
 
-FragmentMap FragmentDefinitionVisitor::getFragments()
+// VariableCoercionVisitor checks a variable value against the type it was declared with, in the
+// same pass which copies it into the operation variables. Built-in scalars must have the right
+// JSON type, and a single value for a list type is wrapped in a list. Input objects, enums, and
+// custom scalars are converted by their arguments when they're used.
+class VariableCoercionVisitor : public ast::visitor::AstVisitor
 {
-	FragmentMap result(std::move(_fragments));
-	return result;
-}
+public:
+	explicit VariableCoercionVisitor(const ast::VariableDefinition& definition, web::json::value& value)
+		: _definition(definition)
+		, _value(value)
+	{
+	}
 
-bool FragmentDefinitionVisitor::visitFragmentDefinition(const ast::FragmentDefinition& fragmentDefinition)
-{
-	_fragments.insert({ fragmentDefinition.getName().getValue(), Fragment(fragmentDefinition) });
-	return false;
-}
+	bool visitNonNullType(const ast::NonNullType& nonNullType) override
+	{
+		if (_value.is_null())
+		{
+			throwError("Missing value for non-null variable: ", nullptr);
+		}
 
-OperationDefinitionVisitor::OperationDefinitionVisitor(const TypeMap& operations, const std::string& operationName, const web::json::object& variables, const FragmentMap& fragments)
-	: _operations(operations)
-	, _operationName(operationName)
-	, _variables(variables)
-	, _fragments(fragments)
-{
-}
+		nonNullType.getType().accept(this);
 
-web::json::value OperationDefinitionVisitor::getValue()
-{
-	web::json::value result(std::move(_result));
+		return false;
+	}
 
-	try
+	bool visitListType(const ast::ListType& listType) override
 	{
-		if (result.is_null())
+		if (_value.is_null())
 		{
-			std::ostringstream error;
-
-			error << "Missing operation";
+			return false;
+		}
 
-			if (!_operationName.empty())
-			{
-				error << " name: " << _operationName;
-			}
+		if (!_value.is_array())
+		{
+			auto element = web::json::value::array(1);
 
-			throw schema_exception({ error.str() });
+			element.as_array()[0] = std::move(_value);
+			_value = std::move(element);
 		}
-	}
-	catch (const schema_exception& ex)
-	{
-		result = web::json::value::object({
-			{ _XPLATSTR("data"),  web::json::value::null() },
-			{ _XPLATSTR("errors"), ex.getErrors() }
-			}, true);
-	}
 
-	return result;
-}
+		for (auto& element : _value.as_array())
+		{
+			VariableCoercionVisitor visitor(_definition, element);
 
-bool OperationDefinitionVisitor::visitOperationDefinition(const ast::OperationDefinition& operationDefinition)
-{
-	std::string operation(operationDefinition.getOperation());
-	const std::string name((operationDefinition.getName() != nullptr) ? operationDefinition.getName()->getValue() : "");
-	const yy::location& location = name.empty() ? operationDefinition.getLocation() : operationDefinition.getName()->getLocation();
+			listType.getType().accept(&visitor);
+		}
 
-	try
+		return false;
+	}
+
+	bool visitNamedType(const ast::NamedType& namedType) override
 	{
-		if (!_operationName.empty()
-			&& name != _operationName)
+		if (_value.is_null())
 		{
-			// Skip the operations that don't match the name
 			return false;
 		}
 
+		const char* typeName = namedType.getName().getValue();
+		bool matches = true;
 
-		if (!_result.is_null())
+		if (std::strcmp(typeName, "Int") == 0)
 		{
-			std::ostringstream error;
+			matches = _value.is_integer();
+		}
+		else if (std::strcmp(typeName, "Float") == 0)
+		{
+			matches = _value.is_number();
 
-			if (_operationName.empty())
+			// Int values are valid for Float, but the argument converters only accept doubles.
+			if (matches
+				&& !_value.is_double())
 			{
-				error << "No operationName specified with extra operation";
-			}
-			else
-			{
-				error << "Duplicate operation";
+				_value = web::json::value::number(_value.as_double());
 			}
+		}
+		else if (std::strcmp(typeName, "String") == 0
+			|| std::strcmp(typeName, "ID") == 0)
+		{
+			matches = _value.is_string();
+		}
+		else if (std::strcmp(typeName, "Boolean") == 0)
+		{
+			matches = _value.is_boolean();
+		}
 
-			if (!name.empty())
-			{
-				error << " name: " << name;
-			}
+		if (!matches)
+		{
+			throwError("Invalid value for variable: ", typeName);
+		}
 
-			error << " line: " << location.begin.line
-				<< " column: " << location.begin.column;
+		return false;
+	}
 
-			throw schema_exception({ error.str() });
-		}
+private:
+	void throwError(const char* message, const char* expected) const
+	{
+		const auto& variable = _definition.getVariable();
+		std::ostringstream error;
 
-		auto itr = _operations.find(operation);
+		error << message << variable.getName().getValue();
 
-		if (itr == _operations.cend())
+		if (expected != nullptr)
 		{
-			std::ostringstream error;
+			error << " expected: " << expected;
+		}
 
-			error << "Unknown operation type: " << operation;
+		error << " line: " << variable.getLocation().begin.line
+			<< " column: " << variable.getLocation().begin.column;
 
-			if (!name.empty())
-			{
-				error << " name: " << name;
-			}
+		throw schema_exception({ error.str() });
+	}
 
-			error << " line: " << location.begin.line
-				<< " column: " << location.begin.column;
+	const ast::VariableDefinition& _definition;
+	web::json::value& _value;
+};
 
-			throw schema_exception({ error.str() });
-		}
+} /* namespace */
 
-		auto operationVariables = web::json::value::object();
+web::json::value getOperationVariables(const ast::OperationDefinition& operationDefinition, const web::json::object& variables)
+{
+	auto operationVariables = web::json::value::object();
 
-		if (operationDefinition.getVariableDefinitions() != nullptr)
+	if (operationDefinition.getVariableDefinitions() != nullptr)
+	{
+		for (const auto& variable : *operationDefinition.getVariableDefinitions())
 		{
-			for (const auto& variable : *operationDefinition.getVariableDefinitions())
+			auto nameVar = utility::conversions::to_string_t(variable->getVariable().getName().getValue());
+			auto itrVar = variables.find(nameVar);
+			web::json::value value;
+
+			if (itrVar != variables.cend())
+			{
+				value = itrVar->second;
+			}
+			else if (variable->getDefaultValue() != nullptr)
 			{
-				auto nameVar = utility::conversions::to_string_t(variable->getVariable().getName().getValue());
-				auto itrVar = _variables.find(nameVar);
+				ValueVisitor visitor(variables);
 
-				if (itrVar != _variables.cend())
-				{
-					operationVariables[itrVar->first] = itrVar->second;
-				}
-				else if (variable->getDefaultValue() != nullptr)
-				{
-					ValueVisitor visitor(_variables);
+				variable->getDefaultValue()->accept(&visitor);
+				value = visitor.getValue();
+			}
 
-					variable->getDefaultValue()->accept(&visitor);
-					operationVariables[std::move(nameVar)] = visitor.getValue();
-				}
+			VariableCoercionVisitor coercion(*variable, value);
+
+			variable->getType().accept(&coercion);
+
+			// Leave out variables which weren't provided and don't have a default value, so they're
+			// still missing rather than null.
+			if (itrVar != variables.cend()
+				|| variable->getDefaultValue() != nullptr)
+			{
+				operationVariables[std::move(nameVar)] = std::move(value);
 			}
 		}
-
-		_result = web::json::value::object({
-			{ _XPLATSTR("data"), itr->second->resolve(operationDefinition.getSelectionSet(), _fragments, operationVariables.as_object()) }
-			}, true);
-	}
-	catch (const schema_exception& ex)
-	{
-		_result = web::json::value::object({
-			{ _XPLATSTR("data"),  web::json::value::null() },
-			{ _XPLATSTR("errors"), ex.getErrors() }
-			}, true);
 	}
 
+	return operationVariables;
+}
+
+VariableReferenceVisitor::VariableReferenceVisitor()
+{
+}
+
+bool VariableReferenceVisitor::hasVariables() const
+{
+	return _hasVariables;
+}
+
+bool VariableReferenceVisitor::visitVariable(const ast::Variable&)
+{
+	_hasVariables = true;
+	return false;
+}
+
+FragmentDefinitionVisitor::FragmentDefinitionVisitor()
+{
+}
+
+FragmentMap FragmentDefinitionVisitor::getFragments()
+{
+	FragmentMap result(std::move(_fragments));
+	return result;
+}
+
+bool FragmentDefinitionVisitor::visitFragmentDefinition(const ast::FragmentDefinition& fragmentDefinition)
+{
+	_fragments.insert({ fragmentDefinition.getName().getValue(), Fragment(fragmentDefinition) });
+	return false;
+}
+
+OperationDefinitionVisitor::OperationDefinitionVisitor()
+{
+}
+
+OperationDefinitionList OperationDefinitionVisitor::getOperations()
+{
+	OperationDefinitionList result(std::move(_operations));
+	return result;
+}
+
+bool OperationDefinitionVisitor::visitOperationDefinition(const ast::OperationDefinition& operationDefinition)
+{
+	_operations.push_back(&operationDefinition);
 	return false;
 }
 
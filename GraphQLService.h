@@ -12,12 +12,18 @@
 #include <unordered_set>
 #include <exception>
 #include <type_traits>
+#include <future>
+#include <mutex>
+
+#include "Arena.h"
 
 #include <graphqlparser/Ast.h>
 #include <graphqlparser/AstVisitor.h>
 
 #include <cpprest/json.h>
 
+#include "ResponseWriter.h"
+
 namespace facebook {
 namespace graphql {
 namespace service {
@@ -34,6 +40,14 @@ private:
 	web::json::value _errors;
 };
 
+// A non-null field which failed to resolve throws this to make its parent null instead. The error
+// has already been added to the FieldErrors for the operation, so this doesn't have any.
+class null_propagation_exception : public schema_exception
+{
+public:
+	null_propagation_exception();
+};
+
 // Fragments are referenced by name and have a single type condition (except for inline
 // fragments, where the type condition is common but optional). They contain a set of fields
 // (with optional aliases and sub-selections) and potentially references to other fragments.
@@ -55,20 +69,321 @@ private:
 // the request document by name.
 using FragmentMap = std::unordered_map<std::string, Fragment>;
 
+// @skip and @include directives which reference a variable can't be evaluated until we know
+// the values of the request variables. Directives with constant arguments never make it into
+// the execution plan.
+struct DirectiveCondition
+{
+	bool shouldSkip(const web::json::object& variables) const;
+
+	bool skip;
+	const ast::Argument* argument;
+};
+
+using DirectiveConditions = std::vector<DirectiveCondition>;
+
+struct SelectionSetPlan;
+
+// StreamPlan is the @stream directive on a list field. The initialCount and if arguments may
+// refer to variables, so they're evaluated when the list is resolved.
+struct StreamPlan
+{
+	std::string label;
+	const ast::Value* initialCount;
+	const ast::Value* condition;
+
+	// Return how many elements belong in the initial payload, which is all of them if the
+	// condition is false.
+	size_t getInitialCount(const web::json::object& variables, size_t size) const;
+};
+
+// FieldPlan is a single field in a compiled selection set, with any fragments it came from
+// already expanded. It must match all of the type conditions and pass all of the directive
+// conditions from those fragments before it's resolved. Constant arguments are converted
+// to JSON once, only the arguments which reference variables are evaluated per request.
+struct FieldPlan
+{
+	std::string name;
+	utility::string_t alias;
+	yy::location location;
+
+	std::vector<std::string> typeConditions;
+	DirectiveConditions fragmentConditions;
+
+	bool skip;
+	DirectiveConditions conditions;
+
+	web::json::value arguments;
+	std::vector<std::pair<utility::string_t, const ast::Value*>> variableArguments;
+
+	std::shared_ptr<const SelectionSetPlan> selection;
+	std::shared_ptr<const StreamPlan> stream;
+
+	// Fill in the arguments which reference variables on a copy of the constant arguments.
+	web::json::value evaluateArguments(const web::json::object& variables) const;
+};
+
+// DeferredPlan is a fragment with a @defer directive, which is compiled into its own selection
+// set. It's resolved after the initial payload if the operation is resolved incrementally and the
+// condition is true, otherwise it's resolved along with the rest of the fields.
+struct DeferredPlan
+{
+	std::string label;
+	const ast::Value* condition;
+
+	std::vector<std::string> typeConditions;
+	DirectiveConditions fragmentConditions;
+
+	std::shared_ptr<const SelectionSetPlan> selection;
+
+	bool shouldDefer(const web::json::object& variables) const;
+};
+
+// SelectionSetPlan is the flattened list of fields in a selection set, in document order, and
+// the deferred fragments which were spread in it. The fieldNames are every field which might be
+// selected, including the ones in deferred fragments but not the ones with a constant @skip or
+// @include, so most lookups for a field which isn't there don't need to scan the fields.
+struct SelectionSetPlan
+{
+	std::vector<FieldPlan> fields;
+	std::vector<DeferredPlan> deferred;
+	std::unordered_set<std::string> fieldNames;
+};
+
+class OperationExecutor;
+class DataLoaderScope;
+class FieldTracer;
+class IncrementalScope;
+class CachePolicy;
+
+// ArgumentCache holds the arguments for each field which references variables, after they're
+// evaluated the first time the field is resolved in an operation. The variables don't change
+// during an operation, so every other object in a list which resolves the same field shares them
+// instead of copying the variable values again. It's safe to use from multiple threads.
+class ArgumentCache
+{
+public:
+	const web::json::value& get(const FieldPlan& field, const web::json::object& variables);
+
+private:
+	std::mutex _mutex;
+	std::unordered_map<const FieldPlan*, std::unique_ptr<const web::json::value>> _arguments;
+};
+
+// ResponsePath is the path to a field in the response, linked from the field back up to the root.
+// Each segment is either a field alias or, if alias is null, an index in a list.
+struct ResponsePath
+{
+	const ResponsePath* parent;
+	const utility::string_t* alias;
+	size_t index;
+
+	// Convert to an array of aliases and indices starting from the root.
+	web::json::value toJson() const;
+};
+
+class Metrics;
+
+// FieldErrors collects the errors from fields which failed to resolve, so the rest of the response
+// can still be returned. Each error has the location of the field in the document and the path to
+// it in the response. If there are Metrics, the failures are counted for each field as well.
+class FieldErrors
+{
+public:
+	explicit FieldErrors(Metrics* metrics = nullptr);
+
+	void add(const schema_exception& ex, const yy::location* location, const ResponsePath* path);
+	void countField(const std::string& typeName, const std::string& fieldName);
+
+	bool empty() const;
+
+	// Remove the errors which have been added so far and return them in order, after the errors
+	// from the exception which ended the payload if there was one. Responses resolved incrementally
+	// take the errors for each payload separately.
+	web::json::value takeErrors(const schema_exception* ex = nullptr);
+
+private:
+	Metrics* const _metrics;
+
+	mutable std::mutex _mutex;
+	std::vector<web::json::value> _errors;
+};
+
+// OperationParams are shared by all of the resolvers in a single operation. If there's a writer,
+// resolvers for objects and lists write their results directly to it and return null. The launch
+// policy decides whether field results are converted on another thread or deferred until they're
+// joined, writing a response always uses std::launch::deferred so the output stays in order. If
+// there's an executor, sibling fields are joined as tasks on it instead of with std::async.
+// Every DataLoader keeps its pending keys and memoized values for the operation in loaders. If
+// there's a tracer, it's called before and after each resolver. The arena holds the temporary
+// state for the operation, and resolvers can use it for their own short-lived objects. If the
+// operation is resolved incrementally, deferred fragments and streamed lists are queued in the
+// IncrementalScope. Cache hints for the response are combined in the CachePolicy if there is one.
+// Long lists of objects are split into tasks of parallelListThreshold elements on the executor.
+// If there's an ArgumentCache, each field evaluates its variable arguments once per operation.
+// If there are FieldErrors, a field which fails to resolve is replaced with null and its error is
+// added there, otherwise the first error fails the whole operation.
+struct OperationParams
+{
+	const web::json::object& variables;
+	ResponseWriter* writer;
+	std::launch launch;
+	OperationExecutor* executor;
+	DataLoaderScope& loaders;
+	FieldTracer* tracer;
+	RequestArena& arena;
+	IncrementalScope* incremental;
+	CachePolicy* cachePolicy;
+	size_t parallelListThreshold;
+	ArgumentCache* arguments;
+	FieldErrors* errors;
+};
+
+// Call this from a catch block for a schema_exception from a field or a list element. If the
+// operation has FieldErrors, it adds the error and returns null for a nullable value, or throws a
+// null_propagation_exception so the parent becomes null. Otherwise it rethrows the exception.
+web::json::value handleFieldError(const OperationParams& params, const schema_exception& ex, bool nullable, const yy::location* location, const ResponsePath* path);
+
+// Fields and list elements are resolved in two passes: every sibling is started on the calling
+// thread, and only then are they joined, so a DataLoader has all of their keys before the first
+// one loads. Call this on each of them after they've all started. If the value is still deferred,
+// it's joined as a task on the executor, or on another thread with std::launch::async.
+std::future<web::json::value> dispatchDeferred(const OperationParams& params, std::future<web::json::value>&& value);
+
+// Join a value from dispatchDeferred. With an executor, this runs other tasks while it waits.
+web::json::value joinDispatched(const OperationParams& params, std::future<web::json::value>& value);
+
+// Wait for a value from dispatchDeferred to finish without joining it. Deferred values are skipped.
+void waitDispatched(const OperationParams& params, std::future<web::json::value>& value);
+
 // Resolver functors take a set of arguments encoded as members on a JSON object
-// with an optional selection set for complex types and return a JSON value for
-// a single field.
+// with an optional selection set plan for complex types and return a JSON value for
+// a single field. The path is only tracked when the operation is traced, resolved incrementally,
+// or collects FieldErrors, otherwise it's null. If the field has a @stream directive, that's
+// passed along to the list.
 struct ResolverParams
 {
 	const web::json::object& arguments;
-	const ast::SelectionSet* selection;
-	const FragmentMap& fragments;
-	const web::json::object& variables;
+	const SelectionSetPlan* selection;
+	const OperationParams& operation;
+	const ResponsePath* path;
+	const StreamPlan* stream;
+};
+
+// Patches for deferred fragments and streamed list elements resolve to a single JSON value.
+using IncrementalResolver = std::function<web::json::value(ResolverParams&&)>;
+
+// Return how many elements of a list are resolved right away. If the list is streamed, the rest
+// are queued with addStreamElement.
+size_t getInitialCount(const ResolverParams& params, size_t size);
+void addStreamElement(const ResolverParams& params, size_t index, IncrementalResolver&& resolver);
+
+// If there's an executor and a list of objects has at least parallelListThreshold elements, it's
+// split into chunks of that many elements and each chunk is resolved in a single task. The fields
+// of the elements in a chunk are resolved on the same thread instead of each getting a task of
+// their own, and the elements stay in order. If the elements are nullable, an element with an
+// error becomes null without failing the rest of the list.
+using ListElementStarter = std::function<std::future<web::json::value>(size_t index, ResolverParams&& params)>;
+
+bool shouldResolveInParallel(const ResolverParams& params, size_t size);
+web::json::value resolveListInParallel(const ResolverParams& params, size_t size, bool nullable, const ListElementStarter& start);
+
+// SelectionLookahead lets a resolver check which fields are selected beneath it before it loads
+// anything, e.g. to skip loading the edges of a connection if they aren't selected. Fragments are
+// already expanded in the plan, and @skip and @include are evaluated with the variables. Fields in
+// fragments with a type condition count as selected, since that depends on the object which is
+// resolved later.
+class SelectionLookahead
+{
+public:
+	explicit SelectionLookahead(const SelectionSetPlan* selection, const web::json::object& variables);
+
+	bool isSelected(const std::string& fieldName) const;
+
+	// Look further ahead at the fields beneath a field, merging every selection of it.
+	SelectionLookahead getChild(const std::string& fieldName) const;
+
+private:
+	explicit SelectionLookahead(std::vector<const SelectionSetPlan*>&& selections, const web::json::object& variables);
+
+	bool isSelected(const SelectionSetPlan& selection, const std::string& fieldName, std::vector<const SelectionSetPlan*>* children) const;
+	bool isIncluded(const DirectiveConditions& conditions) const;
+
+	std::vector<const SelectionSetPlan*> _selections;
+	const web::json::object& _variables;
+};
+
+// Field getters get the selection set beneath the field and the operation they're part of, so they
+// can share per-operation state like a DataLoader.
+struct FieldParams
+{
+	const SelectionSetPlan* selection;
+	const OperationParams& operation;
+
+	SelectionLookahead lookahead() const;
+};
+
+// Cache hints say how many seconds the value of a field can be cached. A private value is specific
+// to the caller, so it can only be cached in a scope which belongs to them.
+enum class CacheScope
+{
+	Public,
+	Private
+};
+
+struct CacheHint
+{
+	size_t maxAge;
+	CacheScope scope;
 };
 
-using Resolver = std::function<web::json::value(ResolverParams&&)>;
+// Add a hint for a field in the operation. The response can be cached for the shortest maxAge of
+// all of its hints, and only for the caller if any of them are private. Schemas can add hints with
+// a @cacheControl(maxAge: Int, scope: PUBLIC | PRIVATE) directive on the field definition.
+void addCacheHint(const OperationParams& params, const CacheHint& hint);
+
+// Resolvers return a std::future so that all of the fields in a selection set can be started before
+// we wait for any of them.
+using Resolver = std::function<std::future<web::json::value>(ResolverParams&&)>;
 using ResolverMap = std::unordered_map<std::string, Resolver>;
 
+// Field getters return a FieldResult, which they can construct either from the value itself, or from
+// a std::future if they need to wait for a backend service.
+template <typename _Type>
+class FieldResult
+{
+public:
+	template <typename _Value, typename = typename std::enable_if<std::is_convertible<_Value, _Type>::value>::type>
+	FieldResult(_Value&& value)
+		: _value(std::forward<_Value>(value))
+	{
+	}
+
+	FieldResult(std::future<_Type>&& future)
+		: _future(std::move(future))
+	{
+	}
+
+	bool is_ready() const
+	{
+		return !_future.valid();
+	}
+
+	_Type get()
+	{
+		if (_future.valid())
+		{
+			return _future.get();
+		}
+
+		return std::move(_value);
+	}
+
+private:
+	_Type _value;
+	std::future<_Type> _future;
+};
+
 // Types be wrapped non-null or list types in GraphQL. Since nullability is a more special case
 // in C++, we invert the default and apply that modifier instead when the non-null wrapper is
 // not present in that part of the wrapper chain.
@@ -87,6 +402,8 @@ struct DisableList {};
 // If the argument is not optional, use require and let it throw a schema_exception when the
 // argument is missing or not the correct type. If it's nullable, use find and check the second
 // element in the pair to see if it was found or if you just got the default value for that type.
+// Values which have already been looked up, like list elements or input object members, can be
+// passed straight to convert.
 template <typename _Type, TypeModifier _Modifier = TypeModifier::None, TypeModifier... _Other>
 struct ModifiedArgument
 {
@@ -110,7 +427,7 @@ struct ModifiedArgument
 		return ModifiedArgument<_Type>::require(std::move(name), arguments);
 	}
 
-	// Peel off nullable modifiers.
+	// Peel off nullable modifiers. A missing argument is the same as null.
 	static type require(const typename std::conditional<TypeModifier::Nullable == _Modifier, std::string, DisableNullable>::type& name,
 		const web::json::object& arguments)
 	{
@@ -120,15 +437,12 @@ struct ModifiedArgument
 		{
 			const auto& valueItr = arguments.find(utility::conversions::to_string_t(name));
 
-			if (valueItr == arguments.cend()
-				|| valueItr->second.is_null())
+			if (valueItr == arguments.cend())
 			{
-				return std::unique_ptr<typename ModifiedArgument<_Type, _Other...>::type>();
+				return type();
 			}
 
-			auto result = ModifiedArgument<_Type, _Other...>::require(std::move(name), arguments);
-			
-			return std::unique_ptr<typename ModifiedArgument<_Type, _Other...>::type>(new decltype(result)(std::move(result)));
+			return convert(valueItr->second);
 		}
 		catch (const web::json::json_exception& ex)
 		{
@@ -147,20 +461,27 @@ struct ModifiedArgument
 
 		try
 		{
-			const auto& values = arguments.at(utility::conversions::to_string_t(name)).as_array();
-			type result(values.size());
+			return convert(arguments.at(utility::conversions::to_string_t(name)));
+		}
+		catch (const web::json::json_exception& ex)
+		{
+			std::ostringstream error;
 
-			std::transform(values.cbegin(), values.cend(), result.begin(),
-				[](const web::json::value& element)
-			{
-				auto single = web::json::value::object({
-					{ _XPLATSTR("value"), element }
-				});
+			error << "Invalid argument: " << name << " message: " << ex.what();
+			throw schema_exception({ error.str() });
+		}
+	}
 
-				return ModifiedArgument<_Type, _Other...>::require("value", single.as_object());
-			});
+	// Fall back to the default value from the schema if the argument is missing.
+	static type require(const std::string& name, const web::json::object& arguments, const web::json::value& defaultValue)
+	{
+		try
+		{
+			const auto& valueItr = arguments.find(utility::conversions::to_string_t(name));
 
-			return result;
+			return convert(valueItr == arguments.cend()
+				? defaultValue
+				: valueItr->second);
 		}
 		catch (const web::json::json_exception& ex)
 		{
@@ -171,6 +492,35 @@ struct ModifiedArgument
 		}
 	}
 
+	// Convert a nullable value which has already been looked up.
+	static type convert(const typename std::conditional<TypeModifier::Nullable == _Modifier, web::json::value, DisableNullable>::type& value)
+	{
+		if (value.is_null())
+		{
+			return type();
+		}
+
+		auto result = ModifiedArgument<_Type, _Other...>::convert(value);
+
+		return type(new decltype(result)(std::move(result)));
+	}
+
+	// Convert each of the elements in a list value directly, without looking them up again.
+	static type convert(const typename std::conditional<TypeModifier::List == _Modifier, web::json::value, DisableList>::type& value)
+	{
+		const auto& values = value.as_array();
+		type result;
+
+		result.reserve(values.size());
+
+		for (const auto& element : values)
+		{
+			result.push_back(ModifiedArgument<_Type, _Other...>::convert(element));
+		}
+
+		return result;
+	}
+
 	static std::pair<type, bool> find(const std::string& name, const web::json::object& arguments) noexcept
 	{
 		try
@@ -208,6 +558,26 @@ struct ModifiedArgument<_Type, TypeModifier::None>
 		}
 	}
 
+	// Fall back to the default value from the schema if the argument is missing.
+	static _Type require(const std::string& name, const web::json::object& arguments, const web::json::value& defaultValue)
+	{
+		try
+		{
+			const auto& valueItr = arguments.find(utility::conversions::to_string_t(name));
+
+			return convert(valueItr == arguments.cend()
+				? defaultValue
+				: valueItr->second);
+		}
+		catch (const web::json::json_exception& ex)
+		{
+			std::ostringstream error;
+
+			error << "Invalid argument: " << name << " message: " << ex.what();
+			throw schema_exception({ error.str() });
+		}
+	}
+
 	// Wrap require in a try/catch block.
 	static std::pair<_Type, bool> find(const std::string& name, const web::json::object& arguments) noexcept
 	{
@@ -241,6 +611,79 @@ template <TypeModifier... _Modifiers> using ScalarArgument = ModifiedArgument<we
 // name and any inheritted interfaces.
 using TypeNames = std::unordered_set<std::string>;
 
+// FieldTable is a static array of field names sorted with std::strcmp. Generated objects pass one
+// to the service::Object constructor and resolve each field with a switch on its index in the
+// table, so they don't need to build a ResolverMap for every instance. The nullable array says
+// which fields can be null in the schema, if it's missing they all can.
+struct FieldTable
+{
+	const char* const* names;
+	size_t size;
+	const bool* nullable;
+
+	// Return the index of the field name, or size if it isn't in the table.
+	size_t find(const std::string& name) const;
+
+	// Objects with a ResolverMap don't know the types of their fields, so they're all nullable.
+	bool isNullable(size_t index) const;
+};
+
+// ObjectType is everything about an object which is the same for every instance of the type: the
+// type name, the names it matches in fragment type conditions, and its FieldTable. Generated
+// objects refer to a static ObjectType, so constructing one doesn't allocate anything beyond the
+// object itself.
+struct ObjectType
+{
+	std::string typeName;
+	TypeNames typeNames;
+	FieldTable fields;
+};
+
+// PendingFields are the fields in a selection set which have been started but not joined yet. If
+// they're destroyed before they're joined, they wait for anything which is still running on
+// another thread.
+class PendingFields
+{
+public:
+	explicit PendingFields(const OperationParams& params);
+	PendingFields(PendingFields&& other) = default;
+	~PendingFields();
+
+	// Wait for the rest of the fields and return the result, or write it to the ResponseWriter.
+	web::json::value join();
+
+private:
+	friend class Object;
+
+	struct PendingField
+	{
+		const FieldPlan* plan;
+		bool nullable;
+		const ResponsePath* path;
+		std::future<web::json::value> value;
+	};
+
+	// Object::start reserves room for every field in the selection set before it starts any of them.
+	void reserve(size_t fieldCount);
+	void joinStarted();
+	web::json::value joinField(PendingField& field);
+
+	const OperationParams& _params;
+	const std::string* _typeName = nullptr;
+
+	// The arguments need to outlive the futures which refer to them, and reserving space up front
+	// keeps them from moving.
+	std::vector<web::json::value, ArenaAllocator<web::json::value>> _arguments;
+	std::vector<PendingField, ArenaAllocator<PendingField>> _fields;
+	size_t _dispatched = 0;
+	size_t _joined = 0;
+	bool _writing = false;
+	web::json::value _result;
+
+	// Only used when the operation is traced, resolved incrementally, or collects FieldErrors.
+	std::vector<ResponsePath, ArenaAllocator<ResponsePath>> _paths;
+};
+
 // Object parses argument values, performs variable lookups, expands fragments, evaluates @include
 // and @skip directives, and calls through to the resolver functor for each selected field with
 // its arguments. This may be a recursive process for fields which return another complex type,
@@ -248,18 +691,74 @@ using TypeNames = std::unordered_set<std::string>;
 class Object : public std::enable_shared_from_this<Object>
 {
 public:
-	explicit Object(TypeNames&& typeNames, ResolverMap&& resolvers);
+	explicit Object(std::string&& typeName, TypeNames&& typeNames, ResolverMap&& resolvers);
+	explicit Object(const ObjectType& type);
+	virtual ~Object() = default;
+
+	const std::string& getTypeName() const;
+
+	// Start resolving all of the fields without joining any of them. Serial resolution for mutations
+	// waits for each field before starting the next one. The path is only set for traced operations.
+	PendingFields start(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, bool serial = false) const;
+
+	// Start resolving all of the fields and then join them in order.
+	web::json::value resolve(const SelectionSetPlan& selection, const OperationParams& params, bool serial = false) const;
 
-	web::json::value resolve(const ast::SelectionSet& selection, const FragmentMap& fragments, const web::json::object& variables) const;
+protected:
+	// Resolve the field at this index in the FieldTable.
+	virtual std::future<web::json::value> resolveField(size_t index, ResolverParams&& params) const;
 
 private:
-	TypeNames _typeNames;
+	bool matchesFragment(const std::vector<std::string>& typeConditions, const DirectiveConditions& fragmentConditions, const web::json::object& variables) const;
+
+	// Find the deferred fragments which should be resolved along with the rest of the selection set,
+	// and queue the others as patches.
+	void collectSelections(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, std::vector<const SelectionSetPlan*>& selections) const;
+	void startFields(const SelectionSetPlan& selection, const OperationParams& params, const ResponsePath* path, bool serial, PendingFields& pending) const;
+	std::future<web::json::value> callResolver(const Resolver* resolver, size_t index, ResolverParams&& params) const;
+
+	// Objects with a ResolverMap own their ObjectType, generated objects share a static one.
+	std::unique_ptr<const ObjectType> _ownedType;
+	const ObjectType& _type;
 	ResolverMap _resolvers;
 };
 
 using TypeMap = std::unordered_map<std::string, std::shared_ptr<Object>>;
 
 struct DisableNullableSharedPtr {};
+struct DisableObject {};
+
+// Convert a FieldResult to JSON once it's ready. Scalar values which are already available are
+// converted right away, anything else is converted when it's joined.
+template <typename _Result, typename _Type>
+std::future<web::json::value> convertFieldResult(FieldResult<_Type>&& result, ResolverParams&& params)
+{
+	if (!std::is_base_of<Object, typename _Result::base_type>::value
+		&& result.is_ready()
+		&& params.operation.writer == nullptr)
+	{
+		std::promise<web::json::value> promise(std::allocator_arg, ArenaAllocator<web::json::value>(params.operation.arena));
+
+		promise.set_value(_Result::convert(result.get(), std::move(params)));
+
+		return promise.get_future();
+	}
+
+	// Wait until the siblings of this field have been started to get the result, it might be
+	// waiting for a DataLoader. The launch policy decides where it's joined in dispatchDeferred.
+	return std::async(std::launch::deferred,
+		[](FieldResult<_Type>&& resultArg, ResolverParams&& paramsArg)
+	{
+		return _Result::convert(resultArg.get(), std::move(paramsArg));
+	}, std::move(result), std::move(params));
+}
+
+// Check if the outermost modifier makes a type nullable.
+template <TypeModifier _Modifier = TypeModifier::None, TypeModifier... _Other>
+constexpr bool isNullable()
+{
+	return TypeModifier::Nullable == _Modifier;
+}
 
 // Convert the result of a resolver function with chained type modifiers that add nullable or
 // list wrappers. This is the inverse of ModifiedArgument for output types instead of input types.
@@ -268,18 +767,25 @@ struct ModifiedResult
 {
 	// Peel off modifiers until we get to the underlying type.
 	using type = typename std::conditional<TypeModifier::Nullable == _Modifier,
-		typename std::conditional<std::is_base_of<Object, _Type>::value
+		typename std::conditional<(std::is_base_of<Object, _Type>::value || std::is_const<_Type>::value)
 			&& std::is_same<std::shared_ptr<_Type>, typename ModifiedResult<_Type, _Other...>::type>::value,
 			std::shared_ptr<_Type>,
 			std::unique_ptr<typename ModifiedResult<_Type, _Other...>::type>
 		>::type,
 		typename std::conditional<TypeModifier::List == _Modifier,
 			std::vector<typename ModifiedResult<_Type, _Other...>::type>,
-			typename std::conditional<std::is_base_of<Object, _Type>::value,
+			typename std::conditional<std::is_base_of<Object, _Type>::value || std::is_const<_Type>::value,
 				std::shared_ptr<_Type>,
 				_Type>::type
 		>::type
 	>::type;
+	using base_type = typename ModifiedResult<_Type>::base_type;
+
+	// Convert the FieldResult from a getter asynchronously.
+	static std::future<web::json::value> convert(FieldResult<type>&& result, ResolverParams&& params)
+	{
+		return convertFieldResult<ModifiedResult>(std::move(result), std::move(params));
+	}
 
 	// Peel off the none modifier. If it's included, it should always be last in the list.
 	static web::json::value convert(const typename std::conditional<TypeModifier::None == _Modifier, type, DisableNone>::type& result,
@@ -330,16 +836,236 @@ struct ModifiedResult
 	{
 		static_assert(TypeModifier::List == _Modifier, "this is the list version");
 
-		auto value = web::json::value::array(result.size());
+		// If the list is streamed, everything after the initial count is delivered in its own patch.
+		const size_t initialCount = getInitialCount(params, result.size());
 
-		std::transform(result.cbegin(), result.cend(), value.as_array().begin(),
-			[params](const typename ModifiedResult<_Type, _Other...>::type& element)
+		for (size_t i = initialCount; i < result.size(); ++i)
 		{
-			return ModifiedResult<_Type, _Other...>::convert(element, ResolverParams(params));
-		});
+			addStreamElement(params, i, streamElement(result[i], ResolverParams(params)));
+		}
+
+		// Nested lists aren't streamed, only the outermost one.
+		ResolverParams listParams(params);
+
+		listParams.stream = nullptr;
+
+		if (std::is_base_of<Object, _Type>::value)
+		{
+			if (shouldResolveInParallel(listParams, initialCount))
+			{
+				return resolveListInParallel(listParams, initialCount, isNullable<_Other...>(),
+					[&result](size_t index, ResolverParams&& elementParams)
+				{
+					return startElement(result[index], std::move(elementParams));
+				});
+			}
+
+			// Start every element in a list of objects before joining any of them, so a DataLoader sees
+			// the keys from the whole list at once.
+			ArenaAllocator<std::future<web::json::value>> allocator(params.operation.arena);
+			std::vector<std::future<web::json::value>, ArenaAllocator<std::future<web::json::value>>> elements(allocator);
+			std::vector<ResponsePath, ArenaAllocator<ResponsePath>> paths(allocator);
+
+			elements.reserve(initialCount);
+
+			if (params.path != nullptr)
+			{
+				paths.reserve(initialCount);
+			}
+
+			for (size_t i = 0; i < initialCount; ++i)
+			{
+				ResolverParams elementParams(listParams);
+
+				if (params.path != nullptr)
+				{
+					paths.push_back({ params.path, nullptr, i });
+					elementParams.path = &paths.back();
+				}
+
+				elements.push_back(startElement(result[i], std::move(elementParams)));
+			}
+
+			for (auto& element : elements)
+			{
+				element = dispatchDeferred(params.operation, std::move(element));
+			}
+
+			auto value = (params.operation.writer != nullptr)
+				? web::json::value::null()
+				: web::json::value::array(elements.size());
+
+			if (params.operation.writer != nullptr)
+			{
+				params.operation.writer->startArray();
+			}
+
+			try
+			{
+				for (size_t i = 0; i < elements.size(); ++i)
+				{
+					auto& element = elements[i];
+					auto elementValue = joinElement(params, paths.empty() ? nullptr : &paths[i],
+						[&params, &element]()
+					{
+						return joinDispatched(params.operation, element);
+					});
+
+					if (params.operation.writer == nullptr)
+					{
+						value[i] = std::move(elementValue);
+					}
+				}
+			}
+			catch (...)
+			{
+				// The elements which are still running refer to the paths, so let them finish first.
+				for (auto& element : elements)
+				{
+					waitDispatched(params.operation, element);
+				}
+
+				throw;
+			}
+
+			if (params.operation.writer != nullptr)
+			{
+				params.operation.writer->endArray();
+			}
+
+			return value;
+		}
+
+		auto value = (params.operation.writer != nullptr)
+			? web::json::value::null()
+			: web::json::value::array(initialCount);
+
+		if (params.operation.writer != nullptr)
+		{
+			params.operation.writer->startArray();
+		}
+
+		for (size_t i = 0; i < initialCount; ++i)
+		{
+			ResponsePath elementPath { params.path, nullptr, i };
+			ResolverParams elementParams(listParams);
+
+			if (params.path != nullptr)
+			{
+				elementParams.path = &elementPath;
+			}
+
+			auto elementValue = joinElement(params, elementParams.path,
+				[&result, &elementParams, i]()
+			{
+				return ModifiedResult<_Type, _Other...>::convert(result[i], std::move(elementParams));
+			});
+
+			if (params.operation.writer == nullptr)
+			{
+				value[i] = std::move(elementValue);
+			}
+		}
+
+		if (params.operation.writer != nullptr)
+		{
+			params.operation.writer->endArray();
+		}
 
 		return value;
 	}
+
+private:
+	// Get the value of an element in a list, and write it if there's a ResponseWriter. If it has an
+	// error and the elements are nullable, only that element becomes null.
+	template <typename _Join>
+	static web::json::value joinElement(const ResolverParams& params, const ResponsePath* path, _Join&& join)
+	{
+		const auto writer = params.operation.writer;
+		const auto valueCount = (writer != nullptr) ? writer->getValueCount() : 0;
+		const auto depth = (writer != nullptr) ? writer->getDepth() : 0;
+
+		try
+		{
+			auto value = join();
+
+			if (writer != nullptr)
+			{
+				writer->addResult(valueCount, value);
+			}
+
+			return value;
+		}
+		catch (const schema_exception& ex)
+		{
+			auto value = handleFieldError(params.operation, ex, isNullable<_Other...>(), nullptr, path);
+
+			if (writer != nullptr)
+			{
+				writer->unwind(depth);
+				writer->addResult(valueCount, value);
+			}
+
+			return value;
+		}
+	}
+
+	// Start the fields on an object in a list.
+	static std::future<web::json::value> startElement(const typename std::conditional<std::is_base_of<Object, _Type>::value,
+		std::shared_ptr<_Type>, DisableObject>::type& element, ResolverParams&& params)
+	{
+		if (!element
+			|| !params.selection)
+		{
+			std::promise<web::json::value> promise(std::allocator_arg, ArenaAllocator<web::json::value>(params.operation.arena));
+
+			promise.set_value(element
+				? web::json::value::object()
+				: web::json::value::null());
+
+			return promise.get_future();
+		}
+
+		return std::async(std::launch::deferred,
+			[](PendingFields&& pending)
+		{
+			return pending.join();
+		}, element->start(*params.selection, params.operation, params.path));
+	}
+
+	// Nested lists start their own elements when they're converted.
+	template <typename _Element>
+	static std::future<web::json::value> startElement(const _Element& element, ResolverParams&& params)
+	{
+		return std::async(std::launch::deferred,
+			[&element](ResolverParams&& paramsArg)
+		{
+			return ModifiedResult<_Type, _Other...>::convert(element, std::move(paramsArg));
+		}, std::move(params));
+	}
+	// Streamed objects aren't resolved until their patch is delivered.
+	static IncrementalResolver streamElement(const typename std::conditional<std::is_base_of<Object, _Type>::value,
+		std::shared_ptr<_Type>, DisableObject>::type& element, ResolverParams&&)
+	{
+		return [element](ResolverParams&& paramsArg)
+		{
+			return ModifiedResult<_Type, _Other...>::convert(element, std::move(paramsArg));
+		};
+	}
+
+	// Anything else is converted right away, since it might not be safe to copy.
+	template <typename _Element>
+	static IncrementalResolver streamElement(const _Element& element, ResolverParams&& params)
+	{
+		params.stream = nullptr;
+
+		auto value = ModifiedResult<_Type, _Other...>::convert(element, std::move(params));
+
+		return [value](ResolverParams&&)
+		{
+			return value;
+		};
+	}
 };
 
 // Handle the empty modifier list case.
@@ -349,6 +1075,13 @@ struct ModifiedResult<_Type, TypeModifier::None>
 	using type = typename std::conditional<std::is_base_of<Object, _Type>::value,
 		std::shared_ptr<_Type>,
 		_Type>::type;
+	using base_type = _Type;
+
+	// Convert the FieldResult from a getter asynchronously.
+	static std::future<web::json::value> convert(FieldResult<type>&& result, ResolverParams&& params)
+	{
+		return convertFieldResult<ModifiedResult>(std::move(result), std::move(params));
+	}
 
 	// Convert a subclass of Object and call that specialization.
 	static web::json::value convert(const typename std::conditional<!std::is_same<Object, _Type>::value && std::is_base_of<Object, _Type>::value,
@@ -364,6 +1097,61 @@ struct ModifiedResult<_Type, TypeModifier::None>
 		DisableNone, type>::type& result, ResolverParams&& params);
 };
 
+// Handle shared immutable values, e.g. ModifiedResult<const std::string>. The getter hands out a
+// std::shared_ptr<const T> to a value which the object already owns instead of copying it into a
+// new T for every field, and the value is only read when it's converted to JSON.
+template <typename _Type>
+struct ModifiedResult<const _Type, TypeModifier::None>
+{
+	using type = std::shared_ptr<const _Type>;
+	using base_type = const _Type;
+
+	// Convert the FieldResult from a getter asynchronously.
+	static std::future<web::json::value> convert(FieldResult<type>&& result, ResolverParams&& params)
+	{
+		return convertFieldResult<ModifiedResult>(std::move(result), std::move(params));
+	}
+
+	// Convert the shared value with the specialization for the underlying type.
+	static web::json::value convert(const type& result, ResolverParams&& params)
+	{
+		if (!result)
+		{
+			throw schema_exception({ "Missing value for non-nullable field" });
+		}
+
+		return ModifiedResult<_Type>::convert(*result, std::move(params));
+	}
+};
+
+// Handle shared immutable lists of objects, e.g. ModifiedResult<const std::vector<std::shared_ptr<Object>>>.
+// The getter hands out a list which the object built ahead of time instead of copying it into a
+// new std::vector for every field. The elements are still objects, so the list is resolved like
+// any other list of objects.
+template <typename _Object>
+struct ModifiedResult<const std::vector<std::shared_ptr<_Object>>, TypeModifier::None>
+{
+	using type = std::shared_ptr<const std::vector<std::shared_ptr<_Object>>>;
+	using base_type = _Object;
+
+	// Convert the FieldResult from a getter asynchronously.
+	static std::future<web::json::value> convert(FieldResult<type>&& result, ResolverParams&& params)
+	{
+		return convertFieldResult<ModifiedResult>(std::move(result), std::move(params));
+	}
+
+	// Convert the shared list with the list specialization for the element type.
+	static web::json::value convert(const type& result, ResolverParams&& params)
+	{
+		if (!result)
+		{
+			throw schema_exception({ "Missing value for non-nullable field" });
+		}
+
+		return ModifiedResult<_Object, TypeModifier::List>::convert(*result, std::move(params));
+	}
+};
+
 // Convenient type aliases for testing, generated code won't actually use these. These are also
 // the specializations which are implemented in the GraphQLService library, other specializations
 // for output types should be generated in schemagen.
@@ -372,44 +1160,256 @@ template <TypeModifier... _Modifiers> using FloatResult = ModifiedResult<double,
 template <TypeModifier... _Modifiers> using StringResult = ModifiedResult<std::string, _Modifiers...>;
 template <TypeModifier... _Modifiers> using BooleanResult = ModifiedResult<bool, _Modifiers...>;
 template <TypeModifier... _Modifiers> using IdResult = ModifiedResult<std::vector<unsigned char>, _Modifiers...>;
+template <TypeModifier... _Modifiers> using SharedStringResult = ModifiedResult<const std::string, _Modifiers...>;
+template <TypeModifier... _Modifiers> using SharedIdResult = ModifiedResult<const std::vector<unsigned char>, _Modifiers...>;
 template <TypeModifier... _Modifiers> using ScalarResult = ModifiedResult<web::json::value, _Modifiers...>;
 template <TypeModifier... _Modifiers> using ObjectResult = ModifiedResult<Object, _Modifiers...>;
 
+// All of the operation definitions in a request document, in the order they were declared.
+using OperationDefinitionList = std::vector<const ast::OperationDefinition*>;
+
+// OperationPlan is the compiled execution plan for a single operation. If the operation could not
+// be compiled, e.g. because it spreads an unknown fragment, the error is saved and thrown again
+// when someone tries to execute it.
+struct OperationPlan
+{
+	const ast::OperationDefinition* definition;
+	std::shared_ptr<const SelectionSetPlan> selection;
+	std::shared_ptr<const schema_exception> error;
+};
+
+using OperationPlanList = std::vector<OperationPlan>;
+
+class ValidationSchema;
+
+// ParsedDocument holds a request document along with the fragment definitions and the compiled
+// execution plans for each of the operations, so it can be executed many times without walking
+// the AST again. It either owns the AST or refers to one which the caller keeps alive.
+class ParsedDocument
+{
+public:
+	explicit ParsedDocument(std::unique_ptr<ast::Node>&& document, std::string query = {});
+	explicit ParsedDocument(const ast::Node& document);
+
+	// Parse the query text and throw a schema_exception if there are any syntax errors.
+	static std::shared_ptr<const ParsedDocument> parse(const std::string& query);
+
+	const ast::Node& getDocument() const;
+	const FragmentMap& getFragments() const;
+
+	// The query text if the document was parsed from one, otherwise it's empty.
+	const std::string& getQuery() const;
+
+	// Find the operation with the specified name, or the only operation if the name is empty.
+	const OperationPlan& getOperation(const std::string& operationName) const;
+
+	// Throw a schema_exception with all of the validation errors in the document. The result is
+	// remembered for the last schema it was validated against, so cached documents are only
+	// validated once.
+	void validate(const ValidationSchema& schema) const;
+
+private:
+	void compile();
+
+	std::unique_ptr<ast::Node> _ownedDocument;
+	const ast::Node& _document;
+	const std::string _query;
+	FragmentMap _fragments;
+	OperationPlanList _operations;
+
+	mutable std::mutex _validationMutex;
+	mutable size_t _validatedSchemaId = 0;
+	mutable std::shared_ptr<const schema_exception> _validationError;
+};
+
+class DocumentCache;
+class Executor;
+class Instrumentation;
+struct ComplexityLimits;
+class PersistedQueryStore;
+class ResultCache;
+
+// RequestOptions are the optional services a Request can share with other requests. If there's
+// an Executor, every operation resolves its fields on it, with at most maxConcurrentTasks of them
+// in flight at once (0 means no limit beyond the size of the Executor). If there's Instrumentation,
+// it can trace the resolvers in each operation and add its own extensions to the response. The
+// schema doesn't change once it's built, so if cacheIntrospection is set, queries which only
+// select introspection fields and don't declare any variables are resolved and serialized once.
+// Later requests with the same query text and operation name get the cached response. If there are
+// complexityLimits, operations which are too deep or too expensive are rejected before any of
+// their resolvers run. A PersistedQueryStore lets clients send the hash of a registered query
+// instead of the query text. If there's a ResultCache, the data for queries whose cache hints make
+// them cacheable is stored there, and it's returned without executing them again. Lists of objects
+// with at least parallelListThreshold elements are resolved in chunks on the Executor (0 means
+// every field gets its own task). If validateDocuments is set, documents are validated against
+// the schema first, and invalid ones are rejected with all of their errors before anything runs.
+// If there are Metrics, every request records how long it spent in each stage and updates the
+// counters there.
+struct RequestOptions
+{
+	std::shared_ptr<DocumentCache> documentCache;
+	std::shared_ptr<Executor> executor;
+	size_t maxConcurrentTasks;
+	std::shared_ptr<Instrumentation> instrumentation;
+	bool cacheIntrospection;
+	std::shared_ptr<const ComplexityLimits> complexityLimits;
+	std::shared_ptr<PersistedQueryStore> persistedQueries;
+	std::shared_ptr<ResultCache> resultCache;
+	size_t parallelListThreshold;
+	bool validateDocuments;
+	std::shared_ptr<Metrics> metrics;
+};
+
+// PersistedQuery identifies a query by the lowercase hex SHA-256 hash of its text. The query text
+// is optional, clients only send it after the hash wasn't found so it can be registered.
+struct PersistedQuery
+{
+	std::string sha256Hash;
+	std::string query;
+};
+
+// BatchOperation is one entry in a batch of operations for Request::resolveBatch. If the variables
+// aren't an object, the operation doesn't get any. Operations which set shareLoaders memoize and
+// batch their DataLoader keys together with the rest of the batch.
+struct BatchOperation
+{
+	std::string query;
+	std::string operationName;
+	web::json::value variables;
+	bool shareLoaders;
+};
+
 // Request scans the fragment definitions and finds the right operation definition to interpret
 // depending on the operation name (which might be empty for a single-operation document). It
-// also needs the values of hte request variables.
+// also needs the values of hte request variables. If it has a DocumentCache, it will reuse the
+// parsed documents for query text it has already seen.
 class Request : public std::enable_shared_from_this<Request>
 {
 public:
-	explicit Request(TypeMap&& operationTypes);
+	explicit Request(TypeMap&& operationTypes, RequestOptions options = {});
+
+	web::json::value resolve(const ast::Node& document, const std::string& operationName, const web::json::object& variables, std::launch launch = std::launch::deferred) const;
+	web::json::value resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, std::launch launch = std::launch::deferred) const;
+	web::json::value resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, std::launch launch = std::launch::deferred) const;
+
+	// Resolve the operation on behalf of a caller, e.g. a user ID. Responses with a private cache hint
+	// are only stored in the ResultCache under the caller's scope, public ones are shared by everyone.
+	web::json::value resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, const std::string& cacheScope, std::launch launch = std::launch::deferred) const;
+	web::json::value resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, const std::string& cacheScope, std::launch launch = std::launch::deferred) const;
+
+	// Write the response to a ResponseWriter as it's resolved. If there are any errors after part of
+	// the data has been written, the rest is filled in with null and followed by the errors.
+	void resolve(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const;
+	void resolve(const std::string& query, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const;
 
-	web::json::value resolve(const ast::Node& document, const std::string& operationName, const web::json::object& variables) const;
+	// Resolve a query from the PersistedQueryStore in the RequestOptions, which skips parsing and
+	// compiling the document entirely once it's registered. If the hash isn't registered and the
+	// query text is missing, the response has a PersistedQueryNotFound error.
+	web::json::value resolve(const PersistedQuery& query, const std::string& operationName, const web::json::object& variables, std::launch launch = std::launch::deferred) const;
+	void resolve(const PersistedQuery& query, const std::string& operationName, const web::json::object& variables, ResponseWriter& writer) const;
+
+	// Resolve the operation with incremental delivery for @defer and @stream. The callback gets the
+	// initial payload with everything which isn't deferred or streamed, followed by a patch for
+	// each deferred fragment or streamed list element. Every payload has hasNext, and it's false on
+	// the last one. Without this, @defer and @stream are ignored and everything is resolved at once.
+	using PayloadCallback = std::function<void(web::json::value&& payload)>;
+
+	void resolveIncremental(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, const PayloadCallback& callback, std::launch launch = std::launch::deferred) const;
+	void resolveIncremental(const std::string& query, const std::string& operationName, const web::json::object& variables, const PayloadCallback& callback, std::launch launch = std::launch::deferred) const;
+
+	// Resolve every operation in a batch and return the responses in the same order. Each distinct
+	// query is only parsed once, and if there's an Executor, every operation starts as a task on it
+	// so they run concurrently.
+	std::vector<web::json::value> resolveBatch(const std::vector<BatchOperation>& operations, std::launch launch = std::launch::deferred) const;
+
+	// Throw a schema_exception if validateDocuments is set in the RequestOptions and the document
+	// isn't valid for this schema.
+	void validate(const ParsedDocument& document) const;
+
+	const RequestOptions& getOptions() const;
+
+	// The number of introspection responses which are cached right now.
+	size_t getIntrospectionCacheSize() const;
 
 private:
+	// Keep a few responses around for different introspection queries, but don't let arbitrary
+	// documents grow the cache without bound. They're keyed on the operation name and the query
+	// text, so documents which are parsed again for every request still share them.
+	static constexpr size_t c_maxIntrospectionResponses = 16;
+
+	struct IntrospectionResponse
+	{
+		web::json::value data;
+		std::string serialized;
+	};
+
+	web::json::value execute(const ParsedDocument& document, const std::string& operationName, const web::json::object& variables, ResponseWriter* writer, std::launch launch, IncrementalScope* incremental = nullptr, const std::string& cacheScope = {}, DataLoaderScope* sharedLoaders = nullptr) const;
+
+	static std::string getResultCacheKey(const ParsedDocument& document, const std::string& operationName, const web::json::value& variables, const std::string& cacheScope);
+
+	std::shared_ptr<const ParsedDocument> getDocument(const std::string& query) const;
+	std::shared_ptr<const ParsedDocument> getDocument(const PersistedQuery& query) const;
+	static web::json::value getErrorResponse(const schema_exception& ex);
+	static void writeErrorResponse(const schema_exception& ex, ResponseWriter& writer);
+
+	static bool isIntrospection(const OperationPlan& plan);
+	std::shared_ptr<const IntrospectionResponse> resolveIntrospection(const ParsedDocument& document, const std::string& operationName, const OperationPlan& plan, Object& query, const web::json::object& variables) const;
+
+	// The ValidationSchema is built from an introspection query the first time it's needed. If that
+	// fails, documents aren't validated.
+	std::shared_ptr<const ValidationSchema> getValidationSchema() const;
+
 	TypeMap _operations;
+	RequestOptions _options;
+
+	mutable std::mutex _introspectionMutex;
+	mutable std::unordered_map<std::string, std::shared_ptr<const IntrospectionResponse>> _introspectionResponses;
+
+	mutable std::mutex _validationMutex;
+	mutable bool _loadedValidationSchema = false;
+	mutable std::shared_ptr<const ValidationSchema> _validationSchema;
 };
 
-// SelectionVisitor visits the AST and resolves a field or fragment, unless its skipped by
-// a directive or type condition.
-class SelectionVisitor : public ast::visitor::AstVisitor
+// SelectionPlanVisitor visits the AST and compiles a selection set into a flat list of fields,
+// expanding fragment spreads and inline fragments along the way. Directives and arguments which
+// don't depend on variables are evaluated once here instead of on every request. Spreading the
+// same fragment several times at every level grows exponentially, so there's a cap on the total
+// number of fields in an operation after all of the fragments are expanded.
+class SelectionPlanVisitor : public ast::visitor::AstVisitor
 {
 public:
-	SelectionVisitor(const FragmentMap& fragments, const web::json::object& variables, const TypeNames& typeNames, const ResolverMap& resolvers);
+	static constexpr size_t c_maxFieldCount = 100000;
+
+	explicit SelectionPlanVisitor(const FragmentMap& fragments);
 
-	web::json::value getValues();
+	std::shared_ptr<const SelectionSetPlan> getPlan();
 
 	bool visitField(const ast::Field& field) override;
 	bool visitFragmentSpread(const ast::FragmentSpread &fragmentSpread) override;
 	bool visitInlineFragment(const ast::InlineFragment &inlineFragment) override;
 
 private:
-	bool shouldSkip(const std::vector<std::unique_ptr<ast::Directive>>* directives) const;
+	SelectionPlanVisitor(const FragmentMap& fragments, std::vector<std::string>& fragmentStack, size_t& fieldCount);
+
+	// Fragments with a @defer directive are compiled into a DeferredPlan, anything else is merged
+	// into this selection set.
+	void visitFragment(const std::vector<std::unique_ptr<ast::Directive>>* directives, const ast::SelectionSet& selection);
+	static std::shared_ptr<const StreamPlan> getStream(const std::vector<std::unique_ptr<ast::Directive>>* directives);
+	static bool findDirective(const std::vector<std::unique_ptr<ast::Directive>>* directives, const char* name,
+		std::initializer_list<const char*> argumentNames, std::string& label, const ast::Value*& condition, const ast::Value** initialCount);
+
+	// Returns true if a constant directive always skips this selection, otherwise it adds any
+	// directives which depend on variables to the conditions.
+	static bool shouldSkip(const std::vector<std::unique_ptr<ast::Directive>>* directives, DirectiveConditions& conditions);
 
 	const FragmentMap& _fragments;
-	const web::json::object& _variables;
-	const TypeNames& _typeNames;
-	const ResolverMap& _resolvers;
-	web::json::value _values;
+	std::vector<std::string> _ownFragmentStack;
+	std::vector<std::string>& _fragmentStack;
+	size_t _ownFieldCount = 0;
+	size_t& _fieldCount;
+	std::vector<std::string> _typeConditions;
+	DirectiveConditions _fragmentConditions;
+	std::shared_ptr<SelectionSetPlan> _plan;
 };
 
 // ValueVisitor visits the AST and builds a JSON representation of any value
@@ -436,6 +1436,25 @@ private:
 	web::json::value _value;
 };
 
+// Pick out the variables which the operation declares from the request, and fill in the default
+// values for any which are missing.
+web::json::value getOperationVariables(const ast::OperationDefinition& operationDefinition, const web::json::object& variables);
+
+// VariableReferenceVisitor visits the AST and checks if a value references any variables, or if
+// it's a constant which we can convert to JSON ahead of time.
+class VariableReferenceVisitor : public ast::visitor::AstVisitor
+{
+public:
+	VariableReferenceVisitor();
+
+	bool hasVariables() const;
+
+	bool visitVariable(const ast::Variable& variable) override;
+
+private:
+	bool _hasVariables = false;
+};
+
 // FragmentDefinitionVisitor visits the AST and collects all of the fragment
 // definitions in the document.
 class FragmentDefinitionVisitor : public ast::visitor::AstVisitor
@@ -451,23 +1470,19 @@ private:
 	FragmentMap _fragments;
 };
 
-// OperationDefinitionVisitor visits the AST and executes the one with the specified
-// operation name.
+// OperationDefinitionVisitor visits the AST and collects all of the operation
+// definitions in the document.
 class OperationDefinitionVisitor : public ast::visitor::AstVisitor
 {
 public:
-	OperationDefinitionVisitor(const TypeMap& operations, const std::string& operationName, const web::json::object& variables, const FragmentMap& fragments);
+	OperationDefinitionVisitor();
 
-	web::json::value getValue();
+	OperationDefinitionList getOperations();
 
 	bool visitOperationDefinition(const ast::OperationDefinition& operationDefinition) override;
 
 private:
-	const TypeMap& _operations;
-	const std::string& _operationName;
-	const web::json::object& _variables;
-	const FragmentMap& _fragments;
-	web::json::value _result;
+	OperationDefinitionList _operations;
 };
 
 } /* namespace service */
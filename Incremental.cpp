@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Incremental.h"
+
+#include <algorithm>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+IncrementalScope::IncrementalScope(PayloadCallback callback)
+	: _callback(std::move(callback))
+	, _arguments(web::json::value::object())
+	, _basePath(web::json::value::array())
+{
+}
+
+void IncrementalScope::defer(const ResponsePath* path, const std::string& label, const SelectionSetPlan* selection, IncrementalResolver&& resolver)
+{
+	push(path, label, false, selection, std::move(resolver));
+}
+
+void IncrementalScope::stream(const ResponsePath* path, const std::string& label, const SelectionSetPlan* selection, IncrementalResolver&& resolver)
+{
+	push(path, label, true, selection, std::move(resolver));
+}
+
+void IncrementalScope::deliver(web::json::value&& data, const OperationParams& params)
+{
+	auto initial = web::json::value::object(true);
+
+	initial[_XPLATSTR("data")] = std::move(data);
+
+	// Each payload has the errors from the fields which were resolved for it.
+	if (params.errors != nullptr
+		&& !params.errors->empty())
+	{
+		initial[_XPLATSTR("errors")] = params.errors->takeErrors();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_started = true;
+		initial[_XPLATSTR("hasNext")] = web::json::value::boolean(!_patches.empty());
+	}
+
+	_callback(std::move(initial));
+
+	Patch patch;
+
+	while (pop(patch))
+	{
+		const auto key = patch.stream
+			? _XPLATSTR("items")
+			: _XPLATSTR("data");
+		auto payload = web::json::value::object(true);
+
+		try
+		{
+			auto value = patch.resolver({ _arguments.as_object(), patch.selection, params, nullptr, nullptr });
+
+			if (patch.stream)
+			{
+				payload[key] = web::json::value::array({ std::move(value) });
+			}
+			else
+			{
+				payload[key] = std::move(value);
+			}
+
+			if (params.errors != nullptr
+				&& !params.errors->empty())
+			{
+				payload[_XPLATSTR("errors")] = params.errors->takeErrors();
+			}
+		}
+		catch (const schema_exception& ex)
+		{
+			payload[key] = web::json::value::null();
+			payload[_XPLATSTR("errors")] = (params.errors != nullptr)
+				? params.errors->takeErrors(&ex)
+				: ex.getErrors();
+		}
+
+		payload[_XPLATSTR("path")] = std::move(patch.path);
+
+		if (!patch.label.empty())
+		{
+			payload[_XPLATSTR("label")] = web::json::value::string(utility::conversions::to_string_t(patch.label));
+		}
+
+		{
+			// Resolving the patch may have queued more of them.
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			payload[_XPLATSTR("hasNext")] = web::json::value::boolean(!_patches.empty());
+		}
+
+		_callback(std::move(payload));
+	}
+}
+
+bool IncrementalScope::hasStarted() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _started;
+}
+
+void IncrementalScope::push(const ResponsePath* path, const std::string& label, bool stream, const SelectionSetPlan* selection, IncrementalResolver&& resolver)
+{
+	auto relativePath = (path != nullptr)
+		? path->toJson()
+		: web::json::value::array();
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& relativeSegments = relativePath.as_array();
+	const auto& baseSegments = _basePath.as_array();
+	auto fullPath = web::json::value::array(baseSegments.size() + relativeSegments.size());
+
+	std::move(relativeSegments.begin(), relativeSegments.end(),
+		std::copy(baseSegments.begin(), baseSegments.end(), fullPath.as_array().begin()));
+
+	_patches.push_back({ std::move(fullPath), label, stream, selection, std::move(resolver) });
+}
+
+bool IncrementalScope::pop(Patch& patch)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (_patches.empty())
+	{
+		return false;
+	}
+
+	patch = std::move(_patches.front());
+	_patches.pop_front();
+	_basePath = patch.path;
+
+	return true;
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
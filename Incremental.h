@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <deque>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// IncrementalScope collects the deferred fragments and streamed list elements in an operation
+// which is resolved with Request::resolveIncremental. The initial payload is delivered as soon as
+// everything else is resolved, and then each of the patches is resolved and delivered in the
+// order they were queued. Patches may queue more patches of their own. Fields running on an
+// Executor can queue patches from several threads at once.
+class IncrementalScope
+{
+public:
+	using PayloadCallback = std::function<void(web::json::value&& payload)>;
+
+	explicit IncrementalScope(PayloadCallback callback);
+
+	// Queue a deferred fragment, which resolves to an object with the fields in the selection set.
+	// The path is relative to the patch which is being resolved, or to the root of the response.
+	void defer(const ResponsePath* path, const std::string& label, const SelectionSetPlan* selection, IncrementalResolver&& resolver);
+
+	// Queue a single element from a streamed list, the last segment in the path is its index.
+	void stream(const ResponsePath* path, const std::string& label, const SelectionSetPlan* selection, IncrementalResolver&& resolver);
+
+	// Deliver the initial payload, then resolve and deliver each of the patches until there are none
+	// left. The last payload has hasNext set to false.
+	void deliver(web::json::value&& data, const OperationParams& params);
+
+	// Returns true once the initial payload has been delivered.
+	bool hasStarted() const;
+
+private:
+	struct Patch
+	{
+		web::json::value path;
+		std::string label;
+		bool stream;
+		const SelectionSetPlan* selection;
+		IncrementalResolver resolver;
+	};
+
+	void push(const ResponsePath* path, const std::string& label, bool stream, const SelectionSetPlan* selection, IncrementalResolver&& resolver);
+	bool pop(Patch& patch);
+
+	const PayloadCallback _callback;
+	const web::json::value _arguments;
+
+	mutable std::mutex _mutex;
+	std::deque<Patch> _patches;
+	web::json::value _basePath;
+	bool _started = false;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -8,6 +8,8 @@ namespace graphql {
 namespace introspection {
 
 Schema::Schema()
+	: _types(std::make_shared<std::vector<std::shared_ptr<object::__Type>>>())
+	, _directives(std::make_shared<const std::vector<std::shared_ptr<object::__Directive>>>())
 {
 	AddType("Int", std::make_shared<ScalarType>("Int"));
 	AddType("Float", std::make_shared<ScalarType>("Float"));
@@ -33,8 +35,8 @@ void Schema::AddSubscriptionType(std::shared_ptr<ObjectType> subscription)
 
 void Schema::AddType(std::string name, std::shared_ptr<object::__Type> type)
 {
-	_typeMap[name] = _types.size();
-	_types.push_back({ std::move(name), std::move(type) });
+	_typeMap[std::move(name)] = _types->size();
+	_types->push_back(std::move(type));
 }
 
 std::shared_ptr<object::__Type> Schema::LookupType(const std::string& name) const
@@ -46,271 +48,237 @@ std::shared_ptr<object::__Type> Schema::LookupType(const std::string& name) cons
 		return nullptr;
 	}
 
-	return _types[itr->second].second;
+	return (*_types)[itr->second];
 }
 
-std::vector<std::shared_ptr<object::__Type>> Schema::getTypes() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> Schema::getTypes(service::FieldParams&& /*params*/) const
 {
-	std::vector<std::shared_ptr<object::__Type>> result(_types.size());
-
-	std::transform(_types.cbegin(), _types.cend(), result.begin(),
-		[](const std::pair<std::string, std::shared_ptr<object::__Type>>& namedType)
-	{
-		return namedType.second;
-	});
-
-	return result;
+	return _types;
 }
 
-std::shared_ptr<object::__Type> Schema::getQueryType() const
+service::FieldResult<std::shared_ptr<object::__Type>> Schema::getQueryType(service::FieldParams&& /*params*/) const
 {
 	return _query;
 }
 
-std::shared_ptr<object::__Type> Schema::getMutationType() const
+service::FieldResult<std::shared_ptr<object::__Type>> Schema::getMutationType(service::FieldParams&& /*params*/) const
 {
 	return _mutation;
 }
 
-std::shared_ptr<object::__Type> Schema::getSubscriptionType() const
+service::FieldResult<std::shared_ptr<object::__Type>> Schema::getSubscriptionType(service::FieldParams&& /*params*/) const
 {
 	return _subscription;
 }
 
-std::vector<std::shared_ptr<object::__Directive>> Schema::getDirectives() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Directive>>>> Schema::getDirectives(service::FieldParams&& /*params*/) const
 {
-	return {};
+	return _directives;
 }
 
-std::unique_ptr<std::string> BaseType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> BaseType::getName(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::string> BaseType::getDescription() const
+service::FieldResult<std::shared_ptr<const std::string>> BaseType::getDescription(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> BaseType::getFields(std::unique_ptr<bool>&& /*includeDeprecated*/) const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> BaseType::getFields(service::FieldParams&& /*params*/, std::unique_ptr<bool>&& /*includeDeprecated*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> BaseType::getInterfaces() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> BaseType::getInterfaces(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> BaseType::getPossibleTypes() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> BaseType::getPossibleTypes(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__EnumValue>>> BaseType::getEnumValues(std::unique_ptr<bool>&& /*includeDeprecated*/) const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__EnumValue>>>> BaseType::getEnumValues(service::FieldParams&& /*params*/, std::unique_ptr<bool>&& /*includeDeprecated*/) const
 {
 	return nullptr;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__InputValue>>> BaseType::getInputFields() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> BaseType::getInputFields(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::shared_ptr<object::__Type> BaseType::getOfType() const
+service::FieldResult<std::shared_ptr<object::__Type>> BaseType::getOfType(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
 ScalarType::ScalarType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
 {
 }
 
-__TypeKind ScalarType::getKind() const
+service::FieldResult<__TypeKind> ScalarType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::SCALAR;
 }
 
-std::unique_ptr<std::string> ScalarType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> ScalarType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
 ObjectType::ObjectType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _interfaces(std::make_shared<const std::vector<std::shared_ptr<object::__Type>>>())
+	, _fields(std::make_shared<const std::vector<std::shared_ptr<object::__Field>>>())
 {
 }
 
 void ObjectType::AddInterfaces(std::vector<std::shared_ptr<InterfaceType>> interfaces)
 {
-	_interfaces = std::move(interfaces);
+	_interfaces = std::make_shared<const std::vector<std::shared_ptr<object::__Type>>>(interfaces.cbegin(), interfaces.cend());
 }
 
 void ObjectType::AddFields(std::vector<std::shared_ptr<Field>> fields)
 {
-	_fields = std::move(fields);
+	_fields = std::make_shared<const std::vector<std::shared_ptr<object::__Field>>>(fields.cbegin(), fields.cend());
 }
 
-__TypeKind ObjectType::getKind() const
+service::FieldResult<__TypeKind> ObjectType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::OBJECT;
 }
 
-std::unique_ptr<std::string> ObjectType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> ObjectType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> ObjectType::getFields(std::unique_ptr<bool>&& /*includeDeprecated*/) const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> ObjectType::getFields(service::FieldParams&& /*params*/, std::unique_ptr<bool>&& /*includeDeprecated*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> result(new std::vector<std::shared_ptr<object::__Field>>(_fields.size()));
-
-	std::copy(_fields.cbegin(), _fields.cend(), result->begin());
-
-	return result;
+	return _fields;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> ObjectType::getInterfaces() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> ObjectType::getInterfaces(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> result(new std::vector<std::shared_ptr<object::__Type>>(_interfaces.size()));
-
-	std::copy(_interfaces.cbegin(), _interfaces.cend(), result->begin());
-
-	return result;
+	return _interfaces;
 }
 
 InterfaceType::InterfaceType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _fields(std::make_shared<const std::vector<std::shared_ptr<object::__Field>>>())
 {
 }
 
 void InterfaceType::AddFields(std::vector<std::shared_ptr<Field>> fields)
 {
-	_fields = std::move(fields);
+	_fields = std::make_shared<const std::vector<std::shared_ptr<object::__Field>>>(fields.cbegin(), fields.cend());
 }
 
-__TypeKind InterfaceType::getKind() const
+service::FieldResult<__TypeKind> InterfaceType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::INTERFACE;
 }
 
-std::unique_ptr<std::string> InterfaceType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> InterfaceType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> InterfaceType::getFields(std::unique_ptr<bool>&& /*includeDeprecated*/) const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> InterfaceType::getFields(service::FieldParams&& /*params*/, std::unique_ptr<bool>&& /*includeDeprecated*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> result(new std::vector<std::shared_ptr<object::__Field>>(_fields.size()));
-
-	std::copy(_fields.cbegin(), _fields.cend(), result->begin());
-
-	return result;
+	return _fields;
 }
 
 UnionType::UnionType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _possibleTypes(std::make_shared<const std::vector<std::shared_ptr<object::__Type>>>())
 {
 }
 
 void UnionType::AddPossibleTypes(std::vector<std::shared_ptr<object::__Type>> possibleTypes)
 {
-	_possibleTypes = std::move(possibleTypes);
+	_possibleTypes = std::make_shared<const std::vector<std::shared_ptr<object::__Type>>>(std::move(possibleTypes));
 }
 
-__TypeKind UnionType::getKind() const
+service::FieldResult<__TypeKind> UnionType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::UNION;
 }
 
-std::unique_ptr<std::string> UnionType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> UnionType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> UnionType::getPossibleTypes() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> UnionType::getPossibleTypes(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> result(new std::vector<std::shared_ptr<object::__Type>>(_possibleTypes.size()));
-
-	std::copy(_possibleTypes.cbegin(), _possibleTypes.cend(), result->begin());
-
-	return result;
+	return _possibleTypes;
 }
 
 EnumType::EnumType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _enumValues(std::make_shared<const std::vector<std::shared_ptr<object::__EnumValue>>>())
 {
 }
 
 void EnumType::AddEnumValues(std::vector<std::string> enumValues)
 {
-	_enumValues.reserve(_enumValues.size() + enumValues.size());
+	std::vector<std::shared_ptr<object::__EnumValue>> values(_enumValues->cbegin(), _enumValues->cend());
+
+	values.reserve(values.size() + enumValues.size());
 
 	for (auto& value : enumValues)
 	{
-		_enumValues.push_back(std::make_shared<EnumValue>(std::move(value)));
+		values.push_back(std::make_shared<EnumValue>(std::move(value)));
 	}
+
+	_enumValues = std::make_shared<const std::vector<std::shared_ptr<object::__EnumValue>>>(std::move(values));
 }
 
-__TypeKind EnumType::getKind() const
+service::FieldResult<__TypeKind> EnumType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::ENUM;
 }
 
-std::unique_ptr<std::string> EnumType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> EnumType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__EnumValue>>> EnumType::getEnumValues(std::unique_ptr<bool>&& /*includeDeprecated*/) const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__EnumValue>>>> EnumType::getEnumValues(service::FieldParams&& /*params*/, std::unique_ptr<bool>&& /*includeDeprecated*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__EnumValue>>> result(new std::vector<std::shared_ptr<object::__EnumValue>>(_enumValues.size()));
-
-	std::copy(_enumValues.cbegin(), _enumValues.cend(), result->begin());
-
-	return result;
+	return _enumValues;
 }
 
 InputObjectType::InputObjectType(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _inputValues(std::make_shared<const std::vector<std::shared_ptr<object::__InputValue>>>())
 {
 }
 
 void InputObjectType::AddInputValues(std::vector<std::shared_ptr<InputValue>> inputValues)
 {
-	_inputValues = std::move(inputValues);
+	_inputValues = std::make_shared<const std::vector<std::shared_ptr<object::__InputValue>>>(inputValues.cbegin(), inputValues.cend());
 }
 
-__TypeKind InputObjectType::getKind() const
+service::FieldResult<__TypeKind> InputObjectType::getKind(service::FieldParams&& /*params*/) const
 {
 	return __TypeKind::INPUT_OBJECT;
 }
 
-std::unique_ptr<std::string> InputObjectType::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> InputObjectType::getName(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_name));
-
-	return result;
+	return _name;
 }
 
-std::unique_ptr<std::vector<std::shared_ptr<object::__InputValue>>> InputObjectType::getInputFields() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> InputObjectType::getInputFields(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::vector<std::shared_ptr<object::__InputValue>>> result(new std::vector<std::shared_ptr<object::__InputValue>>(_inputValues.size()));
-
-	std::copy(_inputValues.cbegin(), _inputValues.cend(), result->begin());
-
-	return result;
+	return _inputValues;
 }
 
 WrapperType::WrapperType(__TypeKind kind, std::shared_ptr<object::__Type> ofType)
@@ -319,84 +287,78 @@ WrapperType::WrapperType(__TypeKind kind, std::shared_ptr<object::__Type> ofType
 {
 }
 
-__TypeKind WrapperType::getKind() const
+service::FieldResult<__TypeKind> WrapperType::getKind(service::FieldParams&& /*params*/) const
 {
 	return _kind;
 }
 
-std::shared_ptr<object::__Type> WrapperType::getOfType() const
+service::FieldResult<std::shared_ptr<object::__Type>> WrapperType::getOfType(service::FieldParams&& /*params*/) const
 {
 	return _ofType;
 }
 
 Field::Field(std::string name, std::vector<std::shared_ptr<InputValue>> args, std::shared_ptr<object::__Type> type)
-	: _name(std::move(name))
-	, _args(std::move(args))
+	: _name(std::make_shared<const std::string>(std::move(name)))
+	, _args(std::make_shared<const std::vector<std::shared_ptr<object::__InputValue>>>(args.cbegin(), args.cend()))
 	, _type(std::move(type))
 {
 }
 
-std::string Field::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> Field::getName(service::FieldParams&& /*params*/) const
 {
 	return _name;
 }
 
-std::unique_ptr<std::string> Field::getDescription() const
+service::FieldResult<std::shared_ptr<const std::string>> Field::getDescription(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::vector<std::shared_ptr<object::__InputValue>> Field::getArgs() const
+service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> Field::getArgs(service::FieldParams&& /*params*/) const
 {
-	std::vector<std::shared_ptr<object::__InputValue>> result(_args.size());
-
-	std::copy(_args.cbegin(), _args.cend(), result.begin());
-
-	return result;
+	return _args;
 }
 
-std::shared_ptr<object::__Type> Field::getType() const
+service::FieldResult<std::shared_ptr<object::__Type>> Field::getType(service::FieldParams&& /*params*/) const
 {
 	return _type;
 }
 
-bool Field::getIsDeprecated() const
+service::FieldResult<bool> Field::getIsDeprecated(service::FieldParams&& /*params*/) const
 {
 	return false;
 }
 
-std::unique_ptr<std::string> Field::getDeprecationReason() const
+service::FieldResult<std::shared_ptr<const std::string>> Field::getDeprecationReason(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
 InputValue::InputValue(std::string name, std::shared_ptr<object::__Type> type, const web::json::value& defaultValue)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
 	, _type(std::move(type))
-	, _defaultValue(formatDefaultValue(defaultValue))
+	, _defaultValue(std::make_shared<const std::string>(formatDefaultValue(defaultValue)))
 {
 }
 
-std::string InputValue::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> InputValue::getName(service::FieldParams&& /*params*/) const
 {
 	return _name;
 }
 
-std::unique_ptr<std::string> InputValue::getDescription() const
+service::FieldResult<std::shared_ptr<const std::string>> InputValue::getDescription(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-std::shared_ptr<object::__Type> InputValue::getType() const
+service::FieldResult<std::shared_ptr<object::__Type>> InputValue::getType(service::FieldParams&& /*params*/) const
 {
 	return _type;
 }
 
-std::unique_ptr<std::string> InputValue::getDefaultValue() const
+service::FieldResult<std::shared_ptr<const std::string>> InputValue::getDefaultValue(service::FieldParams&& /*params*/) const
 {
-	std::unique_ptr<std::string> result(new std::string(_defaultValue));
-
-	return result;
+	return _defaultValue;
 }
 
 std::string InputValue::formatDefaultValue(const web::json::value& defaultValue) noexcept
@@ -452,26 +414,26 @@ std::string InputValue::formatDefaultValue(const web::json::value& defaultValue)
 }
 
 EnumValue::EnumValue(std::string name)
-	: _name(std::move(name))
+	: _name(std::make_shared<const std::string>(std::move(name)))
 {
 }
 
-std::string EnumValue::getName() const
+service::FieldResult<std::shared_ptr<const std::string>> EnumValue::getName(service::FieldParams&& /*params*/) const
 {
 	return _name;
 }
 
-std::unique_ptr<std::string> EnumValue::getDescription() const
+service::FieldResult<std::shared_ptr<const std::string>> EnumValue::getDescription(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
 
-bool EnumValue::getIsDeprecated() const
+service::FieldResult<bool> EnumValue::getIsDeprecated(service::FieldParams&& /*params*/) const
 {
 	return false;
 }
 
-std::unique_ptr<std::string> EnumValue::getDeprecationReason() const
+service::FieldResult<std::shared_ptr<const std::string>> EnumValue::getDeprecationReason(service::FieldParams&& /*params*/) const
 {
 	return nullptr;
 }
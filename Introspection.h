@@ -34,32 +34,33 @@ public:
 	std::shared_ptr<object::__Type> LookupType(const std::string& name) const;
 
 	// Accessors
-	std::vector<std::shared_ptr<object::__Type>> getTypes() const override;
-	std::shared_ptr<object::__Type> getQueryType() const override;
-	std::shared_ptr<object::__Type> getMutationType() const override;
-	std::shared_ptr<object::__Type> getSubscriptionType() const override;
-	std::vector<std::shared_ptr<object::__Directive>> getDirectives() const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> getTypes(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getQueryType(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getMutationType(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getSubscriptionType(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Directive>>>> getDirectives(service::FieldParams&& params) const override;
 
 private:
 	std::shared_ptr<ObjectType> _query;
 	std::shared_ptr<ObjectType> _mutation;
 	std::shared_ptr<ObjectType> _subscription;
 	std::unordered_map<std::string, size_t> _typeMap;
-	std::vector<std::pair<std::string, std::shared_ptr<object::__Type>>> _types;
+	const std::shared_ptr<std::vector<std::shared_ptr<object::__Type>>> _types;
+	const std::shared_ptr<const std::vector<std::shared_ptr<object::__Directive>>> _directives;
 };
 
 class BaseType : public object::__Type
 {
 public:
 	// Accessors
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::string> getDescription() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> getFields(std::unique_ptr<bool>&& includeDeprecated) const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> getInterfaces() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> getPossibleTypes() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__EnumValue>>> getEnumValues(std::unique_ptr<bool>&& includeDeprecated) const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__InputValue>>> getInputFields() const override;
-	std::shared_ptr<object::__Type> getOfType() const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> getFields(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> getInterfaces(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> getPossibleTypes(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__EnumValue>>>> getEnumValues(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> getInputFields(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getOfType(service::FieldParams&& params) const override;
 
 protected:
 	BaseType() = default;
@@ -71,11 +72,11 @@ public:
 	explicit ScalarType(std::string name);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 };
 
 class ObjectType : public BaseType
@@ -87,16 +88,16 @@ public:
 	void AddFields(std::vector<std::shared_ptr<Field>> fields);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> getFields(std::unique_ptr<bool>&& includeDeprecated) const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> getInterfaces() const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> getFields(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> getInterfaces(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 	
-	std::vector<std::shared_ptr<InterfaceType>> _interfaces;
-	std::vector<std::shared_ptr<Field>> _fields;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>> _interfaces;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>> _fields;
 };
 
 class InterfaceType : public BaseType
@@ -107,14 +108,14 @@ public:
 	void AddFields(std::vector<std::shared_ptr<Field>> fields);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Field>>> getFields(std::unique_ptr<bool>&& includeDeprecated) const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>>> getFields(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 
-	std::vector<std::shared_ptr<Field>> _fields;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__Field>>> _fields;
 };
 
 class UnionType : public BaseType
@@ -125,14 +126,14 @@ public:
 	void AddPossibleTypes(std::vector<std::shared_ptr<object::__Type>> possibleTypes);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__Type>>> getPossibleTypes() const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>>> getPossibleTypes(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 
-	std::vector<std::shared_ptr<object::__Type>> _possibleTypes;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__Type>>> _possibleTypes;
 };
 
 class EnumType : public BaseType
@@ -143,14 +144,14 @@ public:
 	void AddEnumValues(std::vector<std::string> enumValues);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__EnumValue>>> getEnumValues(std::unique_ptr<bool>&& includeDeprecated) const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__EnumValue>>>> getEnumValues(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 	
-	std::vector<std::shared_ptr<object::__EnumValue>> _enumValues;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__EnumValue>>> _enumValues;
 };
 
 class InputObjectType : public BaseType
@@ -161,14 +162,14 @@ public:
 	void AddInputValues(std::vector<std::shared_ptr<InputValue>> inputValues);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::unique_ptr<std::string> getName() const override;
-	std::unique_ptr<std::vector<std::shared_ptr<object::__InputValue>>> getInputFields() const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> getInputFields(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 	
-	std::vector<std::shared_ptr<InputValue>> _inputValues;
+	std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>> _inputValues;
 };
 
 class WrapperType : public BaseType
@@ -177,8 +178,8 @@ public:
 	explicit WrapperType(__TypeKind kind, std::shared_ptr<object::__Type> ofType);
 
 	// Accessors
-	__TypeKind getKind() const override;
-	std::shared_ptr<object::__Type> getOfType() const override;
+	service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getOfType(service::FieldParams&& params) const override;
 
 private:
 	const __TypeKind _kind;
@@ -191,16 +192,16 @@ public:
 	explicit Field(std::string name, std::vector<std::shared_ptr<InputValue>> args, std::shared_ptr<object::__Type> type);
 
 	// Accessors
-	std::string getName() const override;
-	std::unique_ptr<std::string> getDescription() const override;
-	std::vector<std::shared_ptr<object::__InputValue>> getArgs() const override;
-	std::shared_ptr<object::__Type> getType() const override;
-	bool getIsDeprecated() const override;
-	std::unique_ptr<std::string> getDeprecationReason() const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>>> getArgs(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getType(service::FieldParams&& params) const override;
+	service::FieldResult<bool> getIsDeprecated(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDeprecationReason(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
-	const std::vector<std::shared_ptr<InputValue>> _args;
+	const std::shared_ptr<const std::string> _name;
+	const std::shared_ptr<const std::vector<std::shared_ptr<object::__InputValue>>> _args;
 	const std::shared_ptr<object::__Type> _type;
 };
 
@@ -210,17 +211,17 @@ public:
 	explicit InputValue(std::string name, std::shared_ptr<object::__Type> type, const web::json::value& defaultValue);
 
 	// Accessors
-	std::string getName() const override;
-	std::unique_ptr<std::string> getDescription() const override;
-	std::shared_ptr<object::__Type> getType() const override;
-	std::unique_ptr<std::string> getDefaultValue() const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<object::__Type>> getType(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDefaultValue(service::FieldParams&& params) const override;
 
 private:
 	static std::string formatDefaultValue(const web::json::value& defaultValue) noexcept;
 
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 	const std::shared_ptr<object::__Type> _type;
-	const std::string _defaultValue;
+	const std::shared_ptr<const std::string> _defaultValue;
 };
 
 class EnumValue : public object::__EnumValue
@@ -229,13 +230,13 @@ public:
 	explicit EnumValue(std::string name);
 
 	// Accessors
-	std::string getName() const override;
-	std::unique_ptr<std::string> getDescription() const override;
-	bool getIsDeprecated() const override;
-	std::unique_ptr<std::string> getDeprecationReason() const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const override;
+	service::FieldResult<bool> getIsDeprecated(service::FieldParams&& params) const override;
+	service::FieldResult<std::shared_ptr<const std::string>> getDeprecationReason(service::FieldParams&& params) const override;
 
 private:
-	const std::string _name;
+	const std::shared_ptr<const std::string> _name;
 };
 
 } /* namespace facebook */
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Lazy loads a value the first time it's needed, and it's safe to share between threads. If
+// several of them ask for it at once, the loader only runs on one of them and the others wait on
+// a mutex which belongs to this Lazy alone. Once the value is loaded, get is a single atomic load
+// which never takes the mutex. If the loader throws, the exception goes to the caller and the
+// next call tries again.
+template <typename _Value>
+class Lazy
+{
+public:
+	using Loader = std::function<_Value()>;
+
+	explicit Lazy(Loader&& loader)
+		: _loader(std::move(loader))
+	{
+	}
+
+	~Lazy()
+	{
+		delete _value.load(std::memory_order_relaxed);
+	}
+
+	const _Value& get() const
+	{
+		auto value = _value.load(std::memory_order_acquire);
+
+		if (value == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			value = _value.load(std::memory_order_relaxed);
+
+			if (value == nullptr)
+			{
+				value = new _Value(_loader());
+
+				// Release anything the loader captured, it won't be called again.
+				_loader = nullptr;
+				_value.store(value, std::memory_order_release);
+			}
+		}
+
+		return *value;
+	}
+
+	bool isLoaded() const
+	{
+		return _value.load(std::memory_order_acquire) != nullptr;
+	}
+
+private:
+	mutable std::mutex _mutex;
+	mutable Loader _loader;
+	mutable std::atomic<const _Value*> _value { nullptr };
+};
+
+// LazyMap loads and caches a value for each key the first time it's needed. Different keys load in
+// parallel, and each of them only loads once. The mutex for the map is only held to find or add
+// the entry for a key, never while it's loading. Entries stay in the map until it's destroyed.
+template <typename _Key, typename _Value>
+class LazyMap
+{
+public:
+	using Loader = std::function<_Value(const _Key& key)>;
+
+	explicit LazyMap(Loader&& loader)
+		: _loader(std::move(loader))
+	{
+	}
+
+	const _Value& get(const _Key& key) const
+	{
+		const Lazy<_Value>* entry = nullptr;
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			auto& value = _entries[key];
+
+			if (!value)
+			{
+				const auto& loader = _loader;
+
+				value.reset(new Lazy<_Value>(std::bind(
+					[&loader](const _Key& keyArg)
+				{
+					return loader(keyArg);
+				}, key)));
+			}
+
+			entry = value.get();
+		}
+
+		return entry->get();
+	}
+
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		return _entries.size();
+	}
+
+private:
+	const Loader _loader;
+
+	mutable std::mutex _mutex;
+	mutable std::map<_Key, std::unique_ptr<const Lazy<_Value>>> _entries;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
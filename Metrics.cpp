@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Metrics.h"
+
+#include <sstream>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+constexpr size_t LatencyHistogram::c_bucketCount;
+constexpr size_t MetricsSnapshot::c_stageCount;
+constexpr size_t MetricsSnapshot::c_counterCount;
+constexpr size_t Metrics::c_shardCount;
+constexpr int64_t Metrics::c_latencyBounds[LatencyHistogram::c_bucketCount - 1];
+
+const LatencyHistogram& MetricsSnapshot::getLatency(MetricStage stage) const
+{
+	return latencies[static_cast<size_t>(stage)];
+}
+
+uint64_t MetricsSnapshot::getCounter(MetricCounter counter) const
+{
+	return counters[static_cast<size_t>(counter)];
+}
+
+Metrics::Shard::Shard()
+	: activeRequests(0)
+{
+	for (auto& stage : buckets)
+	{
+		for (auto& bucket : stage)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	for (auto& sum : sums)
+	{
+		sum.store(0, std::memory_order_relaxed);
+	}
+
+	for (auto& counter : counters)
+	{
+		counter.store(0, std::memory_order_relaxed);
+	}
+}
+
+Metrics::Shard& Metrics::getShard()
+{
+	// Threads take the shards in turn the first time they use any Metrics.
+	static std::atomic<size_t> s_nextShard { 0 };
+	static thread_local const size_t s_shard = s_nextShard.fetch_add(1, std::memory_order_relaxed) % c_shardCount;
+
+	return _shards[s_shard];
+}
+
+void Metrics::recordLatency(MetricStage stage, std::chrono::steady_clock::duration duration)
+{
+	const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	const auto index = static_cast<size_t>(stage);
+	size_t bucket = 0;
+
+	while (bucket < LatencyHistogram::c_bucketCount - 1
+		&& microseconds > c_latencyBounds[bucket])
+	{
+		++bucket;
+	}
+
+	auto& shard = getShard();
+
+	shard.buckets[index][bucket].fetch_add(1, std::memory_order_relaxed);
+	shard.sums[index].fetch_add(static_cast<uint64_t>(microseconds > 0 ? microseconds : 0), std::memory_order_relaxed);
+}
+
+void Metrics::add(MetricCounter counter, uint64_t count)
+{
+	getShard().counters[static_cast<size_t>(counter)].fetch_add(count, std::memory_order_relaxed);
+}
+
+void Metrics::addFieldError(const std::string& typeName, const std::string& fieldName)
+{
+	auto& shard = getShard();
+	std::lock_guard<std::mutex> lock(shard.fieldErrorsMutex);
+
+	++shard.fieldErrors[typeName + "." + fieldName];
+}
+
+void Metrics::startRequest()
+{
+	getShard().activeRequests.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::endRequest()
+{
+	getShard().activeRequests.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MetricsSnapshot Metrics::getSnapshot() const
+{
+	MetricsSnapshot snapshot {};
+
+	for (auto& shard : _shards)
+	{
+		for (size_t stage = 0; stage < MetricsSnapshot::c_stageCount; ++stage)
+		{
+			auto& latency = snapshot.latencies[stage];
+
+			for (size_t bucket = 0; bucket < LatencyHistogram::c_bucketCount; ++bucket)
+			{
+				const auto count = shard.buckets[stage][bucket].load(std::memory_order_relaxed);
+
+				latency.buckets[bucket] += count;
+				latency.count += count;
+			}
+
+			latency.sum += std::chrono::microseconds(shard.sums[stage].load(std::memory_order_relaxed));
+		}
+
+		for (size_t counter = 0; counter < MetricsSnapshot::c_counterCount; ++counter)
+		{
+			snapshot.counters[counter] += shard.counters[counter].load(std::memory_order_relaxed);
+		}
+
+		// A request can start on one shard and end on another, so only the total is meaningful.
+		snapshot.activeRequests += shard.activeRequests.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(shard.fieldErrorsMutex);
+
+		for (const auto& entry : shard.fieldErrors)
+		{
+			snapshot.fieldErrors[entry.first] += entry.second;
+		}
+	}
+
+	return snapshot;
+}
+
+std::string Metrics::toPrometheus(const std::string& prefix) const
+{
+	static const char* const s_stageNames[MetricsSnapshot::c_stageCount] = {
+		"parse",
+		"validate",
+		"execute",
+		"serialize",
+	};
+	static const char* const s_counterNames[MetricsSnapshot::c_counterCount] = {
+		"requests_total",
+		"document_cache_hits_total",
+		"document_cache_misses_total",
+		"result_cache_hits_total",
+		"result_cache_misses_total",
+		"response_bytes_total",
+		"arena_allocations_total",
+		"arena_bytes_total",
+	};
+
+	const auto snapshot = getSnapshot();
+	std::ostringstream output;
+
+	output << "# TYPE " << prefix << "_stage_duration_seconds histogram\n";
+
+	for (size_t stage = 0; stage < MetricsSnapshot::c_stageCount; ++stage)
+	{
+		const auto& latency = snapshot.latencies[stage];
+		uint64_t cumulative = 0;
+
+		// Prometheus buckets count everything at or below their bound.
+		for (size_t bucket = 0; bucket < LatencyHistogram::c_bucketCount; ++bucket)
+		{
+			cumulative += latency.buckets[bucket];
+			output << prefix << "_stage_duration_seconds_bucket{stage=\"" << s_stageNames[stage] << "\",le=\"";
+
+			if (bucket < LatencyHistogram::c_bucketCount - 1)
+			{
+				output << (c_latencyBounds[bucket] / 1000000.0);
+			}
+			else
+			{
+				output << "+Inf";
+			}
+
+			output << "\"} " << cumulative << '\n';
+		}
+
+		output << prefix << "_stage_duration_seconds_sum{stage=\"" << s_stageNames[stage] << "\"} "
+			<< (latency.sum.count() / 1000000.0) << '\n'
+			<< prefix << "_stage_duration_seconds_count{stage=\"" << s_stageNames[stage] << "\"} "
+			<< latency.count << '\n';
+	}
+
+	for (size_t counter = 0; counter < MetricsSnapshot::c_counterCount; ++counter)
+	{
+		output << "# TYPE " << prefix << '_' << s_counterNames[counter] << " counter\n"
+			<< prefix << '_' << s_counterNames[counter] << ' ' << snapshot.counters[counter] << '\n';
+	}
+
+	output << "# TYPE " << prefix << "_active_requests gauge\n"
+		<< prefix << "_active_requests " << snapshot.activeRequests << '\n';
+
+	output << "# TYPE " << prefix << "_field_errors_total counter\n";
+
+	for (const auto& entry : snapshot.fieldErrors)
+	{
+		const auto separator = entry.first.find('.');
+
+		output << prefix << "_field_errors_total{type=\"" << entry.first.substr(0, separator)
+			<< "\",field=\"" << entry.first.substr(separator + 1) << "\"} " << entry.second << '\n';
+	}
+
+	return output.str();
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
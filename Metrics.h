@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Each stage of a request has its own latency histogram. Responses which are returned as a
+// web::json::value are serialized by the caller, so the caller records Serialize for them.
+enum class MetricStage
+{
+	Parse,
+	Validate,
+	Execute,
+	Serialize,
+};
+
+enum class MetricCounter
+{
+	Requests,
+	DocumentCacheHits,
+	DocumentCacheMisses,
+	ResultCacheHits,
+	ResultCacheMisses,
+	BytesWritten,
+	ArenaAllocations,
+	ArenaBytes,
+};
+
+// Snapshot of a latency histogram. Each bucket counts the observations which took at most its
+// bound in Metrics::c_latencyBounds, and which didn't fit in an earlier bucket. The last one has
+// no bound.
+struct LatencyHistogram
+{
+	static constexpr size_t c_bucketCount = 13;
+
+	std::array<uint64_t, c_bucketCount> buckets;
+	uint64_t count;
+	std::chrono::microseconds sum;
+};
+
+// Snapshot of everything in Metrics. The field errors are keyed by Type.field.
+struct MetricsSnapshot
+{
+	static constexpr size_t c_stageCount = 4;
+	static constexpr size_t c_counterCount = 8;
+
+	std::array<LatencyHistogram, c_stageCount> latencies;
+	std::array<uint64_t, c_counterCount> counters;
+	int64_t activeRequests;
+	std::map<std::string, uint64_t> fieldErrors;
+
+	const LatencyHistogram& getLatency(MetricStage stage) const;
+	uint64_t getCounter(MetricCounter counter) const;
+};
+
+// Metrics collects counters and latency histograms for every request which shares it in the
+// RequestOptions. Updates are spread over a fixed number of shards, and each thread always uses
+// the same one, so counting something is a relaxed atomic add that other threads rarely touch.
+// Field errors are keyed by name, so they're kept in a map on the shard behind its own mutex.
+// Snapshots add the shards together, so they may be slightly behind requests still running.
+class Metrics
+{
+public:
+	static constexpr size_t c_shardCount = 16;
+
+	// Upper bounds of the latency buckets in microseconds.
+	static constexpr int64_t c_latencyBounds[LatencyHistogram::c_bucketCount - 1] = {
+		50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000
+	};
+
+	void recordLatency(MetricStage stage, std::chrono::steady_clock::duration duration);
+	void add(MetricCounter counter, uint64_t count = 1);
+	void addFieldError(const std::string& typeName, const std::string& fieldName);
+
+	// The number of requests which are executing right now.
+	void startRequest();
+	void endRequest();
+
+	MetricsSnapshot getSnapshot() const;
+
+	// Format the snapshot in the Prometheus text exposition format, with every metric name
+	// starting with prefix and an underscore.
+	std::string toPrometheus(const std::string& prefix = "graphql") const;
+
+private:
+	struct Shard
+	{
+		Shard();
+
+		std::array<std::array<std::atomic<uint64_t>, LatencyHistogram::c_bucketCount>, MetricsSnapshot::c_stageCount> buckets;
+		std::array<std::atomic<uint64_t>, MetricsSnapshot::c_stageCount> sums;
+		std::array<std::atomic<uint64_t>, MetricsSnapshot::c_counterCount> counters;
+		std::atomic<int64_t> activeRequests;
+
+		mutable std::mutex fieldErrorsMutex;
+		std::map<std::string, uint64_t> fieldErrors;
+
+		// Keep the next shard off of this one's cache line.
+		char padding[64];
+	};
+
+	Shard& getShard();
+
+	std::array<Shard, c_shardCount> _shards;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
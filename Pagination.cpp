@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Pagination.h"
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+web::json::value makeCursor(const std::vector<unsigned char>& id)
+{
+	return web::json::value::string(utility::conversions::to_base64(id));
+}
+
+std::vector<unsigned char> parseCursor(const std::string& name, const web::json::value& cursor)
+{
+	try
+	{
+		return IdArgument<>::convert(cursor);
+	}
+	catch (const web::json::json_exception& ex)
+	{
+		std::ostringstream error;
+
+		error << "Invalid argument: " << name << " message: " << ex.what();
+		throw schema_exception({ error.str() });
+	}
+}
+
+void checkPageSize(const std::string& name, int size)
+{
+	if (size < 0)
+	{
+		std::ostringstream error;
+
+		error << "Invalid argument: " << name << " value: " << size;
+		throw schema_exception({ error.str() });
+	}
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <algorithm>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Cursors are the base64 encoded id of the node at that edge, the same as an ID scalar.
+web::json::value makeCursor(const std::vector<unsigned char>& id);
+
+// Decode an after or before argument. Throws a schema_exception naming the argument if it isn't a
+// valid cursor.
+std::vector<unsigned char> parseCursor(const std::string& name, const web::json::value& cursor);
+
+// Throws a schema_exception naming the argument if a first or last argument is negative.
+void checkPageSize(const std::string& name, int size);
+
+// ConnectionSlice is one page of a connection. It shares the nodes with the ConnectionIndex it came
+// from instead of copying them, so it's cheap to hold onto until the edges are resolved.
+template <typename _Node>
+struct ConnectionSlice
+{
+	using NodeList = std::vector<std::shared_ptr<_Node>>;
+	using const_iterator = typename NodeList::const_iterator;
+
+	std::shared_ptr<const NodeList> nodes;
+	size_t offset;
+	size_t count;
+	bool hasNextPage;
+	bool hasPreviousPage;
+
+	const_iterator cbegin() const
+	{
+		return nodes->cbegin() + offset;
+	}
+
+	const_iterator cend() const
+	{
+		return cbegin() + count;
+	}
+
+	size_t size() const
+	{
+		return count;
+	}
+};
+
+// ConnectionIndex sorts the positions of the nodes in a connection by their ids once, so finding a
+// node or seeking to an after or before cursor is a binary search instead of a scan over all of
+// them. The nodes keep their original order in the connection, and they should not change while
+// there are slices of them outstanding.
+template <typename _Node>
+class ConnectionIndex
+{
+public:
+	using NodeList = std::vector<std::shared_ptr<_Node>>;
+	using Id = std::vector<unsigned char>;
+	using IdAccessor = std::function<const Id&(const _Node&)>;
+
+	explicit ConnectionIndex(NodeList&& nodes, IdAccessor&& getId)
+		: _nodes(std::make_shared<const NodeList>(std::move(nodes)))
+		, _getId(std::move(getId))
+		, _sorted(_nodes->size())
+	{
+		for (size_t i = 0; i < _sorted.size(); ++i)
+		{
+			_sorted[i] = i;
+		}
+
+		// Keep duplicate ids in their original order, so find returns the first one.
+		std::stable_sort(_sorted.begin(), _sorted.end(),
+			[this](size_t lhs, size_t rhs)
+		{
+			return idAt(lhs) < idAt(rhs);
+		});
+	}
+
+	std::shared_ptr<_Node> find(const Id& id) const
+	{
+		const size_t position = findPosition(id);
+
+		return (position == c_notFound)
+			? nullptr
+			: (*_nodes)[position];
+	}
+
+	// Apply the Relay connection arguments. The page starts after the after cursor and stops before
+	// the before cursor, and cursors which don't match a node are ignored. Then first and last trim
+	// the page from the front and the back.
+	ConnectionSlice<_Node> slice(const int* first, const web::json::value* after, const int* last, const web::json::value* before) const
+	{
+		size_t begin = 0;
+		size_t end = _nodes->size();
+
+		if (after)
+		{
+			const size_t position = findPosition(parseCursor("after", *after));
+
+			if (position != c_notFound)
+			{
+				begin = position + 1;
+			}
+		}
+
+		if (before)
+		{
+			const size_t position = findPosition(parseCursor("before", *before));
+
+			if (position != c_notFound)
+			{
+				end = position;
+			}
+		}
+
+		if (end < begin)
+		{
+			end = begin;
+		}
+
+		if (first)
+		{
+			checkPageSize("first", *first);
+
+			if (end - begin > static_cast<size_t>(*first))
+			{
+				end = begin + static_cast<size_t>(*first);
+			}
+		}
+
+		if (last)
+		{
+			checkPageSize("last", *last);
+
+			if (end - begin > static_cast<size_t>(*last))
+			{
+				begin = end - static_cast<size_t>(*last);
+			}
+		}
+
+		return { _nodes, begin, end - begin, end < _nodes->size(), begin > 0 };
+	}
+
+	const NodeList& nodes() const
+	{
+		return *_nodes;
+	}
+
+private:
+	static constexpr size_t c_notFound = static_cast<size_t>(-1);
+
+	const Id& idAt(size_t position) const
+	{
+		return _getId(*(*_nodes)[position]);
+	}
+
+	size_t findPosition(const Id& id) const
+	{
+		auto itr = std::lower_bound(_sorted.cbegin(), _sorted.cend(), id,
+			[this](size_t position, const Id& value)
+		{
+			return idAt(position) < value;
+		});
+
+		return (itr == _sorted.cend() || idAt(*itr) != id)
+			? c_notFound
+			: *itr;
+	}
+
+	const std::shared_ptr<const NodeList> _nodes;
+	const IdAccessor _getId;
+	std::vector<size_t> _sorted;
+};
+
+template <typename _Node>
+constexpr size_t ConnectionIndex<_Node>::c_notFound;
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
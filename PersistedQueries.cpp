@@ -0,0 +1,277 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "PersistedQueries.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+namespace {
+
+// FIPS 180-4, there's no portable way to get this from the platform without another dependency.
+class Sha256
+{
+public:
+	Sha256()
+		: _state({ {
+			0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+			0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+		} })
+	{
+	}
+
+	void update(const unsigned char* data, size_t size)
+	{
+		_length += size;
+
+		while (size > 0)
+		{
+			const size_t count = std::min(size, _block.size() - _blockSize);
+
+			std::copy(data, data + count, _block.begin() + _blockSize);
+			_blockSize += count;
+			data += count;
+			size -= count;
+
+			if (_blockSize == _block.size())
+			{
+				transform();
+				_blockSize = 0;
+			}
+		}
+	}
+
+	std::array<unsigned char, 32> finish()
+	{
+		const uint64_t bits = static_cast<uint64_t>(_length) * 8;
+		const unsigned char one = 0x80;
+		const unsigned char zero = 0;
+
+		update(&one, 1);
+
+		while (_blockSize != 56)
+		{
+			update(&zero, 1);
+		}
+
+		for (int shift = 56; shift >= 0; shift -= 8)
+		{
+			const auto byte = static_cast<unsigned char>(bits >> shift);
+
+			update(&byte, 1);
+		}
+
+		std::array<unsigned char, 32> digest;
+
+		for (size_t i = 0; i < _state.size(); ++i)
+		{
+			digest[i * 4] = static_cast<unsigned char>(_state[i] >> 24);
+			digest[i * 4 + 1] = static_cast<unsigned char>(_state[i] >> 16);
+			digest[i * 4 + 2] = static_cast<unsigned char>(_state[i] >> 8);
+			digest[i * 4 + 3] = static_cast<unsigned char>(_state[i]);
+		}
+
+		return digest;
+	}
+
+private:
+	static uint32_t rotate(uint32_t value, int bits)
+	{
+		return (value >> bits) | (value << (32 - bits));
+	}
+
+	void transform()
+	{
+		static const uint32_t k[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+		uint32_t w[64];
+
+		for (size_t i = 0; i < 16; ++i)
+		{
+			w[i] = (static_cast<uint32_t>(_block[i * 4]) << 24)
+				| (static_cast<uint32_t>(_block[i * 4 + 1]) << 16)
+				| (static_cast<uint32_t>(_block[i * 4 + 2]) << 8)
+				| static_cast<uint32_t>(_block[i * 4 + 3]);
+		}
+
+		for (size_t i = 16; i < 64; ++i)
+		{
+			const uint32_t s0 = rotate(w[i - 15], 7) ^ rotate(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			const uint32_t s1 = rotate(w[i - 2], 17) ^ rotate(w[i - 2], 19) ^ (w[i - 2] >> 10);
+
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		auto a = _state[0];
+		auto b = _state[1];
+		auto c = _state[2];
+		auto d = _state[3];
+		auto e = _state[4];
+		auto f = _state[5];
+		auto g = _state[6];
+		auto h = _state[7];
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			const uint32_t s1 = rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25);
+			const uint32_t choose = (e & f) ^ (~e & g);
+			const uint32_t temp1 = h + s1 + choose + k[i] + w[i];
+			const uint32_t s0 = rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22);
+			const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+			const uint32_t temp2 = s0 + majority;
+
+			h = g;
+			g = f;
+			f = e;
+			e = d + temp1;
+			d = c;
+			c = b;
+			b = a;
+			a = temp1 + temp2;
+		}
+
+		_state[0] += a;
+		_state[1] += b;
+		_state[2] += c;
+		_state[3] += d;
+		_state[4] += e;
+		_state[5] += f;
+		_state[6] += g;
+		_state[7] += h;
+	}
+
+	std::array<uint32_t, 8> _state;
+	std::array<unsigned char, 64> _block;
+	size_t _blockSize = 0;
+	size_t _length = 0;
+};
+
+} /* namespace */
+
+std::string sha256Hex(const std::string& text)
+{
+	Sha256 hash;
+
+	hash.update(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+
+	const auto digest = hash.finish();
+	std::ostringstream output;
+
+	output << std::hex << std::setfill('0');
+
+	for (auto byte : digest)
+	{
+		output << std::setw(2) << static_cast<int>(byte);
+	}
+
+	return output.str();
+}
+
+constexpr size_t PersistedQueryStore::c_defaultMaxEntries;
+
+PersistedQueryStore::PersistedQueryStore(bool autoRegister, size_t maxEntries)
+	: _autoRegister(autoRegister)
+	, _maxEntries(maxEntries)
+{
+}
+
+std::string PersistedQueryStore::add(const std::string& query)
+{
+	auto sha256Hash = sha256Hex(query);
+
+	insert(sha256Hash, query, true);
+
+	return sha256Hash;
+}
+
+std::shared_ptr<const ParsedDocument> PersistedQueryStore::add(const std::string& sha256Hash, const std::string& query)
+{
+	auto document = find(sha256Hash);
+
+	if (document)
+	{
+		return document;
+	}
+
+	if (sha256Hex(query) != sha256Hash)
+	{
+		throw schema_exception({ "provided sha does not match query" });
+	}
+
+	return insert(sha256Hash, query, false);
+}
+
+std::shared_ptr<const ParsedDocument> PersistedQueryStore::find(const std::string& sha256Hash) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto itr = _documents.find(sha256Hash);
+
+	return (itr == _documents.cend())
+		? nullptr
+		: itr->second;
+}
+
+bool PersistedQueryStore::getAutoRegister() const
+{
+	return _autoRegister;
+}
+
+size_t PersistedQueryStore::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _documents.size();
+}
+
+std::shared_ptr<const ParsedDocument> PersistedQueryStore::insert(const std::string& sha256Hash, const std::string& query, bool throwIfFull)
+{
+	// Parse outside of the lock so a slow document doesn't block every other request, but don't
+	// bother if there's no room for it.
+	if (!throwIfFull
+		&& size() >= _maxEntries)
+	{
+		return nullptr;
+	}
+
+	auto document = ParsedDocument::parse(query);
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto itr = _documents.find(sha256Hash);
+
+	if (itr != _documents.cend())
+	{
+		// Another thread registered the same query first, share its copy.
+		return itr->second;
+	}
+
+	if (_documents.size() >= _maxEntries)
+	{
+		if (throwIfFull)
+		{
+			throw schema_exception({ "Too many persisted queries" });
+		}
+
+		return nullptr;
+	}
+
+	_documents[sha256Hash] = document;
+
+	return document;
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// Hash the query text with SHA-256 and return it as lowercase hex, which is how clients identify
+// persisted queries.
+std::string sha256Hex(const std::string& text);
+
+// PersistedQueryStore keeps the parsed documents for queries which have been registered under
+// their SHA-256 hash, so a client can send the hash instead of the whole query text. Queries can
+// be registered ahead of time, or if autoRegister is set, the first time a client sends the hash
+// along with the query text (Automatic Persisted Queries). It's safe to share between threads
+// and between Requests, and it stops accepting new queries once it has maxEntries.
+class PersistedQueryStore
+{
+public:
+	static constexpr size_t c_defaultMaxEntries = 10000;
+
+	explicit PersistedQueryStore(bool autoRegister = true, size_t maxEntries = c_defaultMaxEntries);
+
+	// Parse and register the query text, and return its hash. Throws a schema_exception if the
+	// query text has syntax errors or the store is full.
+	std::string add(const std::string& query);
+
+	// Register the query text under a hash computed by the client, which must match. If the hash is
+	// already registered, the existing document is returned without parsing the query again. If the
+	// store is full, it returns null and the caller can still parse the query text on its own.
+	std::shared_ptr<const ParsedDocument> add(const std::string& sha256Hash, const std::string& query);
+
+	// Return the document for a hash, or null if it isn't registered.
+	std::shared_ptr<const ParsedDocument> find(const std::string& sha256Hash) const;
+
+	bool getAutoRegister() const;
+	size_t size() const;
+
+private:
+	std::shared_ptr<const ParsedDocument> insert(const std::string& sha256Hash, const std::string& query, bool throwIfFull);
+
+	const bool _autoRegister;
+	const size_t _maxEntries;
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, std::shared_ptr<const ParsedDocument>> _documents;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
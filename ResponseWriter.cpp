@@ -0,0 +1,335 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "ResponseWriter.h"
+
+#include <cstring>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+constexpr size_t ResponseWriter::c_defaultChunkSize;
+
+ResponseWriter::ResponseWriter(Sink&& sink, size_t chunkSize, ResponseEncoding encoding)
+	: _sink(std::move(sink))
+	, _chunkSize(chunkSize)
+	, _encoding(encoding)
+{
+	_buffer.reserve(_chunkSize);
+}
+
+ResponseWriter::ResponseWriter(std::string& output, ResponseEncoding encoding)
+	: ResponseWriter([&output](const std::string& chunk)
+	{
+		output.append(chunk);
+	}, c_defaultChunkSize, encoding)
+{
+}
+
+ResponseWriter::ResponseWriter(std::ostream& output, size_t chunkSize, ResponseEncoding encoding)
+	: ResponseWriter([&output](const std::string& chunk)
+	{
+		output.write(chunk.data(), chunk.size());
+	}, chunkSize, encoding)
+{
+}
+
+ResponseEncoding ResponseWriter::getEncoding() const
+{
+	return _encoding;
+}
+
+void ResponseWriter::startObject()
+{
+	startValue();
+	write((_encoding == ResponseEncoding::Cbor) ? "\xBF" : "{");
+	_scopes.push_back(Scope::Object);
+	_needComma = false;
+}
+
+void ResponseWriter::addKey(const utility::string_t& key)
+{
+	if (_encoding == ResponseEncoding::Cbor)
+	{
+		std::string encoded;
+
+		encodeCborString(encoded, key);
+		write(encoded);
+	}
+	else
+	{
+		if (_needComma)
+		{
+			write(",");
+		}
+
+		write(utility::conversions::to_utf8string(web::json::value::string(key).serialize()));
+		write(":");
+	}
+
+	_needComma = false;
+	_needValue = true;
+}
+
+void ResponseWriter::endObject()
+{
+	write((_encoding == ResponseEncoding::Cbor) ? "\xFF" : "}");
+	_scopes.pop_back();
+	_needComma = true;
+}
+
+void ResponseWriter::startArray()
+{
+	startValue();
+	write((_encoding == ResponseEncoding::Cbor) ? "\x9F" : "[");
+	_scopes.push_back(Scope::Array);
+	_needComma = false;
+}
+
+void ResponseWriter::endArray()
+{
+	write((_encoding == ResponseEncoding::Cbor) ? "\xFF" : "]");
+	_scopes.pop_back();
+	_needComma = true;
+}
+
+void ResponseWriter::addValue(const web::json::value& value)
+{
+	startValue();
+
+	if (_encoding == ResponseEncoding::Cbor)
+	{
+		std::string encoded;
+
+		encodeCborValue(encoded, value);
+		write(encoded);
+	}
+	else
+	{
+		write(utility::conversions::to_utf8string(value.serialize()));
+	}
+
+	_needComma = true;
+}
+
+void ResponseWriter::addBytes(const std::vector<unsigned char>& bytes)
+{
+	if (_encoding != ResponseEncoding::Cbor)
+	{
+		addValue(web::json::value::string(utility::conversions::to_base64(bytes)));
+		return;
+	}
+
+	std::string encoded;
+
+	startValue();
+	encodeCborHead(encoded, 2, bytes.size());
+	encoded.append(bytes.cbegin(), bytes.cend());
+	write(encoded);
+	_needComma = true;
+}
+
+void ResponseWriter::addSerializedValue(const std::string& value)
+{
+	if (_encoding == ResponseEncoding::Cbor)
+	{
+		addValue(web::json::value::parse(utility::conversions::to_string_t(value)));
+		return;
+	}
+
+	startValue();
+	write(value);
+	_needComma = true;
+}
+
+size_t ResponseWriter::getValueCount() const
+{
+	return _valueCount;
+}
+
+void ResponseWriter::addResult(size_t valueCount, const web::json::value& result)
+{
+	if (valueCount == _valueCount)
+	{
+		addValue(result);
+	}
+}
+
+size_t ResponseWriter::getDepth() const
+{
+	return _scopes.size();
+}
+
+void ResponseWriter::unwind(size_t depth)
+{
+	if (_needValue)
+	{
+		addValue(web::json::value::null());
+	}
+
+	while (_scopes.size() > depth)
+	{
+		if (_scopes.back() == Scope::Object)
+		{
+			endObject();
+		}
+		else
+		{
+			endArray();
+		}
+	}
+}
+
+void ResponseWriter::flush()
+{
+	if (!_buffer.empty())
+	{
+		_sink(_buffer);
+		_bytesFlushed += _buffer.size();
+		_buffer.clear();
+	}
+}
+
+size_t ResponseWriter::getBytesWritten() const
+{
+	return _bytesFlushed + _buffer.size();
+}
+
+void ResponseWriter::startValue()
+{
+	if (_encoding == ResponseEncoding::Json
+		&& _needComma
+		&& !_scopes.empty()
+		&& _scopes.back() == Scope::Array)
+	{
+		write(",");
+	}
+
+	_needValue = false;
+	++_valueCount;
+}
+
+void ResponseWriter::write(const std::string& text)
+{
+	_buffer.append(text);
+
+	if (_buffer.size() >= _chunkSize)
+	{
+		flush();
+	}
+}
+
+void ResponseWriter::encodeCborHead(std::string& output, unsigned char majorType, uint64_t argument)
+{
+	const unsigned char type = static_cast<unsigned char>(majorType << 5);
+
+	if (argument < 24)
+	{
+		output.push_back(static_cast<char>(type | argument));
+		return;
+	}
+
+	size_t size = 8;
+	unsigned char additional = 27;
+
+	if (argument <= 0xFF)
+	{
+		size = 1;
+		additional = 24;
+	}
+	else if (argument <= 0xFFFF)
+	{
+		size = 2;
+		additional = 25;
+	}
+	else if (argument <= 0xFFFFFFFF)
+	{
+		size = 4;
+		additional = 26;
+	}
+
+	output.push_back(static_cast<char>(type | additional));
+
+	for (size_t i = size; i > 0; --i)
+	{
+		output.push_back(static_cast<char>(argument >> ((i - 1) * 8)));
+	}
+}
+
+void ResponseWriter::encodeCborValue(std::string& output, const web::json::value& value)
+{
+	if (value.is_null())
+	{
+		output.push_back('\xF6');
+	}
+	else if (value.is_boolean())
+	{
+		output.push_back(value.as_bool() ? '\xF5' : '\xF4');
+	}
+	else if (value.is_integer())
+	{
+		const int64_t integer = value.as_integer();
+
+		if (integer < 0)
+		{
+			encodeCborHead(output, 1, static_cast<uint64_t>(-(integer + 1)));
+		}
+		else
+		{
+			encodeCborHead(output, 0, static_cast<uint64_t>(integer));
+		}
+	}
+	else if (value.is_number())
+	{
+		const double number = value.as_double();
+		uint64_t bits;
+
+		std::memcpy(&bits, &number, sizeof(bits));
+		output.push_back('\xFB');
+
+		for (int shift = 56; shift >= 0; shift -= 8)
+		{
+			output.push_back(static_cast<char>(bits >> shift));
+		}
+	}
+	else if (value.is_string())
+	{
+		encodeCborString(output, value.as_string());
+	}
+	else if (value.is_array())
+	{
+		const auto& elements = value.as_array();
+
+		encodeCborHead(output, 4, elements.size());
+
+		for (const auto& element : elements)
+		{
+			encodeCborValue(output, element);
+		}
+	}
+	else if (value.is_object())
+	{
+		const auto& fields = value.as_object();
+
+		encodeCborHead(output, 5, fields.size());
+
+		for (const auto& field : fields)
+		{
+			encodeCborString(output, field.first);
+			encodeCborValue(output, field.second);
+		}
+	}
+}
+
+void ResponseWriter::encodeCborString(std::string& output, const utility::string_t& value)
+{
+	const auto utf8 = utility::conversions::to_utf8string(value);
+
+	encodeCborHead(output, 3, utf8.size());
+	output.append(utf8);
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
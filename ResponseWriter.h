@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <cpprest/json.h>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// The response can be written as JSON text, or as CBOR (RFC 7049) for callers which don't need
+// text. CBOR objects and arrays use indefinite lengths so they can be written before the number
+// of fields or elements is known, and IDs are written as byte strings instead of base64.
+enum class ResponseEncoding
+{
+	Json,
+	Cbor,
+};
+
+// ResponseWriter serializes a response as it's resolved instead of building the whole thing
+// as a web::json::value first. Output is buffered and handed to the sink in chunks of roughly
+// chunkSize bytes, or whenever flush is called. Once a chunk is written it can't be taken back,
+// so if an error interrupts part of the response, unwind fills in the rest with nulls to keep the
+// output well formed.
+class ResponseWriter
+{
+public:
+	using Sink = std::function<void(const std::string& chunk)>;
+
+	static constexpr size_t c_defaultChunkSize = 4096;
+
+	explicit ResponseWriter(Sink&& sink, size_t chunkSize = c_defaultChunkSize, ResponseEncoding encoding = ResponseEncoding::Json);
+	explicit ResponseWriter(std::string& output, ResponseEncoding encoding = ResponseEncoding::Json);
+	explicit ResponseWriter(std::ostream& output, size_t chunkSize = c_defaultChunkSize, ResponseEncoding encoding = ResponseEncoding::Json);
+
+	ResponseEncoding getEncoding() const;
+
+	void startObject();
+	void addKey(const utility::string_t& key);
+	void endObject();
+
+	void startArray();
+	void endArray();
+
+	void addValue(const web::json::value& value);
+
+	// Write an ID, as a byte string in CBOR or a base64 string in JSON.
+	void addBytes(const std::vector<unsigned char>& bytes);
+
+	// Write a value which has already been serialized to JSON. It has to be parsed again for CBOR.
+	void addSerializedValue(const std::string& value);
+
+	// Resolvers for objects and lists write their own results, everything else just returns a
+	// JSON value. Compare the count of values from before calling the resolver to see if we
+	// still need to write the result.
+	size_t getValueCount() const;
+	void addResult(size_t valueCount, const web::json::value& result);
+
+	// Close any objects or arrays nested deeper than depth, filling in a null if there was a key
+	// without a value.
+	size_t getDepth() const;
+	void unwind(size_t depth);
+
+	void flush();
+
+	// The number of bytes which have been written so far, including any which haven't been
+	// flushed to the sink yet.
+	size_t getBytesWritten() const;
+
+private:
+	enum class Scope
+	{
+		Object,
+		Array,
+	};
+
+	void startValue();
+	void write(const std::string& text);
+
+	static void encodeCborHead(std::string& output, unsigned char majorType, uint64_t argument);
+	static void encodeCborValue(std::string& output, const web::json::value& value);
+	static void encodeCborString(std::string& output, const utility::string_t& value);
+
+	Sink _sink;
+	const size_t _chunkSize;
+	const ResponseEncoding _encoding;
+	std::string _buffer;
+	size_t _bytesFlushed = 0;
+	std::vector<Scope> _scopes;
+	bool _needComma = false;
+	bool _needValue = false;
+	size_t _valueCount = 0;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -4,11 +4,13 @@
 #include "SchemaGenerator.h"
 #include "GraphQLService.h"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cctype>
+#include <cstring>
 
 #include <graphqlparser/GraphQLParser.h>
 
@@ -40,6 +42,8 @@ Generator::Generator()
 	: _isIntrospection(true)
 	, _filenamePrefix("Introspection")
 	, _schemaNamespace(s_introspectionNamespace)
+	, _sharedStrings(true)
+	, _separateFiles(false)
 {
 	const char* error = nullptr;
 	auto ast = parseStringWithExperimentalSchemaSupport(R"gql(
@@ -147,10 +151,12 @@ Generator::Generator()
 	}
 }
 
-Generator::Generator(FILE* schemaDefinition, std::string filenamePrefix, std::string schemaNamespace)
+Generator::Generator(FILE* schemaDefinition, std::string filenamePrefix, std::string schemaNamespace, bool sharedStrings, bool separateFiles)
 	: _isIntrospection(false)
 	, _filenamePrefix(std::move(filenamePrefix))
 	, _schemaNamespace(std::move(schemaNamespace))
+	, _sharedStrings(sharedStrings)
+	, _separateFiles(separateFiles)
 {
 	const char* error = nullptr;
 	auto ast = parseFileWithExperimentalSchemaSupport(schemaDefinition, &error);
@@ -439,12 +445,72 @@ OutputFieldList Generator::getOutputFields(const std::vector<std::unique_ptr<ast
 			field.arguments = getInputFields(*(fieldDefinition->getArguments()));
 		}
 
+		if (fieldDefinition->getDirectives() != nullptr)
+		{
+			getCacheHint(*(fieldDefinition->getDirectives()), field);
+		}
+
 		outputFields.push_back(std::move(field));
 	}
 
 	return outputFields;
 }
 
+void Generator::getCacheHint(const std::vector<std::unique_ptr<ast::Directive>>& directives, OutputField& field)
+{
+	for (const auto& directive : directives)
+	{
+		if (std::string(directive->getName().getValue()) != "cacheControl")
+		{
+			continue;
+		}
+
+		field.hasCacheHint = true;
+
+		if (directive->getArguments() == nullptr)
+		{
+			continue;
+		}
+
+		for (const auto& argument : *(directive->getArguments()))
+		{
+			const std::string name(argument->getName().getValue());
+			DefaultValueVisitor value;
+
+			argument->getValue().accept(&value);
+
+			if (name == "maxAge")
+			{
+				const auto maxAge = value.getValue();
+
+				if (!maxAge.is_integer()
+					|| maxAge.as_integer() < 0)
+				{
+					throw std::runtime_error("Invalid maxAge on @cacheControl directive for field: " + field.name);
+				}
+
+				field.cacheMaxAge = static_cast<size_t>(maxAge.as_integer());
+			}
+			else if (name == "scope")
+			{
+				const auto scope = value.getValue();
+
+				if (!scope.is_string()
+					|| (scope.as_string() != _XPLATSTR("PUBLIC") && scope.as_string() != _XPLATSTR("PRIVATE")))
+				{
+					throw std::runtime_error("Invalid scope on @cacheControl directive for field: " + field.name);
+				}
+
+				field.cachePrivate = (scope.as_string() == _XPLATSTR("PRIVATE"));
+			}
+			else
+			{
+				throw std::runtime_error("Unknown argument on @cacheControl directive: " + name + " field: " + field.name);
+			}
+		}
+	}
+}
+
 InputFieldList Generator::getInputFields(const std::vector<std::unique_ptr<ast::InputValueDefinition>>& fields)
 {
 	InputFieldList inputFields;
@@ -595,9 +661,51 @@ std::vector<std::string> Generator::Build() const noexcept
 		builtFiles.push_back(_filenamePrefix + "Schema.cpp");
 	}
 
+	if (_separateFiles)
+	{
+		for (const auto& objectType : _objectTypes)
+		{
+			if (outputObjectSource(objectType))
+			{
+				builtFiles.push_back(getObjectSourceFilename(objectType));
+			}
+		}
+
+		if (outputFileList(builtFiles))
+		{
+			builtFiles.push_back(_filenamePrefix + "Schema.files");
+		}
+	}
+
 	return builtFiles;
 }
 
+bool Generator::writeFile(const std::string& filename, const std::string& content) noexcept
+{
+	std::ifstream existingFile(filename, std::ios_base::binary);
+
+	if (existingFile)
+	{
+		std::ostringstream existingContent;
+
+		existingContent << existingFile.rdbuf();
+
+		if (existingContent.str() == content)
+		{
+			return true;
+		}
+	}
+
+	existingFile.close();
+
+	std::ofstream outputFile(filename, std::ios_base::binary | std::ios_base::trunc);
+
+	outputFile << content;
+	outputFile.close();
+
+	return !outputFile.fail();
+}
+
 const std::string& Generator::getCppType(const std::string& type) const noexcept
 {
 	auto itrBuiltin = s_builtinTypes.find(type);
@@ -622,6 +730,87 @@ const std::string& Generator::getCppType(const std::string& type) const noexcept
 	return type;
 }
 
+bool Generator::isSharedOutput(const OutputField& field) const noexcept
+{
+	if (!_sharedStrings
+		|| field.fieldType != OutputFieldType::Builtin)
+	{
+		return false;
+	}
+
+	auto itrBuiltin = s_builtinTypes.find(field.type);
+
+	return itrBuiltin != s_builtinTypes.cend()
+		&& (itrBuiltin->second == BuiltinType::String
+			|| itrBuiltin->second == BuiltinType::ID);
+}
+
+bool Generator::isSharedList(const OutputField& field) const noexcept
+{
+	if (!_sharedStrings)
+	{
+		return false;
+	}
+
+	switch (field.fieldType)
+	{
+		case OutputFieldType::Object:
+		case OutputFieldType::Union:
+		case OutputFieldType::Interface:
+			break;
+
+		default:
+			return false;
+	}
+
+	// Only a single list of non-nullable objects, which may itself be nullable.
+	auto itrModifier = field.modifiers.cbegin();
+
+	if (itrModifier != field.modifiers.cend()
+		&& *itrModifier == service::TypeModifier::Nullable)
+	{
+		++itrModifier;
+	}
+
+	if (itrModifier == field.modifiers.cend()
+		|| *itrModifier != service::TypeModifier::List)
+	{
+		return false;
+	}
+
+	for (++itrModifier; itrModifier != field.modifiers.cend(); ++itrModifier)
+	{
+		if (*itrModifier != service::TypeModifier::None)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::string Generator::getSharedListType(const OutputField& field) const noexcept
+{
+	std::ostringstream listType;
+
+	listType << R"cpp(std::vector<std::shared_ptr<)cpp";
+
+	switch (field.fieldType)
+	{
+		case OutputFieldType::Object:
+			listType << getCppType(field.type);
+			break;
+
+		default:
+			listType << R"cpp(service::Object)cpp";
+			break;
+	}
+
+	listType << R"cpp(>>)cpp";
+
+	return listType.str();
+}
+
 std::string Generator::getInputCppType(const InputField& field) const noexcept
 {
 	size_t templateCount = 0;
@@ -658,6 +847,12 @@ std::string Generator::getInputCppType(const InputField& field) const noexcept
 
 std::string Generator::getOutputCppType(const OutputField& field) const noexcept
 {
+	if (isSharedList(field))
+	{
+		// Shared lists are never copied, and an empty shared_ptr is null.
+		return R"cpp(std::shared_ptr<const )cpp" + getSharedListType(field) + R"cpp(>)cpp";
+	}
+
 	bool nonNull = true;
 	size_t templateCount = 0;
 	std::ostringstream outputType;
@@ -699,7 +894,13 @@ std::string Generator::getOutputCppType(const OutputField& field) const noexcept
 			break;
 
 		default:
-			if (!nonNull)
+			if (isSharedOutput(field))
+			{
+				// Shared strings are never copied, and an empty shared_ptr is null.
+				outputType << R"cpp(std::shared_ptr<const )cpp";
+				++templateCount;
+			}
+			else if (!nonNull)
 			{
 				outputType << R"cpp(std::unique_ptr<)cpp";
 				++templateCount;
@@ -732,7 +933,7 @@ std::string Generator::getOutputCppType(const OutputField& field) const noexcept
 
 bool Generator::outputHeader() const noexcept
 {
-	std::ofstream headerFile(_filenamePrefix + "Schema.h", std::ios_base::trunc);
+	std::ostringstream headerFile;
 
 	headerFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
@@ -941,6 +1142,8 @@ public:
 
 				headerFile << R"cpp(
 private:
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
 )cpp";
 
 				for (const auto& outputField : objectType.fields)
@@ -949,13 +1152,13 @@ private:
 				}
 
 				headerFile << R"cpp(
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 )cpp";
 
 				if (objectType.type == queryType)
 				{
-					headerFile << R"cpp(	web::json::value resolve__schema(service::ResolverParams&& params);
-	web::json::value resolve__type(service::ResolverParams&& params);
+					headerFile << R"cpp(	std::future<web::json::value> resolve__schema(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolve__type(service::ResolverParams&& params) const;
 
 	std::shared_ptr<)cpp" << s_introspectionNamespace << R"cpp(::Schema> _schema;
 )cpp";
@@ -995,7 +1198,7 @@ public:
 					<< operation.operation;
 			}
 
-			headerFile << R"cpp();
+			headerFile << R"cpp(, service::RequestOptions options = {});
 
 private:
 )cpp";
@@ -1016,10 +1219,51 @@ private:
 void AddTypesToSchema(std::shared_ptr<)cpp" << s_introspectionNamespace << R"cpp(::Schema> schema);
 
 } /* namespace )cpp" << _schemaNamespace << R"cpp( */
-} /* namespace graphql */
+)cpp";
+
+	// The conversions are only defined in the main source file, but the object types which use
+	// them are compiled separately, so they need to see that they're specialized.
+	if (_separateFiles
+		&& (!_enumTypes.empty() || !_inputTypes.empty()))
+	{
+		headerFile << R"cpp(
+namespace service {
+)cpp";
+
+		for (const auto& enumType : _enumTypes)
+		{
+			headerFile << R"cpp(
+template <>
+)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.type
+<< R"cpp( ModifiedArgument<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.type
+<< R"cpp(>::convert(const web::json::value& value);
+
+template <>
+web::json::value ModifiedResult<)cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.type
+<< R"cpp(>::convert(const )cpp" << _schemaNamespace << R"cpp(::)cpp" << enumType.type
+<< R"cpp(& value, ResolverParams&&);
+)cpp";
+		}
+
+		for (const auto& inputType : _inputTypes)
+		{
+			headerFile << R"cpp(
+template <>
+)cpp" << _schemaNamespace << R"cpp(::)cpp" << inputType.type
+<< R"cpp( ModifiedArgument<)cpp" << _schemaNamespace << R"cpp(::)cpp" << inputType.type
+<< R"cpp(>::convert(const web::json::value& value);
+)cpp";
+		}
+
+		headerFile << R"cpp(
+} /* namespace service */
+)cpp";
+	}
+
+	headerFile << R"cpp(} /* namespace graphql */
 } /* namespace facebook */)cpp";
 
-	return true;
+	return writeFile(_filenamePrefix + "Schema.h", headerFile.str());
 }
 
 std::string Generator::getFieldDeclaration(const InputField& inputField) const noexcept
@@ -1035,22 +1279,15 @@ std::string Generator::getFieldDeclaration(const InputField& inputField) const n
 std::string Generator::getFieldDeclaration(const OutputField& outputField) const noexcept
 {
 	std::ostringstream output;
-	bool firstArgument = true;
 	std::string fieldName(outputField.name);
 
 	fieldName[0] = std::toupper(fieldName[0]);
-	output << R"cpp(	virtual )cpp" << getOutputCppType(outputField)
-		<< R"cpp( get)cpp" << fieldName << R"cpp(()cpp";
+	output << R"cpp(	virtual service::FieldResult<)cpp" << getOutputCppType(outputField)
+		<< R"cpp(> get)cpp" << fieldName << R"cpp((service::FieldParams&& params)cpp";
 
 	for (const auto& argument : outputField.arguments)
 	{
-		if (!firstArgument)
-		{
-			output << R"cpp(, )cpp";
-		}
-
-		firstArgument = false;
-		output << getInputCppType(argument) << R"cpp(&& )cpp"
+		output << R"cpp(, )cpp" << getInputCppType(argument) << R"cpp(&& )cpp"
 			<< argument.name;
 	}
 
@@ -1066,8 +1303,8 @@ std::string Generator::getResolverDeclaration(const OutputField& outputField) co
 	std::string fieldName(outputField.name);
 
 	fieldName[0] = std::toupper(fieldName[0]);
-	output << R"cpp(	web::json::value resolve)cpp" << fieldName
-		<< R"cpp((service::ResolverParams&& params);
+	output << R"cpp(	std::future<web::json::value> resolve)cpp" << fieldName
+		<< R"cpp((service::ResolverParams&& params) const;
 )cpp";
 
 	return output.str();
@@ -1075,7 +1312,7 @@ std::string Generator::getResolverDeclaration(const OutputField& outputField) co
 
 bool Generator::outputSource() const noexcept
 {
-	std::ofstream sourceFile(_filenamePrefix + "Schema.cpp", std::ios_base::trunc);
+	std::ostringstream sourceFile;
 
 	sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
@@ -1185,32 +1422,28 @@ template <>
 			{
 				if (!inputField.defaultValue.is_null())
 				{
-					if (firstField)
-					{
-						firstField = false;
-						sourceFile << R"cpp(	static const auto defaultValue = web::json::value::object({
-)cpp";
-					}
-					else
-					{
-						sourceFile << R"cpp(,
-)cpp";
-					}
-
+					std::string fieldName(inputField.name);
 					utility::ostringstream_t defaultValue;
 
+					fieldName[0] = std::toupper(fieldName[0]);
+					firstField = false;
 					defaultValue << inputField.defaultValue;
-					sourceFile << R"cpp(		{ _XPLATSTR(")cpp"
-						<< inputField.name << R"cpp("), web::json::value::parse(_XPLATSTR(R"js()cpp"
-						<< utility::conversions::to_utf8string(defaultValue.str()) << R"cpp()js")) })cpp";
+					sourceFile << R"cpp(	static const auto default)cpp" << fieldName
+						<< R"cpp( = web::json::value::parse(_XPLATSTR(R"js()cpp"
+						<< utility::conversions::to_utf8string(defaultValue.str()) << R"cpp()js"));
+)cpp";
 				}
 			}
 
 			if (!firstField)
 			{
 				sourceFile << R"cpp(
-	});
+)cpp";
+			}
 
+			if (!inputType.fields.empty())
+			{
+				sourceFile << R"cpp(	const auto& members = value.as_object();
 )cpp";
 			}
 
@@ -1219,27 +1452,18 @@ template <>
 				std::string fieldName(inputField.name);
 
 				fieldName[0] = std::toupper(fieldName[0]);
-				if (inputField.defaultValue.is_null())
+				sourceFile << R"cpp(	auto value)cpp" << fieldName
+					<< R"cpp( = )cpp" << getArgumentAccessType(inputField)
+					<< R"cpp(::require(")cpp" << inputField.name
+					<< R"cpp(", members)cpp";
+
+				if (!inputField.defaultValue.is_null())
 				{
-					sourceFile << R"cpp(	auto value)cpp" << fieldName
-						<< R"cpp( = )cpp" << getArgumentAccessType(inputField)
-						<< R"cpp(::require(")cpp" << inputField.name
-						<< R"cpp(", value.as_object());
-)cpp";
+					sourceFile << R"cpp(, default)cpp" << fieldName;
 				}
-				else
-				{
-					sourceFile << R"cpp(	auto pair)cpp" << fieldName
-						<< R"cpp( = )cpp" << getArgumentAccessType(inputField)
-						<< R"cpp(::find(")cpp" << inputField.name
-						<< R"cpp(", value.as_object());
-	auto value)cpp" << fieldName << R"cpp( = (pair)cpp" << fieldName << R"cpp(.second
-		? std::move(pair)cpp" << fieldName << R"cpp(.first)
-		: )cpp" << getArgumentAccessType(inputField)
-						<< R"cpp(::require(")cpp" << inputField.name
-						<< R"cpp(", defaultValue.as_object()));
+
+				sourceFile << R"cpp();
 )cpp";
-				}
 			}
 
 			if (!inputType.fields.empty())
@@ -1282,21 +1506,10 @@ template <>
 	sourceFile << R"cpp(
 namespace )cpp" << _schemaNamespace << R"cpp( {)cpp";
 
-	std::string queryType;
-
-	if (!_isIntrospection)
-	{
-		for (const auto& operation : _operationTypes)
-		{
-			if (operation.operation == "query")
-			{
-				queryType = operation.type;
-				break;
-			}
-		}
-	}
+	const auto queryType = getQueryType();
 
-	if (!_objectTypes.empty())
+	if (!_objectTypes.empty()
+		&& !_separateFiles)
 	{
 		sourceFile << R"cpp(
 namespace object {
@@ -1304,283 +1517,64 @@ namespace object {
 
 		for (const auto& objectType : _objectTypes)
 		{
-			// Output the protected constructor which calls through to the service::Object constructor
-			// with arguments that declare the set of types it implements and bind the fields to the
-			// resolver methods.
-			sourceFile << R"cpp(
-)cpp" << objectType.type << R"cpp(::)cpp" << objectType.type << R"cpp(()
-	: service::Object({
-)cpp";
+			outputObjectImplementation(sourceFile, objectType, queryType);
+		}
 
-			for (const auto& interfaceName : objectType.interfaces)
-			{
-				sourceFile << R"cpp(		")cpp" << interfaceName << R"cpp(",
-)cpp";
-			}
+		sourceFile << R"cpp(
+} /* namespace object */)cpp";
+	}
 
-			sourceFile << R"cpp(		")cpp" << objectType.type << R"cpp("
-	}, {
-)cpp";
+	if (!_operationTypes.empty())
+	{
+		bool firstOperation = true;
 
-			bool firstField = true;
+		sourceFile << R"cpp(
+
+Operations::Operations()cpp";
 
-			for (const auto& outputField : objectType.fields)
+		for (const auto& operation : _operationTypes)
+		{
+			if (!firstOperation)
 			{
-				if (!firstField)
-				{
-					sourceFile << R"cpp(,
-)cpp";
-				}
+				sourceFile << R"cpp(, )cpp";
+			}
 
-				firstField = false;
+			firstOperation = false;
+			sourceFile << R"cpp(std::shared_ptr<object::)cpp" << operation.type << R"cpp(> )cpp"
+				<< operation.operation;
+		}
 
-				std::string fieldName(outputField.name);
+		sourceFile << R"cpp(, service::RequestOptions options)
+	: service::Request({
+)cpp";
 
-				fieldName[0] = std::toupper(fieldName[0]);
-				sourceFile << R"cpp(		{ ")cpp" << outputField.name
-					<< R"cpp(", [this](service::ResolverParams&& params) { return resolve)cpp" << fieldName
-					<< R"cpp((std::move(params)); } })cpp";
-			}
+		firstOperation = true;
 
-			if (!firstField)
+		for (const auto& operation : _operationTypes)
+		{
+			if (!firstOperation)
 			{
 				sourceFile << R"cpp(,
 )cpp";
 			}
 
-			sourceFile << R"cpp(		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } })cpp";
+			firstOperation = false;
+			sourceFile << R"cpp(		{ ")cpp" << operation.operation
+				<< R"cpp(", )cpp" << operation.operation
+				<< R"cpp( })cpp";
+		}
 
+		sourceFile << R"cpp(
+	}, std::move(options))
+)cpp";
 
-			if (objectType.type == queryType)
-			{
-				sourceFile << R"cpp(,
-		{ "__schema", [this](service::ResolverParams&& params) { return resolve__schema(std::move(params)); } },
-		{ "__type", [this](service::ResolverParams&& params) { return resolve__type(std::move(params)); } })cpp";
-			}
-
-			sourceFile << R"cpp(
-	}))cpp";
-
-			if (objectType.type == queryType)
-			{
-				sourceFile << R"cpp(
-	, _schema(std::make_shared<)cpp" << s_introspectionNamespace
-					<< R"cpp(::Schema>()))cpp";
-			}
-
-			sourceFile << R"cpp(
-{
-)cpp";
-
-			if (objectType.type == queryType)
-			{
-				sourceFile << R"cpp(	)cpp" << s_introspectionNamespace
-					<< R"cpp(::AddTypesToSchema(_schema);
-	)cpp" << _schemaNamespace
-					<< R"cpp(::AddTypesToSchema(_schema);
-)cpp";
-			}
-
-			sourceFile << R"cpp(}
-)cpp";
-
-			// Output each of the resolver implementations, which call the virtual property
-			// getters that the implementer must define.
-			for (const auto& outputField : objectType.fields)
-			{
-				std::string fieldName(outputField.name);
-
-				fieldName[0] = std::toupper(fieldName[0]);
-				sourceFile << R"cpp(
-web::json::value )cpp" << objectType.type
-<< R"cpp(::resolve)cpp" << fieldName
-<< R"cpp((service::ResolverParams&& params)
-{
-)cpp";
-
-				// Output a preamble to retrieve all of the arguments from the resolver parameters.
-				if (!outputField.arguments.empty())
-				{
-					bool firstArgument = true;
-
-					for (const auto& argument : outputField.arguments)
-					{
-						if (!argument.defaultValue.is_null())
-						{
-							if (firstArgument)
-							{
-								firstArgument = false;
-								sourceFile << R"cpp(	static const auto defaultArguments = web::json::value::object({
-)cpp";
-							}
-							else
-							{
-								sourceFile << R"cpp(,
-)cpp";
-							}
-
-
-							utility::ostringstream_t defaultArguments;
-
-							defaultArguments << argument.defaultValue;
-							sourceFile << R"cpp(		{ _XPLATSTR(")cpp"
-								<< argument.name << R"cpp("), web::json::value::parse(_XPLATSTR(R"js()cpp"
-								<< utility::conversions::to_utf8string(defaultArguments.str()) << R"cpp()js")) })cpp";
-						}
-					}
-
-					if (!firstArgument)
-					{
-						sourceFile << R"cpp(
-	});
-
-)cpp";
-					}
-
-					for (const auto& argument : outputField.arguments)
-					{
-						std::string argumentName(argument.name);
-
-						argumentName[0] = std::toupper(argumentName[0]);
-						if (argument.defaultValue.is_null())
-						{
-							sourceFile << R"cpp(	auto arg)cpp" << argumentName
-								<< R"cpp( = )cpp" << getArgumentAccessType(argument)
-								<< R"cpp(::require(")cpp" << argument.name
-								<< R"cpp(", params.arguments);
-)cpp";
-						}
-						else
-						{
-							sourceFile << R"cpp(	auto pair)cpp" << argumentName
-								<< R"cpp( = )cpp" << getArgumentAccessType(argument)
-								<< R"cpp(::find(")cpp" << argument.name
-								<< R"cpp(", params.arguments);
-	auto arg)cpp" << argumentName << R"cpp( = (pair)cpp" << argumentName << R"cpp(.second
-		? std::move(pair)cpp" << argumentName << R"cpp(.first)
-		: )cpp" << getArgumentAccessType(argument)
-								<< R"cpp(::require(")cpp" << argument.name
-								<< R"cpp(", defaultArguments.as_object()));
-)cpp";
-						}
-					}
-				}
-
-				sourceFile << R"cpp(	auto result = get)cpp" << fieldName << R"cpp(()cpp";
-
-				if (!outputField.arguments.empty())
-				{
-					bool firstArgument = true;
-
-					for (const auto& argument : outputField.arguments)
-					{
-						if (!firstArgument)
-						{
-							sourceFile << R"cpp(, )cpp";
-						}
-
-						firstArgument = false;
-
-						std::string argumentName(argument.name);
-
-						argumentName[0] = std::toupper(argumentName[0]);
-						sourceFile << R"cpp(std::move(arg)cpp" << argumentName << R"cpp())cpp";
-					}
-				}
-
-				sourceFile << R"cpp();
-
-	return )cpp" << getResultAccessType(outputField) << R"cpp(::convert(result, std::move(params));
-}
-)cpp";
-			}
-
-			sourceFile << R"cpp(
-web::json::value )cpp" << objectType.type
-<< R"cpp(::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR(")cpp" << objectType.type << R"cpp("));
-}
-)cpp";
-
-			if (objectType.type == queryType)
-			{
-				sourceFile << R"cpp(
-web::json::value )cpp" << objectType.type
-<< R"cpp(::resolve__schema(service::ResolverParams&& params)
-{
-	auto result = service::ModifiedResult<introspection::Schema>::convert(_schema, std::move(params));
-
-	return result;
-}
-
-web::json::value )cpp" << objectType.type
-<< R"cpp(::resolve__type(service::ResolverParams&& params)
-{
-	auto argName = service::ModifiedArgument<std::string>::require("name", params.arguments);
-	auto result = service::ModifiedResult<introspection::object::__Type, service::TypeModifier::Nullable>::convert(_schema->LookupType(argName), std::move(params));
-
-	return result;
-}
-)cpp";
-			}
-		}
-
-		sourceFile << R"cpp(
-} /* namespace object */)cpp";
-	}
-
-	if (!_operationTypes.empty())
-	{
-		bool firstOperation = true;
-
-		sourceFile << R"cpp(
-
-Operations::Operations()cpp";
-
-		for (const auto& operation : _operationTypes)
-		{
-			if (!firstOperation)
-			{
-				sourceFile << R"cpp(, )cpp";
-			}
-
-			firstOperation = false;
-			sourceFile << R"cpp(std::shared_ptr<object::)cpp" << operation.type << R"cpp(> )cpp"
-				<< operation.operation;
-		}
-
-		sourceFile << R"cpp()
-	: service::Request({
-)cpp";
-
-		firstOperation = true;
-
-		for (const auto& operation : _operationTypes)
-		{
-			if (!firstOperation)
-			{
-				sourceFile << R"cpp(,
-)cpp";
-			}
-
-			firstOperation = false;
-			sourceFile << R"cpp(		{ ")cpp" << operation.operation
-				<< R"cpp(", )cpp" << operation.operation
-				<< R"cpp( })cpp";
-		}
-
-		sourceFile << R"cpp(
-	})
-)cpp";
-
-		for (const auto& operation : _operationTypes)
-		{
-			sourceFile << R"cpp(	, _)cpp" << operation.operation
-				<< R"cpp((std::move()cpp" << operation.operation
-				<< R"cpp())
-)cpp";
-		}
+		for (const auto& operation : _operationTypes)
+		{
+			sourceFile << R"cpp(	, _)cpp" << operation.operation
+				<< R"cpp((std::move()cpp" << operation.operation
+				<< R"cpp())
+)cpp";
+		}
 
 		sourceFile << R"cpp({
 }
@@ -1984,7 +1978,319 @@ Operations::Operations()cpp";
 } /* namespace graphql */
 } /* namespace facebook */)cpp";
 
-	return true;
+	return writeFile(_filenamePrefix + "Schema.cpp", sourceFile.str());
+}
+
+std::string Generator::getQueryType() const noexcept
+{
+	if (!_isIntrospection)
+	{
+		for (const auto& operation : _operationTypes)
+		{
+			if (operation.operation == "query")
+			{
+				return operation.type;
+			}
+		}
+	}
+
+	return {};
+}
+
+std::string Generator::getObjectSourceFilename(const ObjectType& objectType) const noexcept
+{
+	return _filenamePrefix + objectType.type + "Object.cpp";
+}
+
+bool Generator::outputObjectSource(const ObjectType& objectType) const noexcept
+{
+	std::ostringstream sourceFile;
+
+	sourceFile << R"cpp(// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include ")cpp" << _filenamePrefix << R"cpp(Schema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace )cpp" << _schemaNamespace << R"cpp( {
+namespace object {
+)cpp";
+
+	outputObjectImplementation(sourceFile, objectType, getQueryType());
+
+	sourceFile << R"cpp(
+} /* namespace object */
+} /* namespace )cpp" << _schemaNamespace << R"cpp( */
+} /* namespace graphql */
+} /* namespace facebook */)cpp";
+
+	return writeFile(getObjectSourceFilename(objectType), sourceFile.str());
+}
+
+void Generator::outputObjectImplementation(std::ostream& sourceFile, const ObjectType& objectType, const std::string& queryType) const noexcept
+{
+	// The fields are sorted by name so service::FieldTable can find them with a binary search,
+	// and resolveField dispatches to the resolver methods with a switch on the index.
+	std::vector<std::pair<std::string, std::string>> resolvers;
+	std::unordered_set<std::string> nullableFields;
+
+	for (const auto& outputField : objectType.fields)
+	{
+		std::string fieldName(outputField.name);
+
+		fieldName[0] = std::toupper(fieldName[0]);
+		resolvers.push_back({ outputField.name, fieldName });
+
+		if (!outputField.modifiers.empty()
+			&& outputField.modifiers.front() == service::TypeModifier::Nullable)
+		{
+			nullableFields.insert(outputField.name);
+		}
+	}
+
+	resolvers.push_back({ "__typename", "__typename" });
+
+	if (objectType.type == queryType)
+	{
+		resolvers.push_back({ "__schema", "__schema" });
+		resolvers.push_back({ "__type", "__type" });
+		nullableFields.insert("__type");
+	}
+
+	std::sort(resolvers.begin(), resolvers.end());
+
+	sourceFile << R"cpp(
+static const char* const s_)cpp" << objectType.type << R"cpp(Fields[] = {
+)cpp";
+
+	for (const auto& resolver : resolvers)
+	{
+		sourceFile << R"cpp(	")cpp" << resolver.first << R"cpp(",
+)cpp";
+	}
+
+	// Fields which are nullable in the schema resolve to null when they have an error, the
+	// rest pass the null on to the parent field.
+	sourceFile << R"cpp(};
+
+static const bool s_)cpp" << objectType.type << R"cpp(NullableFields[] = {
+)cpp";
+
+	for (const auto& resolver : resolvers)
+	{
+		sourceFile << R"cpp(	)cpp" << (nullableFields.count(resolver.first) > 0 ? "true" : "false") << R"cpp(,
+)cpp";
+	}
+
+	// Every instance shares the same service::ObjectType with the set of types it implements
+	// and the table of fields. It's a function local static so it's safe to construct objects
+	// during static initialization.
+	sourceFile << R"cpp(};
+
+static const service::ObjectType& get)cpp" << objectType.type << R"cpp(Type()
+{
+	static const service::ObjectType type {
+		")cpp" << objectType.type << R"cpp(",
+		{
+)cpp";
+
+	for (const auto& interfaceName : objectType.interfaces)
+	{
+		sourceFile << R"cpp(			")cpp" << interfaceName << R"cpp(",
+)cpp";
+	}
+
+	sourceFile << R"cpp(			")cpp" << objectType.type << R"cpp("
+		},
+		{ s_)cpp" << objectType.type << R"cpp(Fields, )cpp" << resolvers.size() << R"cpp(, s_)cpp" << objectType.type << R"cpp(NullableFields }
+	};
+
+	return type;
+}
+
+)cpp" << objectType.type << R"cpp(::)cpp" << objectType.type << R"cpp(()
+	: service::Object(get)cpp" << objectType.type << R"cpp(Type()))cpp";
+
+	if (objectType.type == queryType)
+	{
+		sourceFile << R"cpp(
+	, _schema(std::make_shared<)cpp" << s_introspectionNamespace
+			<< R"cpp(::Schema>()))cpp";
+	}
+
+	sourceFile << R"cpp(
+{
+)cpp";
+
+	if (objectType.type == queryType)
+	{
+		sourceFile << R"cpp(	)cpp" << s_introspectionNamespace
+			<< R"cpp(::AddTypesToSchema(_schema);
+	)cpp" << _schemaNamespace
+			<< R"cpp(::AddTypesToSchema(_schema);
+)cpp";
+	}
+
+	sourceFile << R"cpp(}
+
+std::future<web::json::value> )cpp" << objectType.type
+<< R"cpp(::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+)cpp";
+
+	for (size_t i = 0; i < resolvers.size(); ++i)
+	{
+		sourceFile << R"cpp(		case )cpp" << i << R"cpp(:
+			return resolve)cpp" << resolvers[i].second << R"cpp((std::move(params));
+
+)cpp";
+	}
+
+	sourceFile << R"cpp(		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+)cpp";
+
+	// Output each of the resolver implementations, which call the virtual property
+	// getters that the implementer must define.
+	for (const auto& outputField : objectType.fields)
+	{
+		std::string fieldName(outputField.name);
+
+		fieldName[0] = std::toupper(fieldName[0]);
+		sourceFile << R"cpp(
+std::future<web::json::value> )cpp" << objectType.type
+<< R"cpp(::resolve)cpp" << fieldName
+<< R"cpp((service::ResolverParams&& params) const
+{
+)cpp";
+
+		// Output a preamble to retrieve all of the arguments from the resolver parameters.
+		if (!outputField.arguments.empty())
+		{
+			bool firstArgument = true;
+
+			for (const auto& argument : outputField.arguments)
+			{
+				if (!argument.defaultValue.is_null())
+				{
+					std::string argumentName(argument.name);
+					utility::ostringstream_t defaultValue;
+
+					argumentName[0] = std::toupper(argumentName[0]);
+					firstArgument = false;
+					defaultValue << argument.defaultValue;
+					sourceFile << R"cpp(	static const auto default)cpp" << argumentName
+						<< R"cpp( = web::json::value::parse(_XPLATSTR(R"js()cpp"
+						<< utility::conversions::to_utf8string(defaultValue.str()) << R"cpp()js"));
+)cpp";
+				}
+			}
+
+			if (!firstArgument)
+			{
+				sourceFile << R"cpp(
+)cpp";
+			}
+
+			for (const auto& argument : outputField.arguments)
+			{
+				std::string argumentName(argument.name);
+
+				argumentName[0] = std::toupper(argumentName[0]);
+				sourceFile << R"cpp(	auto arg)cpp" << argumentName
+					<< R"cpp( = )cpp" << getArgumentAccessType(argument)
+					<< R"cpp(::require(")cpp" << argument.name
+					<< R"cpp(", params.arguments)cpp";
+
+				if (!argument.defaultValue.is_null())
+				{
+					sourceFile << R"cpp(, default)cpp" << argumentName;
+				}
+
+				sourceFile << R"cpp();
+)cpp";
+			}
+		}
+
+		// Fields on the query type without a @cacheControl directive could return anything,
+		// so they make the whole response uncacheable.
+		if (outputField.hasCacheHint
+			|| objectType.type == queryType)
+		{
+			sourceFile << R"cpp(	service::addCacheHint(params.operation, { )cpp" << outputField.cacheMaxAge
+				<< R"cpp(, service::CacheScope::)cpp" << (outputField.cachePrivate ? "Private" : "Public")
+				<< R"cpp( });
+)cpp";
+		}
+
+		sourceFile << R"cpp(	auto result = get)cpp" << fieldName << R"cpp((service::FieldParams { params.selection, params.operation })cpp";
+
+		for (const auto& argument : outputField.arguments)
+		{
+			std::string argumentName(argument.name);
+
+			argumentName[0] = std::toupper(argumentName[0]);
+			sourceFile << R"cpp(, std::move(arg)cpp" << argumentName << R"cpp())cpp";
+		}
+
+		sourceFile << R"cpp();
+
+	return )cpp" << getResultAccessType(outputField) << R"cpp(::convert(std::move(result), std::move(params));
+}
+)cpp";
+	}
+
+	sourceFile << R"cpp(
+std::future<web::json::value> )cpp" << objectType.type
+<< R"cpp(::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>(")cpp" << objectType.type << R"cpp("), std::move(params));
+}
+)cpp";
+
+	if (objectType.type == queryType)
+	{
+		sourceFile << R"cpp(
+std::future<web::json::value> )cpp" << objectType.type
+<< R"cpp(::resolve__schema(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<introspection::Schema>::convert(service::FieldResult<std::shared_ptr<introspection::Schema>>(_schema), std::move(params));
+}
+
+std::future<web::json::value> )cpp" << objectType.type
+<< R"cpp(::resolve__type(service::ResolverParams&& params) const
+{
+	auto argName = service::ModifiedArgument<std::string>::require("name", params.arguments);
+
+	return service::ModifiedResult<introspection::object::__Type, service::TypeModifier::Nullable>::convert(service::FieldResult<std::shared_ptr<introspection::object::__Type>>(_schema->LookupType(argName)), std::move(params));
+}
+)cpp";
+	}
+}
+
+// The list of files has one name on each line, so CMake can read it with file(STRINGS).
+bool Generator::outputFileList(const std::vector<std::string>& files) const noexcept
+{
+	std::ostringstream fileList;
+
+	for (const auto& file : files)
+	{
+		fileList << file << std::endl;
+	}
+
+	return writeFile(_filenamePrefix + "Schema.files", fileList.str());
 }
 
 std::string Generator::getArgumentAccessType(const InputField& argument) const noexcept
@@ -2035,9 +2341,28 @@ std::string Generator::getResultAccessType(const OutputField& result) const noex
 	size_t templateCount = 0;
 	std::ostringstream resultType;
 
+	if (isSharedList(result))
+	{
+		resultType << R"cpp(service::ModifiedResult<const )cpp" << getSharedListType(result);
+
+		if (result.modifiers.front() == service::TypeModifier::Nullable)
+		{
+			resultType << R"cpp(, service::TypeModifier::Nullable)cpp";
+		}
+
+		resultType << R"cpp(>)cpp";
+
+		return resultType.str();
+	}
+
 	resultType << R"cpp(service::ModifiedResult<)cpp";
 	++templateCount;
 
+	if (isSharedOutput(result))
+	{
+		resultType << R"cpp(const )cpp";
+	}
+
 	switch (result.fieldType)
 	{
 		case OutputFieldType::Builtin:
@@ -2175,10 +2500,30 @@ int main(int argc, char** argv)
 	}
 	else
 	{
-		if (argc != 4)
+		bool sharedStrings = false;
+		bool separateFiles = false;
+		bool validOptions = (argc >= 4);
+
+		for (int i = 4; validOptions && i < argc; ++i)
+		{
+			if (std::strcmp(argv[i], "--shared-strings") == 0)
+			{
+				sharedStrings = true;
+			}
+			else if (std::strcmp(argv[i], "--separate-files") == 0)
+			{
+				separateFiles = true;
+			}
+			else
+			{
+				validOptions = false;
+			}
+		}
+
+		if (!validOptions)
 		{
 			std::cerr << "Usage (to generate a custom schema): " << argv[0]
-				<< " <schema file> <output filename prefix> <output namespace>"
+				<< " <schema file> <output filename prefix> <output namespace> [--shared-strings] [--separate-files]"
 				<< std::endl;
 			std::cerr << "Usage (to generate IntrospectionSchema): " << argv[0] << std::endl;
 			return 1;
@@ -2193,7 +2538,7 @@ int main(int argc, char** argv)
 			return 1;
 		}
 
-		facebook::graphql::schema::Generator generator(schemaDefinition, argv[2], argv[3]);
+		facebook::graphql::schema::Generator generator(schemaDefinition, argv[2], argv[3], sharedStrings, separateFiles);
 		std::fclose(schemaDefinition);
 
 		files = generator.Build();
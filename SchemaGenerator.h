@@ -124,6 +124,11 @@ struct OutputField
 	InputFieldList arguments;
 	OutputFieldType fieldType = OutputFieldType::Builtin;
 	TypeModifierStack modifiers;
+
+	// From a @cacheControl(maxAge: Int, scope: PUBLIC | PRIVATE) directive on the field definition.
+	bool hasCacheHint = false;
+	size_t cacheMaxAge = 0;
+	bool cachePrivate = false;
 };
 
 using OutputFieldList = std::vector<OutputField>;
@@ -166,10 +171,13 @@ public:
 	// Initialize the generator with the introspection schema.
 	explicit Generator();
 
-	// Initialize the generator with the GraphQL schema and output parameters.
-	explicit Generator(FILE* schemaDefinition, std::string filenamePrefix, std::string schemaNamespace);
+	// Initialize the generator with the GraphQL schema and output parameters. If sharedStrings is
+	// set, String and ID getters return std::shared_ptr<const T> instead of a copy of the value. If
+	// separateFiles is set, each object type is implemented in its own source file.
+	explicit Generator(FILE* schemaDefinition, std::string filenamePrefix, std::string schemaNamespace, bool sharedStrings = false, bool separateFiles = false);
 
-	// Run the generator and return a list of filenames that were output.
+	// Run the generator and return a list of filenames that were output. Files which already have
+	// the same content are left alone, so their timestamps don't change.
 	std::vector<std::string> Build() const noexcept;
 
 private:
@@ -183,6 +191,7 @@ private:
 
 	static OutputFieldList getOutputFields(const std::vector<std::unique_ptr<ast::FieldDefinition>>& fields);
 	static InputFieldList getInputFields(const std::vector<std::unique_ptr<ast::InputValueDefinition>>& fields);
+	static void getCacheHint(const std::vector<std::unique_ptr<ast::Directive>>& directives, OutputField& field);
 
 	// Recursively visit a Type node until we reach a NamedType and we've
 	// taken stock of all of the modifier wrappers.
@@ -226,6 +235,9 @@ private:
 	bool fixupInputFieldList(InputFieldList& fields);
 
 	const std::string& getCppType(const std::string& type) const noexcept;
+	bool isSharedOutput(const OutputField& field) const noexcept;
+	bool isSharedList(const OutputField& field) const noexcept;
+	std::string getSharedListType(const OutputField& field) const noexcept;
 	std::string getInputCppType(const InputField& field) const noexcept;
 	std::string getOutputCppType(const OutputField& field) const noexcept;
 
@@ -235,6 +247,12 @@ private:
 	std::string getResolverDeclaration(const OutputField& outputField) const noexcept;
 
 	bool outputSource() const noexcept;
+	std::string getQueryType() const noexcept;
+	std::string getObjectSourceFilename(const ObjectType& objectType) const noexcept;
+	bool outputObjectSource(const ObjectType& objectType) const noexcept;
+	void outputObjectImplementation(std::ostream& sourceFile, const ObjectType& objectType, const std::string& queryType) const noexcept;
+	bool outputFileList(const std::vector<std::string>& files) const noexcept;
+	static bool writeFile(const std::string& filename, const std::string& content) noexcept;
 	std::string getArgumentAccessType(const InputField& argument) const noexcept;
 	std::string getResultAccessType(const OutputField& result) const noexcept;
 	std::string getIntrospectionType(const std::string& type, const TypeModifierStack& modifiers) const noexcept;
@@ -247,6 +265,8 @@ private:
 	const bool _isIntrospection;
 	const std::string _filenamePrefix;
 	const std::string _schemaNamespace;
+	const bool _sharedStrings;
+	const bool _separateFiles;
 
 	SchemaTypeMap _schemaTypes;
 	TypeNameMap _scalarNames;
@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Subscriptions.h"
+#include "DocumentCache.h"
+#include "Executor.h"
+#include "DataLoader.h"
+#include "Complexity.h"
+
+#include <algorithm>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+SubscriptionManager::SubscriptionManager(std::shared_ptr<const Request> request)
+	: _request(std::move(request))
+{
+}
+
+SubscriptionKey SubscriptionManager::subscribe(const std::string& query, const std::string& operationName, const web::json::object& variables, SubscriptionCallback&& callback)
+{
+	const auto& options = _request->getOptions();
+
+	// Parse, plan, and check the operation outside of the lock, it usually belongs to an existing
+	// group, but there's no way to tell until the variables are filled in.
+	auto document = options.documentCache
+		? options.documentCache->get(query)
+		: ParsedDocument::parse(query);
+
+	_request->validate(*document);
+
+	const auto& plan = document->getOperation(operationName);
+	const auto& operationDefinition = *plan.definition;
+	const std::string operation(operationDefinition.getOperation());
+
+	if (operation != "subscription")
+	{
+		const yy::location& location = operationDefinition.getLocation();
+		std::ostringstream error;
+
+		error << "Not a subscription operation: " << operation
+			<< " line: " << location.begin.line
+			<< " column: " << location.begin.column;
+
+		throw schema_exception({ error.str() });
+	}
+
+	if (plan.error)
+	{
+		throw *plan.error;
+	}
+
+	auto operationVariables = getOperationVariables(operationDefinition, variables);
+
+	if (options.complexityLimits)
+	{
+		checkComplexity(*plan.selection, operationVariables.as_object(), *options.complexityLimits);
+	}
+
+	std::ostringstream key;
+
+	key << operationName << '\n'
+		<< utility::conversions::to_utf8string(operationVariables.serialize()) << '\n'
+		<< query;
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& group = _groups[key.str()];
+
+	if (!group)
+	{
+		group = std::make_shared<Group>();
+		group->key = key.str();
+		group->document = std::move(document);
+		group->plan = &plan;
+		group->variables = std::move(operationVariables);
+
+		for (const auto& field : plan.selection->fields)
+		{
+			if (std::find(group->fieldNames.cbegin(), group->fieldNames.cend(), field.name) == group->fieldNames.cend())
+			{
+				group->fieldNames.push_back(field.name);
+			}
+		}
+	}
+
+	const auto subscriptionKey = _nextKey++;
+
+	group->callbacks[subscriptionKey] = std::move(callback);
+	_subscriptions[subscriptionKey] = group;
+
+	return subscriptionKey;
+}
+
+void SubscriptionManager::unsubscribe(SubscriptionKey key)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto itr = _subscriptions.find(key);
+
+	if (itr == _subscriptions.end())
+	{
+		return;
+	}
+
+	auto group = std::move(itr->second);
+
+	_subscriptions.erase(itr);
+	group->callbacks.erase(key);
+
+	if (group->callbacks.empty())
+	{
+		_groups.erase(group->key);
+	}
+}
+
+void SubscriptionManager::deliver(const std::string& fieldName, const std::shared_ptr<Object>& subscriptionObject) const
+{
+	std::vector<std::pair<std::shared_ptr<const Group>, std::vector<SubscriptionCallback>>> deliveries;
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		deliveries.reserve(_groups.size());
+
+		for (const auto& entry : _groups)
+		{
+			const auto& group = entry.second;
+
+			if (!fieldName.empty()
+				&& std::find(group->fieldNames.cbegin(), group->fieldNames.cend(), fieldName) == group->fieldNames.cend())
+			{
+				continue;
+			}
+
+			std::vector<SubscriptionCallback> callbacks;
+
+			callbacks.reserve(group->callbacks.size());
+
+			for (const auto& callback : group->callbacks)
+			{
+				callbacks.push_back(callback.second);
+			}
+
+			deliveries.emplace_back(group, std::move(callbacks));
+		}
+	}
+
+	// Resolve and call the subscribers outside of the lock, so they can subscribe or unsubscribe.
+	for (const auto& delivery : deliveries)
+	{
+		const auto payload = resolve(*delivery.first, subscriptionObject);
+
+		for (const auto& callback : delivery.second)
+		{
+			callback(payload);
+		}
+	}
+}
+
+size_t SubscriptionManager::getSubscriptionCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _subscriptions.size();
+}
+
+size_t SubscriptionManager::getGroupCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return _groups.size();
+}
+
+web::json::value SubscriptionManager::resolve(const Group& group, const std::shared_ptr<Object>& subscriptionObject) const
+{
+	const auto& options = _request->getOptions();
+	FieldErrors fieldErrors(options.metrics.get());
+
+	try
+	{
+		std::unique_ptr<OperationExecutor> executor;
+
+		if (options.executor)
+		{
+			executor.reset(new OperationExecutor(*options.executor, options.maxConcurrentTasks));
+		}
+
+		DataLoaderScope loaders;
+		ArgumentCache arguments;
+		auto arena = std::make_shared<RequestArena>();
+		OperationParams params { group.variables.as_object(), nullptr, std::launch::deferred, executor.get(), loaders, nullptr, *arena, nullptr, nullptr, options.parallelListThreshold, &arguments, &fieldErrors };
+		auto payload = web::json::value::object({
+			{ _XPLATSTR("data"), subscriptionObject->start(*group.plan->selection, params, nullptr).join() }
+			}, true);
+
+		if (!fieldErrors.empty())
+		{
+			payload[_XPLATSTR("errors")] = fieldErrors.takeErrors();
+		}
+
+		return payload;
+	}
+	catch (const schema_exception& ex)
+	{
+		return web::json::value::object({
+			{ _XPLATSTR("data"),  web::json::value::null() },
+			{ _XPLATSTR("errors"), fieldErrors.takeErrors(&ex) }
+			}, true);
+	}
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
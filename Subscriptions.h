@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <map>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+using SubscriptionKey = size_t;
+using SubscriptionCallback = std::function<void(const web::json::value& payload)>;
+
+// SubscriptionManager keeps track of the subscription operations registered by every client of a
+// Request. Each subscription is planned and has its variables filled in once when it's registered,
+// and every event only resolves its selection set against the object for that event. Subscribers
+// with the same query, operation name, and variables share a group, so each event is resolved once
+// for the whole group and all of them get the same payload. It's safe to subscribe, unsubscribe,
+// and deliver from multiple threads.
+class SubscriptionManager
+{
+public:
+	explicit SubscriptionManager(std::shared_ptr<const Request> request);
+
+	// Register a subscription and return the key to unsubscribe it. Throws a schema_exception if the
+	// query has errors, the operation isn't a subscription, or it's over the complexityLimits in the
+	// RequestOptions.
+	SubscriptionKey subscribe(const std::string& query, const std::string& operationName, const web::json::object& variables, SubscriptionCallback&& callback);
+
+	// Stop calling the subscriber. If an event is being delivered on another thread, it may still
+	// get that payload.
+	void unsubscribe(SubscriptionKey key);
+
+	// Resolve every subscription which selects the field against the object for this event, and
+	// call each of the subscribers with the payload. An empty field name goes to every subscription.
+	void deliver(const std::string& fieldName, const std::shared_ptr<Object>& subscriptionObject) const;
+
+	size_t getSubscriptionCount() const;
+	size_t getGroupCount() const;
+
+private:
+	struct Group
+	{
+		std::string key;
+		std::shared_ptr<const ParsedDocument> document;
+		const OperationPlan* plan;
+		web::json::value variables;
+		std::vector<std::string> fieldNames;
+		std::map<SubscriptionKey, SubscriptionCallback> callbacks;
+	};
+
+	web::json::value resolve(const Group& group, const std::shared_ptr<Object>& subscriptionObject) const;
+
+	const std::shared_ptr<const Request> _request;
+
+	mutable std::mutex _mutex;
+	SubscriptionKey _nextKey = 0;
+	std::unordered_map<std::string, std::shared_ptr<Group>> _groups;
+	std::unordered_map<SubscriptionKey, std::shared_ptr<Group>> _subscriptions;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
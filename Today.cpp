@@ -5,309 +5,222 @@
 
 #include <iostream>
 #include <algorithm>
+#include <map>
 
 namespace facebook {
 namespace graphql {
 namespace today {
 
 Appointment::Appointment(std::vector<unsigned char>&& id, std::string&& when, std::string&& subject, bool isNow)
-	: _id(std::move(id))
+	: _id(std::make_shared<const std::vector<unsigned char>>(std::move(id)))
 	, _when(std::move(when))
-	, _subject(std::move(subject))
+	, _subject(std::make_shared<const std::string>(std::move(subject)))
 	, _isNow(isNow)
 {
 }
 
 Task::Task(std::vector<unsigned char>&& id, std::string&& title, bool isComplete)
-	: _id(std::move(id))
-	, _title(std::move(title))
+	: _id(std::make_shared<const std::vector<unsigned char>>(std::move(id)))
+	, _title(std::make_shared<const std::string>(std::move(title)))
 	, _isComplete(isComplete)
 {
 }
 
 Folder::Folder(std::vector<unsigned char>&& id, std::string&& name, int unreadCount)
-	: _id(std::move(id))
-	, _name(std::move(name))
+	: _id(std::make_shared<const std::vector<unsigned char>>(std::move(id)))
+	, _name(std::make_shared<const std::string>(std::move(name)))
 	, _unreadCount(unreadCount)
 {
 }
 
-Query::Query(appointmentsLoader&& getAppointments, tasksLoader&& getTasks, unreadCountsLoader&& getUnreadCounts)
-	: _getAppointments(std::move(getAppointments))
-	, _getTasks(std::move(getTasks))
-	, _getUnreadCounts(getUnreadCounts)
-{
-}
-
-void Query::loadAppointments() const
+// Each id is a binary search in the index, instead of a scan over all of the objects.
+template <class _Result, class _Object>
+void findById(const service::ConnectionIndex<_Object>& index, const std::vector<std::vector<unsigned char>>& ids, std::vector<std::shared_ptr<_Result>>& results)
 {
-	if (_getAppointments)
+	for (size_t i = 0; i < ids.size(); ++i)
 	{
-		_appointments = _getAppointments();
-		_getAppointments = nullptr;
+		if (!results[i])
+		{
+			results[i] = index.find(ids[i]);
+		}
 	}
 }
 
-std::shared_ptr<Appointment> Query::findAppointment(const std::vector<unsigned char>& id) const
+// Index the objects by id once when they're loaded, and reuse it for every page and lookup.
+template <class _Object>
+service::ConnectionIndex<_Object> makeIndex(std::vector<std::shared_ptr<_Object>>&& objects)
 {
-	loadAppointments();
-
-	for (const auto& appointment : _appointments)
+	return service::ConnectionIndex<_Object>(std::move(objects),
+		[](const _Object& object) -> const std::vector<unsigned char>&
 	{
-		auto appointmentId = appointment->getId();
-
-		if (appointmentId == id)
-		{
-			return appointment;
-		}
-	}
-
-	return nullptr;
+		return object.id();
+	});
 }
 
-void Query::loadTasks() const
+Query::Query(appointmentsLoader&& getAppointments, tasksLoader&& getTasks, unreadCountsLoader&& getUnreadCounts)
+	: _nodeLoader([this](const std::vector<std::vector<unsigned char>>& ids) { return findNodes(ids); })
+	, _appointmentLoader([this](const std::vector<std::vector<unsigned char>>& ids) { return findAppointments(ids); })
+	, _taskLoader([this](const std::vector<std::vector<unsigned char>>& ids) { return findTasks(ids); })
+	, _unreadCountLoader([this](const std::vector<std::vector<unsigned char>>& ids) { return findUnreadCounts(ids); })
+	, _getAppointments(std::move(getAppointments))
+	, _getTasks(std::move(getTasks))
+	, _getUnreadCounts(std::move(getUnreadCounts))
+	, _appointments([this]() { return makeIndex(_getAppointments()); })
+	, _tasks([this]() { return makeIndex(_getTasks()); })
+	, _unreadCounts([this]() { return makeIndex(_getUnreadCounts()); })
 {
-	if (_getTasks)
-	{
-		_tasks = _getTasks();
-		_getTasks = nullptr;
-	}
 }
 
-std::shared_ptr<Task> Query::findTask(const std::vector<unsigned char>& id) const
+// The rest of a connection doesn't depend on the nodes, so it doesn't need to load them if neither
+// the edges nor the pageInfo are selected, e.g. if it only selects __typename. The arguments are
+// still checked, so the same query always has the same errors.
+static bool needsNodes(const service::FieldParams& params, const int* first, const web::json::value* after, const int* last, const web::json::value* before)
 {
-	loadTasks();
+	const auto lookahead = params.lookahead();
 
-	for (const auto& task : _tasks)
+	if (lookahead.isSelected("edges")
+		|| lookahead.isSelected("pageInfo"))
 	{
-		auto taskId = task->getId();
-
-		if (taskId == id)
-		{
-			return task;
-		}
+		return true;
 	}
 
-	return nullptr;
-}
-
-void Query::loadUnreadCounts() const
-{
-	if (_getUnreadCounts)
+	if (first)
 	{
-		_unreadCounts = _getUnreadCounts();
-		_getUnreadCounts = nullptr;
+		service::checkPageSize("first", *first);
 	}
-}
 
-std::shared_ptr<Folder> Query::findUnreadCount(const std::vector<unsigned char>& id) const
-{
-	loadUnreadCounts();
+	if (after)
+	{
+		service::parseCursor("after", *after);
+	}
 
-	for (const auto& folder : _unreadCounts)
+	if (last)
 	{
-		auto folderId = folder->getId();
+		service::checkPageSize("last", *last);
+	}
 
-		if (folderId == id)
-		{
-			return folder;
-		}
+	if (before)
+	{
+		service::parseCursor("before", *before);
 	}
 
-	return nullptr;
+	return false;
 }
 
-std::shared_ptr<service::Object> Query::getNode(std::vector<unsigned char>&& id) const
+template <class _Object>
+service::ConnectionSlice<_Object> emptySlice()
 {
-	auto appointment = findAppointment(id);
+	return { std::make_shared<const typename service::ConnectionSlice<_Object>::NodeList>(), 0, 0, false, false };
+}
 
-	if (appointment)
+std::vector<std::shared_ptr<service::Object>> Query::findNodes(const std::vector<std::vector<unsigned char>>& ids) const
+{
+	std::vector<std::shared_ptr<service::Object>> result(ids.size());
+	const auto missing = [&result]()
 	{
-		return appointment;
-	}
+		return std::any_of(result.cbegin(), result.cend(),
+			[](const std::shared_ptr<service::Object>& node)
+		{
+			return !node;
+		});
+	};
 
-	auto task = findTask(id);
+	findById(_appointments.get(), ids, result);
 
-	if (task)
+	if (missing())
 	{
-		return task;
+		findById(_tasks.get(), ids, result);
 	}
 
-	auto folder = findUnreadCount(id);
-
-	if (folder)
+	if (missing())
 	{
-		return folder;
+		findById(_unreadCounts.get(), ids, result);
 	}
 
-	return nullptr;
+	return result;
 }
 
-template <class _Object, class _Connection>
-struct EdgeConstraints
+std::vector<std::shared_ptr<object::Appointment>> Query::findAppointments(const std::vector<std::vector<unsigned char>>& ids) const
 {
-	using vec_type = std::vector<std::shared_ptr<_Object>>;
-	using itr_type = typename vec_type::const_iterator;
-
-	EdgeConstraints(const vec_type& objects)
-		: _objects(objects)
-	{
-	}
+	std::vector<std::shared_ptr<object::Appointment>> result(ids.size());
 
-	std::shared_ptr<_Connection> operator()(const int* first, const web::json::value* after, const int* last, const web::json::value* before) const
-	{
-		auto itrFirst = _objects.cbegin();
-		auto itrLast = _objects.cend();
+	findById(_appointments.get(), ids, result);
 
-		if (after)
-		{
-			auto value = web::json::value::object({
-				{ _XPLATSTR("after"), *after }
-				});
-
-			auto afterId = service::IdArgument<>::require("after", value.as_object());
-			auto itrAfter = std::find_if(itrFirst, itrLast,
-				[&afterId](const std::shared_ptr<_Object>& entry)
-			{
-				return entry->getId() == afterId;
-			});
-
-			if (itrAfter != itrLast)
-			{
-				itrFirst = itrAfter;
-			}
-		}
+	return result;
+}
 
-		if (before)
-		{
-			auto value = web::json::value::object({
-				{ _XPLATSTR("before"), *before }
-				});
-
-			auto beforeId = service::IdArgument<>::require("before", value.as_object());
-			auto itrBefore = std::find_if(itrFirst, itrLast,
-				[&beforeId](const std::shared_ptr<_Object>& entry)
-			{
-				return entry->getId() == beforeId;
-			});
-
-			if (itrBefore != itrLast)
-			{
-				itrLast = itrBefore;
-				++itrLast;
-			}
-		}
+std::vector<std::shared_ptr<object::Task>> Query::findTasks(const std::vector<std::vector<unsigned char>>& ids) const
+{
+	std::vector<std::shared_ptr<object::Task>> result(ids.size());
 
-		if (first)
-		{
-			if (*first < 0)
-			{
-				std::ostringstream error;
-
-				error << "Invalid argument: first value: " << *first;
-				throw service::schema_exception({ error.str() });
-			}
-
-			if (itrLast - itrFirst > *first)
-			{
-				itrLast = itrFirst + *first;
-			}
-		}
+	findById(_tasks.get(), ids, result);
 
-		if (last)
-		{
-			if (*last < 0)
-			{
-				std::ostringstream error;
-
-				error << "Invalid argument: last value: " << *last;
-				throw service::schema_exception({ error.str() });
-			}
-
-			if (itrLast - itrFirst > *last)
-			{
-				itrFirst = itrLast - *last;
-			}
-		}
+	return result;
+}
 
-		std::vector<std::shared_ptr<_Object>> edges(itrLast - itrFirst);
+std::vector<std::shared_ptr<object::Folder>> Query::findUnreadCounts(const std::vector<std::vector<unsigned char>>& ids) const
+{
+	std::vector<std::shared_ptr<object::Folder>> result(ids.size());
 
-		std::copy(itrFirst, itrLast, edges.begin());
+	findById(_unreadCounts.get(), ids, result);
 
-		return std::make_shared<_Connection>(itrLast < _objects.cend(), itrFirst > _objects.cbegin(), std::move(edges));
-	}
+	return result;
+}
 
-private:
-	const vec_type& _objects;
-};
+service::FieldResult<std::shared_ptr<service::Object>> Query::getNode(service::FieldParams&& params, std::vector<unsigned char>&& id) const
+{
+	return _nodeLoader.load(params, id);
+}
 
-std::shared_ptr<object::AppointmentConnection> Query::getAppointments(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
+service::FieldResult<std::shared_ptr<object::AppointmentConnection>> Query::getAppointments(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
 {
-	loadAppointments();
+	if (!needsNodes(params, first.get(), after.get(), last.get(), before.get()))
+	{
+		return std::static_pointer_cast<object::AppointmentConnection>(std::make_shared<AppointmentConnection>(emptySlice<Appointment>()));
+	}
 
-	EdgeConstraints<Appointment, AppointmentConnection> constraints(_appointments);
-	auto connection = constraints(first.get(), after.get(), last.get(), before.get());
+	auto connection = std::make_shared<AppointmentConnection>(_appointments.get().slice(first.get(), after.get(), last.get(), before.get()));
 
 	return std::static_pointer_cast<object::AppointmentConnection>(connection);
 }
 
-std::shared_ptr<object::TaskConnection> Query::getTasks(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
+service::FieldResult<std::shared_ptr<object::TaskConnection>> Query::getTasks(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
 {
-	loadTasks();
+	if (!needsNodes(params, first.get(), after.get(), last.get(), before.get()))
+	{
+		return std::static_pointer_cast<object::TaskConnection>(std::make_shared<TaskConnection>(emptySlice<Task>()));
+	}
 
-	EdgeConstraints<Task, TaskConnection> constraints(_tasks);
-	auto connection = constraints(first.get(), after.get(), last.get(), before.get());
+	auto connection = std::make_shared<TaskConnection>(_tasks.get().slice(first.get(), after.get(), last.get(), before.get()));
 
 	return std::static_pointer_cast<object::TaskConnection>(connection);
 }
 
-std::shared_ptr<object::FolderConnection> Query::getUnreadCounts(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
+service::FieldResult<std::shared_ptr<object::FolderConnection>> Query::getUnreadCounts(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const
 {
-	loadUnreadCounts();
+	if (!needsNodes(params, first.get(), after.get(), last.get(), before.get()))
+	{
+		return std::static_pointer_cast<object::FolderConnection>(std::make_shared<FolderConnection>(emptySlice<Folder>()));
+	}
 
-	EdgeConstraints<Folder, FolderConnection> constraints(_unreadCounts);
-	auto connection = constraints(first.get(), after.get(), last.get(), before.get());
+	auto connection = std::make_shared<FolderConnection>(_unreadCounts.get().slice(first.get(), after.get(), last.get(), before.get()));
 
 	return std::static_pointer_cast<object::FolderConnection>(connection);
 }
 
-std::vector<std::shared_ptr<object::Appointment>> Query::getAppointmentsById(std::vector<std::vector<unsigned char>>&& ids) const
+service::FieldResult<std::vector<std::shared_ptr<object::Appointment>>> Query::getAppointmentsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const
 {
-	std::vector<std::shared_ptr<object::Appointment>> result(ids.size());
-
-	std::transform(ids.cbegin(), ids.cend(), result.begin(),
-		[this](const std::vector<unsigned char>& id)
-	{
-		return std::static_pointer_cast<object::Appointment>(findAppointment(id));
-	});
-
-	return result;
+	return _appointmentLoader.loadMany(params, ids);
 }
 
-std::vector<std::shared_ptr<object::Task>> Query::getTasksById(std::vector<std::vector<unsigned char>>&& ids) const
+service::FieldResult<std::vector<std::shared_ptr<object::Task>>> Query::getTasksById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const
 {
-	std::vector<std::shared_ptr<object::Task>> result(ids.size());
-
-	std::transform(ids.cbegin(), ids.cend(), result.begin(),
-		[this](const std::vector<unsigned char>& id)
-	{
-		return std::static_pointer_cast<object::Task>(findTask(id));
-	});
-
-	return result;
+	return _taskLoader.loadMany(params, ids);
 }
 
-std::vector<std::shared_ptr<object::Folder>> Query::getUnreadCountsById(std::vector<std::vector<unsigned char>>&& ids) const
+service::FieldResult<std::vector<std::shared_ptr<object::Folder>>> Query::getUnreadCountsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const
 {
-	std::vector<std::shared_ptr<object::Folder>> result(ids.size());
-
-	std::transform(ids.cbegin(), ids.cend(), result.begin(),
-		[this](const std::vector<unsigned char>& id)
-	{
-		return std::static_pointer_cast<object::Folder>(findUnreadCount(id));
-	});
-
-	return result;
+	return _unreadCountLoader.loadMany(params, ids);
 }
 
 Mutation::Mutation(completeTaskMutation&& mutateCompleteTask)
@@ -315,7 +228,7 @@ Mutation::Mutation(completeTaskMutation&& mutateCompleteTask)
 {
 }
 
-std::shared_ptr<object::CompleteTaskPayload> Mutation::getCompleteTask(CompleteTaskInput&& input) const
+service::FieldResult<std::shared_ptr<object::CompleteTaskPayload>> Mutation::getCompleteTask(service::FieldParams&& /*params*/, CompleteTaskInput&& input) const
 {
 	return _mutateCompleteTask(std::move(input));
 }
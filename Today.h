@@ -4,6 +4,9 @@
 #pragma once
 
 #include "TodaySchema.h"
+#include "DataLoader.h"
+#include "Pagination.h"
+#include "Lazy.h"
 
 namespace facebook {
 namespace graphql {
@@ -22,31 +25,35 @@ public:
 
 	explicit Query(appointmentsLoader&& getAppointments, tasksLoader&& getTasks, unreadCountsLoader&& getUnreadCounts);
 
-	std::shared_ptr<service::Object> getNode(std::vector<unsigned char>&& id) const override;
-	std::shared_ptr<object::AppointmentConnection> getAppointments(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
-	std::shared_ptr<object::TaskConnection> getTasks(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
-	std::shared_ptr<object::FolderConnection> getUnreadCounts(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
-	std::vector<std::shared_ptr<object::Appointment>> getAppointmentsById(std::vector<std::vector<unsigned char>>&& ids) const override;
-	std::vector<std::shared_ptr<object::Task>> getTasksById(std::vector<std::vector<unsigned char>>&& ids) const override;
-	std::vector<std::shared_ptr<object::Folder>> getUnreadCountsById(std::vector<std::vector<unsigned char>>&& ids) const override;
+	service::FieldResult<std::shared_ptr<service::Object>> getNode(service::FieldParams&& params, std::vector<unsigned char>&& id) const override;
+	service::FieldResult<std::shared_ptr<object::AppointmentConnection>> getAppointments(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
+	service::FieldResult<std::shared_ptr<object::TaskConnection>> getTasks(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
+	service::FieldResult<std::shared_ptr<object::FolderConnection>> getUnreadCounts(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const override;
+	service::FieldResult<std::vector<std::shared_ptr<object::Appointment>>> getAppointmentsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const override;
+	service::FieldResult<std::vector<std::shared_ptr<object::Task>>> getTasksById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const override;
+	service::FieldResult<std::vector<std::shared_ptr<object::Folder>>> getUnreadCountsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const override;
 
 private:
-	std::shared_ptr<Appointment> findAppointment(const std::vector<unsigned char>& id) const;
-	std::shared_ptr<Task> findTask(const std::vector<unsigned char>& id) const;
-	std::shared_ptr<Folder> findUnreadCount(const std::vector<unsigned char>& id) const;
-
-	// Lazy load the fields in each query
-	void loadAppointments() const;
-	void loadTasks() const;
-	void loadUnreadCounts() const;
-
-	mutable appointmentsLoader _getAppointments;
-	mutable tasksLoader _getTasks;
-	mutable unreadCountsLoader _getUnreadCounts;
-
-	mutable std::vector<std::shared_ptr<Appointment>> _appointments;
-	mutable std::vector<std::shared_ptr<Task>> _tasks;
-	mutable std::vector<std::shared_ptr<Folder>> _unreadCounts;
+	// Batch loaders for ids
+	std::vector<std::shared_ptr<service::Object>> findNodes(const std::vector<std::vector<unsigned char>>& ids) const;
+	std::vector<std::shared_ptr<object::Appointment>> findAppointments(const std::vector<std::vector<unsigned char>>& ids) const;
+	std::vector<std::shared_ptr<object::Task>> findTasks(const std::vector<std::vector<unsigned char>>& ids) const;
+	std::vector<std::shared_ptr<object::Folder>> findUnreadCounts(const std::vector<std::vector<unsigned char>>& ids) const;
+
+	const service::DataLoader<std::vector<unsigned char>, std::shared_ptr<service::Object>> _nodeLoader;
+	const service::DataLoader<std::vector<unsigned char>, std::shared_ptr<object::Appointment>> _appointmentLoader;
+	const service::DataLoader<std::vector<unsigned char>, std::shared_ptr<object::Task>> _taskLoader;
+	const service::DataLoader<std::vector<unsigned char>, std::shared_ptr<object::Folder>> _unreadCountLoader;
+
+	const appointmentsLoader _getAppointments;
+	const tasksLoader _getTasks;
+	const unreadCountsLoader _getUnreadCounts;
+
+	// Each collection is loaded and indexed the first time a request needs it, and then it's shared
+	// by every request on every thread.
+	const service::Lazy<service::ConnectionIndex<Appointment>> _appointments;
+	const service::Lazy<service::ConnectionIndex<Task>> _tasks;
+	const service::Lazy<service::ConnectionIndex<Folder>> _unreadCounts;
 };
 
 class PageInfo : public object::PageInfo
@@ -58,12 +65,12 @@ public:
 	{
 	}
 
-	bool getHasNextPage() const override
+	service::FieldResult<bool> getHasNextPage(service::FieldParams&& /*params*/) const override
 	{
 		return _hasNextPage;
 	}
 
-	bool getHasPreviousPage() const override
+	service::FieldResult<bool> getHasPreviousPage(service::FieldParams&& /*params*/) const override
 	{
 		return _hasPreviousPage;
 	}
@@ -78,15 +85,18 @@ class Appointment : public object::Appointment
 public:
 	explicit Appointment(std::vector<unsigned char>&& id, std::string&& when, std::string&& subject, bool isNow);
 
-	std::vector<unsigned char> getId() const override { return _id; }
-	std::unique_ptr<web::json::value> getWhen() const override{ return std::unique_ptr<web::json::value>(new web::json::value(web::json::value::string(utility::conversions::to_string_t(_when)))); }
-	std::unique_ptr<std::string> getSubject() const override { return std::unique_ptr<std::string>(new std::string(_subject)); }
-	bool getIsNow() const override { return _isNow; }
+	// Internal lookups and cursors use the id directly instead of calling the getter.
+	const std::vector<unsigned char>& id() const { return *_id; }
+
+	service::FieldResult<std::shared_ptr<const std::vector<unsigned char>>> getId(service::FieldParams&& /*params*/) const override { return _id; }
+	service::FieldResult<std::unique_ptr<web::json::value>> getWhen(service::FieldParams&& /*params*/) const override{ return std::unique_ptr<web::json::value>(new web::json::value(web::json::value::string(utility::conversions::to_string_t(_when)))); }
+	service::FieldResult<std::shared_ptr<const std::string>> getSubject(service::FieldParams&& /*params*/) const override { return _subject; }
+	service::FieldResult<bool> getIsNow(service::FieldParams&& /*params*/) const override { return _isNow; }
 
 private:
-	std::vector<unsigned char> _id;
+	std::shared_ptr<const std::vector<unsigned char>> _id;
 	std::string _when;
-	std::string _subject;
+	std::shared_ptr<const std::string> _subject;
 	bool _isNow;
 };
 
@@ -98,14 +108,14 @@ public:
 	{
 	}
 
-	std::shared_ptr<object::Appointment> getNode() const override
+	service::FieldResult<std::shared_ptr<object::Appointment>> getNode(service::FieldParams&& /*params*/) const override
 	{
 		return std::static_pointer_cast<object::Appointment>(_appointment);
 	}
 
-	web::json::value getCursor() const override
+	service::FieldResult<web::json::value> getCursor(service::FieldParams&& /*params*/) const override
 	{
-		return web::json::value::string(utility::conversions::to_base64(_appointment->getId()));
+		return service::makeCursor(_appointment->id());
 	}
 
 private:
@@ -115,25 +125,25 @@ private:
 class AppointmentConnection : public object::AppointmentConnection
 {
 public:
-	explicit AppointmentConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Appointment>> appointments)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
+	explicit AppointmentConnection(service::ConnectionSlice<Appointment>&& appointments)
+		: _pageInfo(std::make_shared<PageInfo>(appointments.hasNextPage, appointments.hasPreviousPage))
 		, _appointments(std::move(appointments))
 	{
 	}
 
-	std::shared_ptr<object::PageInfo> getPageInfo() const override
+	service::FieldResult<std::shared_ptr<object::PageInfo>> getPageInfo(service::FieldParams&& /*params*/) const override
 	{
 		return _pageInfo;
 	}
 
-	std::unique_ptr<std::vector<std::shared_ptr<object::AppointmentEdge>>> getEdges() const override
+	service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<object::AppointmentEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
 		auto result = std::unique_ptr<std::vector<std::shared_ptr<object::AppointmentEdge>>>(new std::vector<std::shared_ptr<object::AppointmentEdge>>(_appointments.size()));
 
 		std::transform(_appointments.cbegin(), _appointments.cend(), result->begin(),
-			[](const std::shared_ptr<Appointment>& node)
+			[&params](const std::shared_ptr<Appointment>& node)
 		{
-			return std::make_shared<AppointmentEdge>(node);
+			return params.operation.arena.make_shared<AppointmentEdge>(node);
 		});
 
 		return result;
@@ -141,7 +151,7 @@ public:
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
-	std::vector<std::shared_ptr<Appointment>> _appointments;
+	service::ConnectionSlice<Appointment> _appointments;
 };
 
 class Task : public object::Task
@@ -149,13 +159,15 @@ class Task : public object::Task
 public:
 	explicit Task(std::vector<unsigned char>&& id, std::string&& title, bool isComplete);
 
-	std::vector<unsigned char> getId() const override { return _id; }
-	std::unique_ptr<std::string> getTitle() const override { return std::unique_ptr<std::string>(new std::string(_title)); }
-	bool getIsComplete() const override { return _isComplete; }
+	const std::vector<unsigned char>& id() const { return *_id; }
+
+	service::FieldResult<std::shared_ptr<const std::vector<unsigned char>>> getId(service::FieldParams&& /*params*/) const override { return _id; }
+	service::FieldResult<std::shared_ptr<const std::string>> getTitle(service::FieldParams&& /*params*/) const override { return _title; }
+	service::FieldResult<bool> getIsComplete(service::FieldParams&& /*params*/) const override { return _isComplete; }
 
 private:
-	std::vector<unsigned char> _id;
-	std::string _title;
+	std::shared_ptr<const std::vector<unsigned char>> _id;
+	std::shared_ptr<const std::string> _title;
 	bool _isComplete;
 	TaskState _state = TaskState::New;
 };
@@ -168,14 +180,14 @@ public:
 	{
 	}
 
-	std::shared_ptr<object::Task> getNode() const override
+	service::FieldResult<std::shared_ptr<object::Task>> getNode(service::FieldParams&& /*params*/) const override
 	{
 		return std::static_pointer_cast<object::Task>(_task);
 	}
 
-	web::json::value getCursor() const override
+	service::FieldResult<web::json::value> getCursor(service::FieldParams&& /*params*/) const override
 	{
-		return web::json::value::string(utility::conversions::to_base64(_task->getId()));
+		return service::makeCursor(_task->id());
 	}
 
 private:
@@ -185,25 +197,25 @@ private:
 class TaskConnection : public object::TaskConnection
 {
 public:
-	explicit TaskConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Task>> tasks)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
+	explicit TaskConnection(service::ConnectionSlice<Task>&& tasks)
+		: _pageInfo(std::make_shared<PageInfo>(tasks.hasNextPage, tasks.hasPreviousPage))
 		, _tasks(std::move(tasks))
 	{
 	}
 
-	std::shared_ptr<object::PageInfo> getPageInfo() const override
+	service::FieldResult<std::shared_ptr<object::PageInfo>> getPageInfo(service::FieldParams&& /*params*/) const override
 	{
 		return _pageInfo;
 	}
 
-	std::unique_ptr<std::vector<std::shared_ptr<object::TaskEdge>>> getEdges() const override
+	service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<object::TaskEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
 		auto result = std::unique_ptr<std::vector<std::shared_ptr<object::TaskEdge>>>(new std::vector<std::shared_ptr<object::TaskEdge>>(_tasks.size()));
 
 		std::transform(_tasks.cbegin(), _tasks.cend(), result->begin(),
-			[](const std::shared_ptr<Task>& node)
+			[&params](const std::shared_ptr<Task>& node)
 		{
-			return std::make_shared<TaskEdge>(node);
+			return params.operation.arena.make_shared<TaskEdge>(node);
 		});
 
 		return result;
@@ -211,7 +223,7 @@ public:
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
-	std::vector<std::shared_ptr<Task>> _tasks;
+	service::ConnectionSlice<Task> _tasks;
 };
 
 class Folder : public object::Folder
@@ -219,13 +231,15 @@ class Folder : public object::Folder
 public:
 	explicit Folder(std::vector<unsigned char>&& id, std::string&& name, int unreadCount);
 
-	std::vector<unsigned char> getId() const override { return _id; }
-	std::unique_ptr<std::string> getName() const override { return std::unique_ptr<std::string>(new std::string(_name)); }
-	int getUnreadCount() const override { return _unreadCount; }
+	const std::vector<unsigned char>& id() const { return *_id; }
+
+	service::FieldResult<std::shared_ptr<const std::vector<unsigned char>>> getId(service::FieldParams&& /*params*/) const override { return _id; }
+	service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& /*params*/) const override { return _name; }
+	service::FieldResult<int> getUnreadCount(service::FieldParams&& /*params*/) const override { return _unreadCount; }
 
 private:
-	std::vector<unsigned char> _id;
-	std::string _name;
+	std::shared_ptr<const std::vector<unsigned char>> _id;
+	std::shared_ptr<const std::string> _name;
 	int _unreadCount;
 };
 
@@ -237,14 +251,14 @@ public:
 	{
 	}
 
-	std::shared_ptr<object::Folder> getNode() const override
+	service::FieldResult<std::shared_ptr<object::Folder>> getNode(service::FieldParams&& /*params*/) const override
 	{
 		return std::static_pointer_cast<object::Folder>(_folder);
 	}
 
-	web::json::value getCursor() const override
+	service::FieldResult<web::json::value> getCursor(service::FieldParams&& /*params*/) const override
 	{
-		return web::json::value::string(utility::conversions::to_base64(_folder->getId()));
+		return service::makeCursor(_folder->id());
 	}
 
 private:
@@ -254,25 +268,25 @@ private:
 class FolderConnection : public object::FolderConnection
 {
 public:
-	explicit FolderConnection(bool hasNextPage, bool hasPreviousPage, std::vector<std::shared_ptr<Folder>> folders)
-		: _pageInfo(std::make_shared<PageInfo>(hasNextPage, hasPreviousPage))
+	explicit FolderConnection(service::ConnectionSlice<Folder>&& folders)
+		: _pageInfo(std::make_shared<PageInfo>(folders.hasNextPage, folders.hasPreviousPage))
 		, _folders(std::move(folders))
 	{
 	}
 
-	std::shared_ptr<object::PageInfo> getPageInfo() const override
+	service::FieldResult<std::shared_ptr<object::PageInfo>> getPageInfo(service::FieldParams&& /*params*/) const override
 	{
 		return _pageInfo;
 	}
 
-	std::unique_ptr<std::vector<std::shared_ptr<object::FolderEdge>>> getEdges() const override
+	service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<object::FolderEdge>>>> getEdges(service::FieldParams&& params) const override
 	{
 		auto result = std::unique_ptr<std::vector<std::shared_ptr<object::FolderEdge>>>(new std::vector<std::shared_ptr<object::FolderEdge>>(_folders.size()));
 
 		std::transform(_folders.cbegin(), _folders.cend(), result->begin(),
-			[](const std::shared_ptr<Folder>& node)
+			[&params](const std::shared_ptr<Folder>& node)
 		{
-			return std::make_shared<FolderEdge>(node);
+			return params.operation.arena.make_shared<FolderEdge>(node);
 		});
 
 		return result;
@@ -280,7 +294,7 @@ public:
 
 private:
 	std::shared_ptr<PageInfo> _pageInfo;
-	std::vector<std::shared_ptr<Folder>> _folders;
+	service::ConnectionSlice<Folder> _folders;
 };
 
 class CompleteTaskPayload : public object::CompleteTaskPayload
@@ -292,21 +306,19 @@ public:
 	{
 	}
 
-	std::shared_ptr<object::Task> getTask() const override
+	service::FieldResult<std::shared_ptr<object::Task>> getTask(service::FieldParams&& /*params*/) const override
 	{
 		return std::static_pointer_cast<object::Task>(_task);
 	}
 
-	std::unique_ptr<std::string> getClientMutationId() const override
+	service::FieldResult<std::shared_ptr<const std::string>> getClientMutationId(service::FieldParams&& /*params*/) const override
 	{
-		return std::unique_ptr<std::string>(_clientMutationId
-			? new std::string(*_clientMutationId)
-			: nullptr);
+		return _clientMutationId;
 	}
 
 private:
 	std::shared_ptr<Task> _task;
-	std::unique_ptr<std::string> _clientMutationId;
+	std::shared_ptr<const std::string> _clientMutationId;
 };
 
 class Mutation : public object::Mutation
@@ -316,7 +328,7 @@ public:
 
 	explicit Mutation(completeTaskMutation&& mutateCompleteTask);
 
-	std::shared_ptr<object::CompleteTaskPayload> getCompleteTask(CompleteTaskInput&& input) const override;
+	service::FieldResult<std::shared_ptr<object::CompleteTaskPayload>> getCompleteTask(service::FieldParams&& params, CompleteTaskInput&& input) const override;
 
 private:
 	completeTaskMutation _mutateCompleteTask;
@@ -327,7 +339,7 @@ class Subscription : public object::Subscription
 public:
 	explicit Subscription() = default;
 
-	std::shared_ptr<object::Appointment> getNextAppointmentChange() const override
+	service::FieldResult<std::shared_ptr<object::Appointment>> getNextAppointmentChange(service::FieldParams&& /*params*/) const override
 	{
 		return nullptr;
 	}
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Tracing.h"
+
+#include <ctime>
+#include <iomanip>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+FieldTracer::~FieldTracer()
+{
+}
+
+Instrumentation::~Instrumentation()
+{
+}
+
+std::unique_ptr<FieldTracer> ApolloTracing::startOperation()
+{
+	return std::unique_ptr<FieldTracer>(new ApolloTracer());
+}
+
+ApolloTracer::ApolloTracer()
+	: _startTime(std::chrono::system_clock::now())
+	, _start(std::chrono::steady_clock::now())
+	, _resolvers(web::json::value::array())
+{
+}
+
+void ApolloTracer::startField(const FieldTrace& /*field*/)
+{
+}
+
+void ApolloTracer::endField(const FieldTrace& field, std::chrono::steady_clock::duration duration)
+{
+	auto resolver = web::json::value::object({
+		{ _XPLATSTR("path"), field.path.toJson() },
+		{ _XPLATSTR("parentType"), web::json::value::string(utility::conversions::to_string_t(field.parentType)) },
+		{ _XPLATSTR("fieldName"), web::json::value::string(utility::conversions::to_string_t(field.fieldName)) },
+		{ _XPLATSTR("startOffset"), web::json::value::number(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(field.start - _start).count())) },
+		{ _XPLATSTR("duration"), web::json::value::number(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count())) }
+		}, true);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto& resolvers = _resolvers.as_array();
+
+	_resolvers[resolvers.size()] = std::move(resolver);
+}
+
+web::json::value ApolloTracer::getExtensions()
+{
+	const auto duration = std::chrono::steady_clock::now() - _start;
+	const auto endTime = _startTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(duration);
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	return web::json::value::object({
+		{ _XPLATSTR("tracing"), web::json::value::object({
+			{ _XPLATSTR("version"), web::json::value::number(1) },
+			{ _XPLATSTR("startTime"), web::json::value::string(formatTime(_startTime)) },
+			{ _XPLATSTR("endTime"), web::json::value::string(formatTime(endTime)) },
+			{ _XPLATSTR("duration"), web::json::value::number(static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count())) },
+			{ _XPLATSTR("execution"), web::json::value::object({
+				{ _XPLATSTR("resolvers"), _resolvers }
+				}, true) }
+			}, true) }
+		}, true);
+}
+
+utility::string_t ApolloTracer::formatTime(std::chrono::system_clock::time_point time)
+{
+	const auto seconds = std::chrono::system_clock::to_time_t(time);
+	const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+	std::tm utc;
+
+#ifdef _WIN32
+	gmtime_s(&utc, &seconds);
+#else
+	gmtime_r(&seconds, &utc);
+#endif
+
+	char buffer[32];
+	std::ostringstream output;
+
+	std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &utc);
+	output << buffer << '.' << std::setw(3) << std::setfill('0') << milliseconds << 'Z';
+
+	return utility::conversions::to_string_t(output.str());
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// FieldTrace identifies the resolver which is being traced and when it started.
+struct FieldTrace
+{
+	const std::string& parentType;
+	const std::string& fieldName;
+	const ResponsePath& path;
+	std::chrono::steady_clock::time_point start;
+};
+
+// FieldTracer gets callbacks for every resolver in a single operation. If the operation resolves
+// its fields on an Executor, they may be called from several threads at once. The duration
+// includes the resolver and converting its result, along with any nested fields beneath it.
+class FieldTracer
+{
+public:
+	virtual ~FieldTracer();
+
+	virtual void startField(const FieldTrace& field) = 0;
+	virtual void endField(const FieldTrace& field, std::chrono::steady_clock::duration duration) = 0;
+
+	// Called once the operation is done. Any members of the object it returns are added to the
+	// extensions in the response.
+	virtual web::json::value getExtensions() = 0;
+};
+
+// Instrumentation is attached to a Request in RequestOptions, and creates a FieldTracer for each
+// operation it wants to trace. Operations which aren't traced don't track their response paths or
+// read the clock.
+class Instrumentation
+{
+public:
+	virtual ~Instrumentation();
+
+	// Return null to skip tracing this operation.
+	virtual std::unique_ptr<FieldTracer> startOperation() = 0;
+};
+
+// ApolloTracing adds timing for every resolver under extensions.tracing in the response, following
+// the Apollo Tracing format. Resolvers don't know their return types, so returnType is left out.
+class ApolloTracing : public Instrumentation
+{
+public:
+	std::unique_ptr<FieldTracer> startOperation() override;
+};
+
+class ApolloTracer : public FieldTracer
+{
+public:
+	ApolloTracer();
+
+	void startField(const FieldTrace& field) override;
+	void endField(const FieldTrace& field, std::chrono::steady_clock::duration duration) override;
+	web::json::value getExtensions() override;
+
+private:
+	static utility::string_t formatTime(std::chrono::system_clock::time_point time);
+
+	const std::chrono::system_clock::time_point _startTime;
+	const std::chrono::steady_clock::time_point _start;
+
+	std::mutex _mutex;
+	web::json::value _resolvers;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
@@ -0,0 +1,1231 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "Validation.h"
+
+#include <atomic>
+#include <cstring>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+namespace {
+
+std::atomic<size_t> nextSchemaId(1);
+
+const web::json::value* findMember(const web::json::value& value, const utility::char_t* key)
+{
+	if (!value.is_object())
+	{
+		return nullptr;
+	}
+
+	const auto& members = value.as_object();
+	auto itr = members.find(key);
+
+	return (itr == members.cend())
+		? nullptr
+		: &itr->second;
+}
+
+std::string getName(const web::json::value& value)
+{
+	auto name = findMember(value, _XPLATSTR("name"));
+
+	return (name != nullptr && name->is_string())
+		? utility::conversions::to_utf8string(name->as_string())
+		: std::string();
+}
+
+std::vector<std::string> getNames(const web::json::value* values)
+{
+	std::vector<std::string> result;
+
+	if (values != nullptr
+		&& values->is_array())
+	{
+		for (const auto& value : values->as_array())
+		{
+			result.push_back(getName(value));
+		}
+	}
+
+	return result;
+}
+
+std::string printTypeRef(const web::json::value& typeRef)
+{
+	auto kind = findMember(typeRef, _XPLATSTR("kind"));
+	auto ofType = findMember(typeRef, _XPLATSTR("ofType"));
+
+	if (kind != nullptr
+		&& kind->is_string()
+		&& ofType != nullptr)
+	{
+		const auto kindName = utility::conversions::to_utf8string(kind->as_string());
+
+		if (kindName == "NON_NULL")
+		{
+			return printTypeRef(*ofType) + "!";
+		}
+		else if (kindName == "LIST")
+		{
+			return "[" + printTypeRef(*ofType) + "]";
+		}
+	}
+
+	return getName(typeRef);
+}
+
+bool isNonNull(const std::string& type)
+{
+	return !type.empty() && type.back() == '!';
+}
+
+std::string getNullableType(const std::string& type)
+{
+	return isNonNull(type)
+		? type.substr(0, type.size() - 1)
+		: type;
+}
+
+bool isListType(const std::string& type)
+{
+	return !type.empty() && type.front() == '[';
+}
+
+std::string getItemType(const std::string& type)
+{
+	const auto nullable = getNullableType(type);
+
+	return nullable.substr(1, nullable.size() - 2);
+}
+
+std::string getNamedType(const std::string& type)
+{
+	std::string result;
+
+	for (auto c : type)
+	{
+		if (c != '[' && c != ']' && c != '!')
+		{
+			result.push_back(c);
+		}
+	}
+
+	return result;
+}
+
+// A variable can be used anywhere its type is at least as strict as the type at that location.
+bool isVariableCompatible(const std::string& variableType, const std::string& locationType)
+{
+	if (isNonNull(locationType))
+	{
+		return isNonNull(variableType)
+			&& isVariableCompatible(getNullableType(variableType), getNullableType(locationType));
+	}
+
+	if (isNonNull(variableType))
+	{
+		return isVariableCompatible(getNullableType(variableType), locationType);
+	}
+
+	if (isListType(locationType))
+	{
+		return isListType(variableType)
+			&& isVariableCompatible(getItemType(variableType), getItemType(locationType));
+	}
+
+	return !isListType(variableType)
+		&& variableType == locationType;
+}
+
+std::string formatLocation(const ast::Node& node)
+{
+	std::ostringstream location;
+
+	location << " line: " << node.getLocation().begin.line
+		<< " column: " << node.getLocation().begin.column;
+
+	return location.str();
+}
+
+// TypePrinter visits the type in a variable definition and prints it the same way as printTypeRef.
+class TypePrinter : public ast::visitor::AstVisitor
+{
+public:
+	const std::string& getType() const
+	{
+		return _type;
+	}
+
+	bool visitNamedType(const ast::NamedType& namedType) override
+	{
+		_type = namedType.getName().getValue();
+		return false;
+	}
+
+	bool visitListType(const ast::ListType& listType) override
+	{
+		TypePrinter itemType;
+
+		listType.getType().accept(&itemType);
+		_type = "[" + itemType.getType() + "]";
+		return false;
+	}
+
+	bool visitNonNullType(const ast::NonNullType& nonNullType) override
+	{
+		TypePrinter nullableType;
+
+		nonNullType.getType().accept(&nullableType);
+		_type = nullableType.getType() + "!";
+		return false;
+	}
+
+private:
+	std::string _type;
+};
+
+// DefinitionCollector visits the document and collects the operations and fragments in order.
+class DefinitionCollector : public ast::visitor::AstVisitor
+{
+public:
+	std::vector<const ast::OperationDefinition*> operations;
+	std::vector<const ast::FragmentDefinition*> fragments;
+
+	bool visitOperationDefinition(const ast::OperationDefinition& operationDefinition) override
+	{
+		operations.push_back(&operationDefinition);
+		return false;
+	}
+
+	bool visitFragmentDefinition(const ast::FragmentDefinition& fragmentDefinition) override
+	{
+		fragments.push_back(&fragmentDefinition);
+		return false;
+	}
+};
+
+// SpreadCollector visits a selection set and collects every fragment spread beneath it.
+class SpreadCollector : public ast::visitor::AstVisitor
+{
+public:
+	std::vector<const ast::FragmentSpread*> spreads;
+
+	bool visitFragmentSpread(const ast::FragmentSpread& fragmentSpread) override
+	{
+		spreads.push_back(&fragmentSpread);
+		return false;
+	}
+};
+
+const std::string introspectionQuery = R"gql(query IntrospectionQuery {
+	__schema {
+		queryType { name }
+		mutationType { name }
+		subscriptionType { name }
+		types {
+			kind
+			name
+			fields(includeDeprecated: true) {
+				name
+				args { name defaultValue type { ...TypeRef } }
+				type { ...TypeRef }
+			}
+			inputFields { name defaultValue type { ...TypeRef } }
+			interfaces { name }
+			possibleTypes { name }
+			enumValues(includeDeprecated: true) { name }
+		}
+	}
+}
+
+fragment TypeRef on __Type {
+	kind
+	name
+	ofType {
+		kind
+		name
+		ofType {
+			kind
+			name
+			ofType {
+				kind
+				name
+				ofType {
+					kind
+					name
+					ofType {
+						kind
+						name
+						ofType {
+							kind
+							name
+						}
+					}
+				}
+			}
+		}
+	}
+})gql";
+
+} /* namespace */
+
+// ValidationVisitor walks the whole document once and collects every error it finds, instead of
+// stopping at the first one. Fragments are checked against their own type condition as they're
+// spread into each operation, so the variables they use are checked against that operation.
+class ValidationVisitor
+{
+public:
+	explicit ValidationVisitor(const ValidationSchema& schema);
+
+	std::vector<std::string> validate(const ast::Node& document);
+
+	void visitSelectionSet(const std::string& typeName, const ast::SelectionSet& selectionSet);
+	void visitField(const std::string& parentType, const ast::Field& field);
+	void visitFragmentSpread(const std::string& parentType, const ast::FragmentSpread& fragmentSpread);
+	void visitInlineFragment(const std::string& parentType, const ast::InlineFragment& inlineFragment);
+
+	// Check a value against the type at that location, an empty type only looks for variables.
+	bool checkValue(const ast::Value& value, const std::string& type);
+	bool checkLiteral(const ast::Value& value, const std::string& type, const char* literalType, const char* enumValue);
+	bool checkObjectValue(const ast::ObjectValue& objectValue, const std::string& type);
+	void useVariable(const ast::Variable& variable, const std::string& type);
+
+private:
+	struct Variable
+	{
+		std::string type;
+		bool hasDefault;
+		bool used;
+	};
+
+	void addError(std::string&& message);
+
+	void visitOperation(const ast::OperationDefinition& operationDefinition);
+	void checkDirectives(const std::vector<std::unique_ptr<ast::Directive>>* directives);
+	void checkArguments(const std::vector<std::unique_ptr<ast::Argument>>* arguments, const ValidationSchema::InputValueMap& definitions,
+		const std::string& description, const ast::Node& location);
+	void findFragmentCycles(const std::string& name, std::unordered_map<std::string, int>& states);
+
+	bool isCompositeType(const ValidationSchema::Type* type) const;
+	bool isInputType(const ValidationSchema::Type* type) const;
+	bool isCustomScalar(const std::string& namedType) const;
+	std::unordered_set<std::string> getPossibleTypes(const std::string& typeName) const;
+	bool canSpread(const std::string& parentType, const std::string& fragmentType) const;
+
+	const ValidationSchema& _schema;
+	const ValidationSchema::InputValueMap _conditionArguments;
+
+	std::map<std::string, const ast::FragmentDefinition*> _fragments;
+	std::unordered_set<std::string> _usedFragments;
+
+	std::map<std::string, Variable> _variables;
+	std::unordered_set<std::string> _visitedFragments;
+
+	std::vector<std::string> _errors;
+	std::unordered_set<std::string> _reportedErrors;
+};
+
+namespace {
+
+// SelectionDispatcher calls back to the ValidationVisitor for each kind of selection.
+class SelectionDispatcher : public ast::visitor::AstVisitor
+{
+public:
+	explicit SelectionDispatcher(ValidationVisitor& validation, const std::string& typeName)
+		: _validation(validation)
+		, _typeName(typeName)
+	{
+	}
+
+	bool visitField(const ast::Field& field) override
+	{
+		_validation.visitField(_typeName, field);
+		return false;
+	}
+
+	bool visitFragmentSpread(const ast::FragmentSpread& fragmentSpread) override
+	{
+		_validation.visitFragmentSpread(_typeName, fragmentSpread);
+		return false;
+	}
+
+	bool visitInlineFragment(const ast::InlineFragment& inlineFragment) override
+	{
+		_validation.visitInlineFragment(_typeName, inlineFragment);
+		return false;
+	}
+
+private:
+	ValidationVisitor& _validation;
+	const std::string& _typeName;
+};
+
+// ValueChecker calls back to the ValidationVisitor for each kind of value.
+class ValueChecker : public ast::visitor::AstVisitor
+{
+public:
+	explicit ValueChecker(ValidationVisitor& validation, const std::string& type)
+		: _validation(validation)
+		, _type(type)
+	{
+	}
+
+	bool isValid() const
+	{
+		return _valid;
+	}
+
+	bool visitVariable(const ast::Variable& variable) override
+	{
+		_validation.useVariable(variable, _type);
+		return false;
+	}
+
+	bool visitIntValue(const ast::IntValue& intValue) override
+	{
+		_valid = _validation.checkLiteral(intValue, _type, "Int", nullptr);
+		return false;
+	}
+
+	bool visitFloatValue(const ast::FloatValue& floatValue) override
+	{
+		_valid = _validation.checkLiteral(floatValue, _type, "Float", nullptr);
+		return false;
+	}
+
+	bool visitStringValue(const ast::StringValue& stringValue) override
+	{
+		_valid = _validation.checkLiteral(stringValue, _type, "String", nullptr);
+		return false;
+	}
+
+	bool visitBooleanValue(const ast::BooleanValue& booleanValue) override
+	{
+		_valid = _validation.checkLiteral(booleanValue, _type, "Boolean", nullptr);
+		return false;
+	}
+
+	bool visitNullValue(const ast::NullValue&) override
+	{
+		_valid = !isNonNull(_type);
+		return false;
+	}
+
+	bool visitEnumValue(const ast::EnumValue& enumValue) override
+	{
+		_valid = _validation.checkLiteral(enumValue, _type, nullptr, enumValue.getValue());
+		return false;
+	}
+
+	bool visitListValue(const ast::ListValue& listValue) override
+	{
+		const auto nullableType = getNullableType(_type);
+		const bool isList = isListType(nullableType);
+		const auto itemType = isList
+			? getItemType(nullableType)
+			: std::string();
+
+		_valid = _validation.checkLiteral(listValue, _type, nullptr, nullptr) || isList;
+
+		for (const auto& value : listValue.getValues())
+		{
+			_valid = _validation.checkValue(*value, itemType) && _valid;
+		}
+
+		return false;
+	}
+
+	bool visitObjectValue(const ast::ObjectValue& objectValue) override
+	{
+		_valid = _validation.checkObjectValue(objectValue, _type);
+		return false;
+	}
+
+private:
+	ValidationVisitor& _validation;
+	const std::string& _type;
+	bool _valid = true;
+};
+
+} /* namespace */
+
+ValidationVisitor::ValidationVisitor(const ValidationSchema& schema)
+	: _schema(schema)
+	, _conditionArguments({ { "if", { "Boolean!", false } } })
+{
+}
+
+std::vector<std::string> ValidationVisitor::validate(const ast::Node& document)
+{
+	DefinitionCollector definitions;
+
+	document.accept(&definitions);
+
+	for (auto fragment : definitions.fragments)
+	{
+		const std::string name(fragment->getName().getValue());
+		const std::string typeCondition(fragment->getTypeCondition().getName().getValue());
+		const auto type = _schema.findType(typeCondition);
+
+		if (!_fragments.emplace(name, fragment).second)
+		{
+			addError("Duplicate fragment name: " + name + formatLocation(*fragment));
+		}
+
+		if (type == nullptr)
+		{
+			addError("Unknown type condition: " + typeCondition + formatLocation(fragment->getTypeCondition()));
+		}
+		else if (!isCompositeType(type))
+		{
+			addError("Invalid type condition: " + typeCondition + formatLocation(fragment->getTypeCondition()));
+		}
+	}
+
+	std::unordered_map<std::string, int> states;
+
+	for (const auto& fragment : _fragments)
+	{
+		findFragmentCycles(fragment.first, states);
+	}
+
+	std::unordered_set<std::string> operationNames;
+
+	for (auto operation : definitions.operations)
+	{
+		if (operation->getName() == nullptr)
+		{
+			if (definitions.operations.size() > 1)
+			{
+				addError("Anonymous operation must be the only operation" + formatLocation(*operation));
+			}
+		}
+		else if (!operationNames.insert(operation->getName()->getValue()).second)
+		{
+			addError(std::string("Duplicate operation name: ") + operation->getName()->getValue() + formatLocation(*operation->getName()));
+		}
+
+		visitOperation(*operation);
+	}
+
+	for (auto fragment : definitions.fragments)
+	{
+		const std::string name(fragment->getName().getValue());
+
+		if (_usedFragments.find(name) == _usedFragments.cend())
+		{
+			addError("Unused fragment: " + name + formatLocation(*fragment));
+		}
+	}
+
+	return std::move(_errors);
+}
+
+void ValidationVisitor::addError(std::string&& message)
+{
+	// Fragments which are spread into more than one operation would report the same error again.
+	if (_reportedErrors.insert(message).second)
+	{
+		_errors.push_back(std::move(message));
+	}
+}
+
+void ValidationVisitor::visitOperation(const ast::OperationDefinition& operationDefinition)
+{
+	const std::string operation(operationDefinition.getOperation());
+	auto itr = _schema._operationTypes.find(operation);
+
+	if (itr == _schema._operationTypes.cend())
+	{
+		addError("Unknown operation type: " + operation + formatLocation(operationDefinition));
+		return;
+	}
+
+	_variables.clear();
+	_visitedFragments.clear();
+
+	const auto variableDefinitions = operationDefinition.getVariableDefinitions();
+
+	if (variableDefinitions != nullptr)
+	{
+		for (const auto& variableDefinition : *variableDefinitions)
+		{
+			const auto& variable = variableDefinition->getVariable();
+			const std::string name(variable.getName().getValue());
+			TypePrinter printer;
+
+			variableDefinition->getType().accept(&printer);
+
+			const auto& type = printer.getType();
+			const auto namedType = _schema.findType(getNamedType(type));
+
+			if (namedType == nullptr)
+			{
+				addError("Unknown variable type: " + name + " type: " + type + formatLocation(variable));
+			}
+			else if (!isInputType(namedType))
+			{
+				addError("Invalid variable type: " + name + " type: " + type + formatLocation(variable));
+			}
+
+			if (!_variables.emplace(name, Variable { type, variableDefinition->getDefaultValue() != nullptr, false }).second)
+			{
+				addError("Duplicate variable name: " + name + formatLocation(variable));
+			}
+
+			if (namedType != nullptr
+				&& variableDefinition->getDefaultValue() != nullptr
+				&& !checkValue(*variableDefinition->getDefaultValue(), type))
+			{
+				addError("Invalid default value for variable: " + name + formatLocation(*variableDefinition->getDefaultValue()));
+			}
+		}
+	}
+
+	checkDirectives(operationDefinition.getDirectives());
+	visitSelectionSet(itr->second, operationDefinition.getSelectionSet());
+
+	if (variableDefinitions != nullptr)
+	{
+		for (const auto& variableDefinition : *variableDefinitions)
+		{
+			const auto& variable = variableDefinition->getVariable();
+			const std::string name(variable.getName().getValue());
+
+			if (!_variables[name].used)
+			{
+				addError("Unused variable: " + name + formatLocation(variable));
+			}
+		}
+	}
+}
+
+void ValidationVisitor::visitSelectionSet(const std::string& typeName, const ast::SelectionSet& selectionSet)
+{
+	SelectionDispatcher dispatcher(*this, typeName);
+
+	for (const auto& selection : selectionSet.getSelections())
+	{
+		selection->accept(&dispatcher);
+	}
+}
+
+void ValidationVisitor::visitField(const std::string& parentType, const ast::Field& field)
+{
+	const std::string name(field.getName().getValue());
+
+	checkDirectives(field.getDirectives());
+
+	if (name == "__typename")
+	{
+		if (field.getSelectionSet() != nullptr)
+		{
+			addError("Unexpected selection set for field: " + name + formatLocation(field));
+		}
+
+		return;
+	}
+
+	const auto fieldDefinition = _schema.findField(parentType, name);
+
+	if (fieldDefinition == nullptr)
+	{
+		addError("Unknown field name: " + name + " type: " + parentType + formatLocation(field));
+
+		if (field.getArguments() != nullptr)
+		{
+			// Still count the variables it uses, so they're not reported as unused too.
+			for (const auto& argument : *field.getArguments())
+			{
+				checkValue(argument->getValue(), {});
+			}
+		}
+
+		return;
+	}
+
+	checkArguments(field.getArguments(), fieldDefinition->arguments, "field: " + name, field);
+
+	const auto typeName = getNamedType(fieldDefinition->type);
+	const auto type = _schema.findType(typeName);
+
+	if (isCompositeType(type))
+	{
+		if (field.getSelectionSet() == nullptr)
+		{
+			addError("Missing selection set for field: " + name + formatLocation(field));
+		}
+		else
+		{
+			visitSelectionSet(typeName, *field.getSelectionSet());
+		}
+	}
+	else if (field.getSelectionSet() != nullptr)
+	{
+		addError("Unexpected selection set for field: " + name + formatLocation(field));
+	}
+}
+
+void ValidationVisitor::visitFragmentSpread(const std::string& parentType, const ast::FragmentSpread& fragmentSpread)
+{
+	const std::string name(fragmentSpread.getName().getValue());
+	auto itr = _fragments.find(name);
+
+	checkDirectives(fragmentSpread.getDirectives());
+
+	if (itr == _fragments.cend())
+	{
+		addError("Unknown fragment name: " + name + formatLocation(fragmentSpread));
+		return;
+	}
+
+	_usedFragments.insert(name);
+
+	const std::string typeCondition(itr->second->getTypeCondition().getName().getValue());
+
+	if (!isCompositeType(_schema.findType(typeCondition)))
+	{
+		// This is reported along with the fragment definition.
+		return;
+	}
+
+	if (!canSpread(parentType, typeCondition))
+	{
+		addError("Fragment cannot be spread here: " + name + " type: " + typeCondition + " parent: " + parentType + formatLocation(fragmentSpread));
+	}
+
+	if (_visitedFragments.insert(name).second)
+	{
+		visitSelectionSet(typeCondition, itr->second->getSelectionSet());
+	}
+}
+
+void ValidationVisitor::visitInlineFragment(const std::string& parentType, const ast::InlineFragment& inlineFragment)
+{
+	std::string typeCondition(parentType);
+
+	checkDirectives(inlineFragment.getDirectives());
+
+	if (inlineFragment.getTypeCondition() != nullptr)
+	{
+		const auto& namedType = *inlineFragment.getTypeCondition();
+		const auto type = _schema.findType(namedType.getName().getValue());
+
+		typeCondition = namedType.getName().getValue();
+
+		if (type == nullptr)
+		{
+			addError("Unknown type condition: " + typeCondition + formatLocation(namedType));
+			return;
+		}
+		else if (!isCompositeType(type))
+		{
+			addError("Invalid type condition: " + typeCondition + formatLocation(namedType));
+			return;
+		}
+		else if (!canSpread(parentType, typeCondition))
+		{
+			addError("Fragment cannot be spread here: type: " + typeCondition + " parent: " + parentType + formatLocation(inlineFragment));
+		}
+	}
+
+	visitSelectionSet(typeCondition, inlineFragment.getSelectionSet());
+}
+
+void ValidationVisitor::checkDirectives(const std::vector<std::unique_ptr<ast::Directive>>* directives)
+{
+	if (directives == nullptr)
+	{
+		return;
+	}
+
+	for (const auto& directive : *directives)
+	{
+		const std::string name(directive->getName().getValue());
+
+		if (name == "skip"
+			|| name == "include")
+		{
+			checkArguments(directive->getArguments(), _conditionArguments, "directive: " + name, *directive);
+		}
+		else if (directive->getArguments() != nullptr)
+		{
+			for (const auto& argument : *directive->getArguments())
+			{
+				checkValue(argument->getValue(), {});
+			}
+		}
+	}
+}
+
+void ValidationVisitor::checkArguments(const std::vector<std::unique_ptr<ast::Argument>>* arguments, const ValidationSchema::InputValueMap& definitions,
+	const std::string& description, const ast::Node& location)
+{
+	std::unordered_set<std::string> provided;
+
+	if (arguments != nullptr)
+	{
+		for (const auto& argument : *arguments)
+		{
+			const std::string name(argument->getName().getValue());
+			auto itr = definitions.find(name);
+
+			if (!provided.insert(name).second)
+			{
+				addError("Duplicate argument name: " + name + " " + description + formatLocation(*argument));
+			}
+
+			if (itr == definitions.cend())
+			{
+				addError("Unknown argument name: " + name + " " + description + formatLocation(*argument));
+				checkValue(argument->getValue(), {});
+			}
+			else if (!checkValue(argument->getValue(), itr->second.type))
+			{
+				addError("Invalid argument value: " + name + " " + description + formatLocation(*argument));
+			}
+		}
+	}
+
+	for (const auto& definition : definitions)
+	{
+		if (isNonNull(definition.second.type)
+			&& !definition.second.hasDefault
+			&& provided.find(definition.first) == provided.cend())
+		{
+			addError("Missing required argument: " + definition.first + " " + description + formatLocation(location));
+		}
+	}
+}
+
+bool ValidationVisitor::checkValue(const ast::Value& value, const std::string& type)
+{
+	ValueChecker checker(*this, type);
+
+	value.accept(&checker);
+
+	return checker.isValid();
+}
+
+bool ValidationVisitor::checkLiteral(const ast::Value& value, const std::string& type, const char* literalType, const char* enumValue)
+{
+	if (type.empty())
+	{
+		return true;
+	}
+
+	const auto nullableType = getNullableType(type);
+
+	if (isListType(nullableType))
+	{
+		// A single value is coerced to a list with one element.
+		return (literalType != nullptr || enumValue != nullptr)
+			&& checkValue(value, getItemType(nullableType));
+	}
+
+	if (isCustomScalar(nullableType))
+	{
+		return true;
+	}
+
+	if (enumValue != nullptr)
+	{
+		const auto enumType = _schema.findType(nullableType);
+
+		return enumType != nullptr
+			&& enumType->kind == ValidationSchema::Kind::Enum
+			&& enumType->enumValues.find(enumValue) != enumType->enumValues.cend();
+	}
+
+	if (literalType == nullptr)
+	{
+		return false;
+	}
+
+	if (nullableType == literalType)
+	{
+		return true;
+	}
+
+	// Int literals also work for Float and ID, and String literals for ID.
+	return (std::strcmp(literalType, "Int") == 0 && (nullableType == "Float" || nullableType == "ID"))
+		|| (std::strcmp(literalType, "String") == 0 && nullableType == "ID");
+}
+
+bool ValidationVisitor::checkObjectValue(const ast::ObjectValue& objectValue, const std::string& type)
+{
+	const auto nullableType = getNullableType(type);
+
+	if (isListType(nullableType))
+	{
+		// A single value is coerced to a list with one element.
+		return checkObjectValue(objectValue, getItemType(nullableType));
+	}
+
+	const bool checkFields = !type.empty() && !isCustomScalar(nullableType);
+	const ValidationSchema::Type* inputType = nullptr;
+
+	if (checkFields)
+	{
+		inputType = _schema.findType(nullableType);
+
+		if (inputType != nullptr
+			&& inputType->kind != ValidationSchema::Kind::InputObject)
+		{
+			inputType = nullptr;
+		}
+	}
+
+	bool valid = !checkFields || inputType != nullptr;
+	std::unordered_set<std::string> provided;
+
+	for (const auto& field : objectValue.getFields())
+	{
+		const std::string name(field->getName().getValue());
+		std::string fieldType;
+
+		if (inputType != nullptr)
+		{
+			auto itr = inputType->inputFields.find(name);
+
+			if (itr == inputType->inputFields.cend())
+			{
+				valid = false;
+			}
+			else
+			{
+				fieldType = itr->second.type;
+			}
+		}
+
+		provided.insert(name);
+		valid = checkValue(field->getValue(), fieldType) && valid;
+	}
+
+	if (inputType != nullptr)
+	{
+		for (const auto& inputField : inputType->inputFields)
+		{
+			if (isNonNull(inputField.second.type)
+				&& !inputField.second.hasDefault
+				&& provided.find(inputField.first) == provided.cend())
+			{
+				valid = false;
+			}
+		}
+	}
+
+	return valid;
+}
+
+void ValidationVisitor::useVariable(const ast::Variable& variable, const std::string& type)
+{
+	const std::string name(variable.getName().getValue());
+	auto itr = _variables.find(name);
+
+	if (itr == _variables.end())
+	{
+		addError("Undefined variable: " + name + formatLocation(variable));
+		return;
+	}
+
+	itr->second.used = true;
+
+	if (type.empty())
+	{
+		return;
+	}
+
+	// A default value means a nullable variable is never null where it's used.
+	auto variableType = itr->second.type;
+
+	if (itr->second.hasDefault
+		&& !isNonNull(variableType))
+	{
+		variableType.push_back('!');
+	}
+
+	if (!isVariableCompatible(variableType, type))
+	{
+		addError("Invalid variable type: " + name + " type: " + itr->second.type + " expected: " + type + formatLocation(variable));
+	}
+}
+
+void ValidationVisitor::findFragmentCycles(const std::string& name, std::unordered_map<std::string, int>& states)
+{
+	// 1 means the fragment is on the current path, 2 means everything beneath it has been checked.
+	if (states[name] != 0)
+	{
+		return;
+	}
+
+	states[name] = 1;
+
+	SpreadCollector collector;
+
+	_fragments[name]->getSelectionSet().accept(&collector);
+
+	for (auto spread : collector.spreads)
+	{
+		const std::string spreadName(spread->getName().getValue());
+
+		if (_fragments.find(spreadName) == _fragments.cend())
+		{
+			continue;
+		}
+
+		if (states[spreadName] == 1)
+		{
+			addError("Fragment cycle: " + spreadName + formatLocation(*spread));
+		}
+		else
+		{
+			findFragmentCycles(spreadName, states);
+		}
+	}
+
+	states[name] = 2;
+}
+
+bool ValidationVisitor::isCompositeType(const ValidationSchema::Type* type) const
+{
+	return type != nullptr
+		&& (type->kind == ValidationSchema::Kind::Object
+			|| type->kind == ValidationSchema::Kind::Interface
+			|| type->kind == ValidationSchema::Kind::Union);
+}
+
+bool ValidationVisitor::isInputType(const ValidationSchema::Type* type) const
+{
+	return type != nullptr
+		&& (type->kind == ValidationSchema::Kind::Scalar
+			|| type->kind == ValidationSchema::Kind::Enum
+			|| type->kind == ValidationSchema::Kind::InputObject);
+}
+
+bool ValidationVisitor::isCustomScalar(const std::string& namedType) const
+{
+	const auto type = _schema.findType(namedType);
+
+	return type != nullptr
+		&& type->kind == ValidationSchema::Kind::Scalar
+		&& namedType != "Int"
+		&& namedType != "Float"
+		&& namedType != "String"
+		&& namedType != "Boolean"
+		&& namedType != "ID";
+}
+
+std::unordered_set<std::string> ValidationVisitor::getPossibleTypes(const std::string& typeName) const
+{
+	const auto type = _schema.findType(typeName);
+
+	if (type == nullptr)
+	{
+		return {};
+	}
+
+	if (type->kind == ValidationSchema::Kind::Object)
+	{
+		return { typeName };
+	}
+
+	return type->possibleTypes;
+}
+
+bool ValidationVisitor::canSpread(const std::string& parentType, const std::string& fragmentType) const
+{
+	const auto parentTypes = getPossibleTypes(parentType);
+	const auto fragmentTypes = getPossibleTypes(fragmentType);
+
+	return std::any_of(fragmentTypes.cbegin(), fragmentTypes.cend(),
+		[&parentTypes](const std::string& typeName)
+	{
+		return parentTypes.find(typeName) != parentTypes.cend();
+	});
+}
+
+ValidationSchema::ValidationSchema(const web::json::value& schema)
+	: _id(nextSchemaId++)
+{
+	const std::pair<const char*, const utility::char_t*> operationTypes[] = {
+		{ "query", _XPLATSTR("queryType") },
+		{ "mutation", _XPLATSTR("mutationType") },
+		{ "subscription", _XPLATSTR("subscriptionType") },
+	};
+
+	for (const auto& operationType : operationTypes)
+	{
+		auto typeRef = findMember(schema, operationType.second);
+
+		if (typeRef != nullptr
+			&& typeRef->is_object())
+		{
+			_operationTypes[operationType.first] = getName(*typeRef);
+		}
+	}
+
+	const auto getInputValues = [](const web::json::value* inputValues)
+	{
+		InputValueMap result;
+
+		if (inputValues != nullptr
+			&& inputValues->is_array())
+		{
+			for (const auto& inputValue : inputValues->as_array())
+			{
+				auto defaultValue = findMember(inputValue, _XPLATSTR("defaultValue"));
+
+				result[getName(inputValue)] = {
+					printTypeRef(*findMember(inputValue, _XPLATSTR("type"))),
+					defaultValue != nullptr && !defaultValue->is_null()
+				};
+			}
+		}
+
+		return result;
+	};
+	const std::pair<const char*, Kind> kinds[] = {
+		{ "SCALAR", Kind::Scalar },
+		{ "OBJECT", Kind::Object },
+		{ "INTERFACE", Kind::Interface },
+		{ "UNION", Kind::Union },
+		{ "ENUM", Kind::Enum },
+		{ "INPUT_OBJECT", Kind::InputObject },
+	};
+	std::vector<std::pair<std::string, std::string>> implementations;
+	auto types = findMember(schema, _XPLATSTR("types"));
+
+	if (types != nullptr
+		&& types->is_array())
+	{
+		for (const auto& entry : types->as_array())
+		{
+			const auto name = getName(entry);
+			auto kind = findMember(entry, _XPLATSTR("kind"));
+			Type type { Kind::Scalar };
+
+			if (kind != nullptr
+				&& kind->is_string())
+			{
+				const auto kindName = utility::conversions::to_utf8string(kind->as_string());
+
+				for (const auto& entryKind : kinds)
+				{
+					if (kindName == entryKind.first)
+					{
+						type.kind = entryKind.second;
+						break;
+					}
+				}
+			}
+
+			auto fields = findMember(entry, _XPLATSTR("fields"));
+
+			if (fields != nullptr
+				&& fields->is_array())
+			{
+				for (const auto& field : fields->as_array())
+				{
+					type.fields[getName(field)] = {
+						printTypeRef(*findMember(field, _XPLATSTR("type"))),
+						getInputValues(findMember(field, _XPLATSTR("args")))
+					};
+				}
+			}
+
+			for (const auto& possibleType : getNames(findMember(entry, _XPLATSTR("possibleTypes"))))
+			{
+				type.possibleTypes.insert(possibleType);
+			}
+
+			// Objects list the interfaces they implement, but the interfaces might not list them.
+			for (const auto& interfaceName : getNames(findMember(entry, _XPLATSTR("interfaces"))))
+			{
+				implementations.emplace_back(interfaceName, name);
+			}
+
+			for (const auto& enumValue : getNames(findMember(entry, _XPLATSTR("enumValues"))))
+			{
+				type.enumValues.insert(enumValue);
+			}
+
+			type.inputFields = getInputValues(findMember(entry, _XPLATSTR("inputFields")));
+			_types[name] = std::move(type);
+		}
+	}
+
+	for (const auto& implementation : implementations)
+	{
+		auto itr = _types.find(implementation.first);
+
+		if (itr != _types.end())
+		{
+			itr->second.possibleTypes.insert(implementation.second);
+		}
+	}
+
+	// The introspection fields on the query type aren't listed with the rest of its fields.
+	auto queryType = _operationTypes.find("query");
+
+	if (queryType != _operationTypes.cend())
+	{
+		auto itr = _types.find(queryType->second);
+
+		if (itr != _types.end())
+		{
+			itr->second.fields["__schema"] = { "__Schema!", {} };
+			itr->second.fields["__type"] = { "__Type", { { "name", { "String!", false } } } };
+		}
+	}
+}
+
+const std::string& ValidationSchema::getIntrospectionQuery()
+{
+	return introspectionQuery;
+}
+
+std::vector<std::string> ValidationSchema::validate(const ParsedDocument& document) const
+{
+	ValidationVisitor visitor(*this);
+
+	return visitor.validate(document.getDocument());
+}
+
+size_t ValidationSchema::getId() const
+{
+	return _id;
+}
+
+const ValidationSchema::Type* ValidationSchema::findType(const std::string& name) const
+{
+	auto itr = _types.find(name);
+
+	return (itr == _types.cend())
+		? nullptr
+		: &itr->second;
+}
+
+const ValidationSchema::Field* ValidationSchema::findField(const std::string& typeName, const std::string& fieldName) const
+{
+	auto type = findType(typeName);
+
+	if (type == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto itr = type->fields.find(fieldName);
+
+	return (itr == type->fields.cend())
+		? nullptr
+		: &itr->second;
+}
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
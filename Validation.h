@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "GraphQLService.h"
+
+#include <map>
+
+namespace facebook {
+namespace graphql {
+namespace service {
+
+// ValidationSchema is the type information which documents are validated against. It's built from
+// the __schema field in the response to the introspection query, so it always matches what
+// schemagen generated for the service. Types are stored in their printed form, e.g. [ID!]!.
+class ValidationSchema
+{
+public:
+	explicit ValidationSchema(const web::json::value& schema);
+
+	// The query to resolve against the service to get the __schema field.
+	static const std::string& getIntrospectionQuery();
+
+	// Check every operation and fragment in the document, and return the errors for all of them.
+	// It's empty if the document is valid.
+	std::vector<std::string> validate(const ParsedDocument& document) const;
+
+	// Each schema has a unique id, which documents use to remember that they've been validated.
+	size_t getId() const;
+
+private:
+	friend class ValidationVisitor;
+
+	enum class Kind
+	{
+		Scalar,
+		Object,
+		Interface,
+		Union,
+		Enum,
+		InputObject,
+	};
+
+	struct InputValue
+	{
+		std::string type;
+		bool hasDefault;
+	};
+
+	using InputValueMap = std::map<std::string, InputValue>;
+
+	struct Field
+	{
+		std::string type;
+		InputValueMap arguments;
+	};
+
+	struct Type
+	{
+		Kind kind;
+		std::map<std::string, Field> fields;
+		std::unordered_set<std::string> possibleTypes;
+		std::unordered_set<std::string> enumValues;
+		InputValueMap inputFields;
+	};
+
+	const Type* findType(const std::string& name) const;
+	const Field* findField(const std::string& typeName, const std::string& fieldName) const;
+
+	const size_t _id;
+	std::unordered_map<std::string, Type> _types;
+	std::unordered_map<std::string, std::string> _operationTypes;
+};
+
+} /* namespace service */
+} /* namespace graphql */
+} /* namespace facebook */
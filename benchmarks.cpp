@@ -0,0 +1,347 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include "Today.h"
+
+#include <graphqlparser/GraphQLParser.h>
+
+#include <sstream>
+
+using namespace facebook::graphql;
+
+namespace {
+
+// Build a Today service with count appointments, tasks, and folders.
+std::shared_ptr<today::Operations> makeService(size_t count)
+{
+	const auto makeId = [](const char* prefix, size_t index)
+	{
+		std::string id(prefix + std::to_string(index));
+
+		return std::vector<unsigned char>(id.cbegin(), id.cend());
+	};
+
+	auto query = std::make_shared<today::Query>(
+		[count, makeId]() -> std::vector<std::shared_ptr<today::Appointment>>
+	{
+		std::vector<std::shared_ptr<today::Appointment>> appointments;
+
+		appointments.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			appointments.push_back(std::make_shared<today::Appointment>(makeId("appointment", i), "tomorrow", "Lunch?", false));
+		}
+
+		return appointments;
+	}, [count, makeId]() -> std::vector<std::shared_ptr<today::Task>>
+	{
+		std::vector<std::shared_ptr<today::Task>> tasks;
+
+		tasks.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			tasks.push_back(std::make_shared<today::Task>(makeId("task", i), "Don't forget", true));
+		}
+
+		return tasks;
+	}, [count, makeId]() -> std::vector<std::shared_ptr<today::Folder>>
+	{
+		std::vector<std::shared_ptr<today::Folder>> folders;
+
+		folders.reserve(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			folders.push_back(std::make_shared<today::Folder>(makeId("folder", i), "\"Fake\" Inbox", 3));
+		}
+
+		return folders;
+	});
+	auto mutation = std::make_shared<today::Mutation>(
+		[](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
+	{
+		return std::make_shared<today::CompleteTaskPayload>(
+			std::make_shared<today::Task>(std::move(input.id), "Mutated Task!", *(input.isComplete)),
+			std::move(input.clientMutationId)
+		);
+	});
+	auto subscription = std::make_shared<today::Subscription>();
+
+	return std::make_shared<today::Operations>(query, mutation, subscription);
+}
+
+// All of the connections with every scalar field on the nodes.
+const std::string c_listQuery(R"gql({
+	appointments {
+		pageInfo { hasNextPage hasPreviousPage }
+		edges { cursor node { id subject when isNow } }
+	}
+	tasks {
+		pageInfo { hasNextPage hasPreviousPage }
+		edges { cursor node { id title isComplete } }
+	}
+	unreadCounts {
+		pageInfo { hasNextPage hasPreviousPage }
+		edges { cursor node { id name unreadCount } }
+	}
+})gql");
+
+// Follow the type wrappers several levels deep on every field in the schema.
+const std::string c_deepQuery(R"gql({
+	__schema {
+		types {
+			fields {
+				type { ofType { ofType { ofType { ofType { ofType { name } } } } } }
+				args { type { ofType { ofType { ofType { name } } } } }
+			}
+		}
+	}
+})gql");
+
+// The standard introspection query from GraphiQL.
+const std::string c_introspectionQuery(R"gql(query IntrospectionQuery {
+	__schema {
+		queryType { name }
+		mutationType { name }
+		subscriptionType { name }
+		types { ...FullType }
+		directives { name description locations args { ...InputValue } }
+	}
+}
+
+fragment FullType on __Type {
+	kind
+	name
+	description
+	fields(includeDeprecated: true) {
+		name
+		description
+		args { ...InputValue }
+		type { ...TypeRef }
+		isDeprecated
+		deprecationReason
+	}
+	inputFields { ...InputValue }
+	interfaces { ...TypeRef }
+	enumValues(includeDeprecated: true) { name description isDeprecated deprecationReason }
+	possibleTypes { ...TypeRef }
+}
+
+fragment InputValue on __InputValue {
+	name
+	description
+	type { ...TypeRef }
+	defaultValue
+}
+
+fragment TypeRef on __Type {
+	kind
+	name
+	ofType { kind name ofType { kind name ofType { kind name ofType { kind name } } } }
+})gql");
+
+// Select the same fields under many different aliases.
+std::string makeWideQuery(size_t width)
+{
+	std::ostringstream query;
+
+	query << "{ appointments { edges { node {";
+
+	for (size_t i = 0; i < width; ++i)
+	{
+		query << " id" << i << ": id subject" << i << ": subject";
+	}
+
+	query << " } } } }";
+
+	return query.str();
+}
+
+// Spread the fields on the nodes through a long chain of fragments.
+std::string makeFragmentQuery(size_t count)
+{
+	std::ostringstream query;
+
+	query << "{ appointments { edges { node { ...Fragment0 } } } }";
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		query << " fragment Fragment" << i << " on Appointment { f" << i << ": subject";
+
+		if (i + 1 < count)
+		{
+			query << " ...Fragment" << (i + 1);
+		}
+
+		query << " }";
+	}
+
+	return query.str();
+}
+
+const std::string& getQuery(int64_t shape)
+{
+	static const std::string wideQuery(makeWideQuery(50));
+	static const std::string fragmentQuery(makeFragmentQuery(50));
+
+	switch (shape)
+	{
+		case 0:
+			return c_listQuery;
+
+		case 1:
+			return c_deepQuery;
+
+		case 2:
+			return wideQuery;
+
+		case 3:
+			return fragmentQuery;
+
+		default:
+			return c_introspectionQuery;
+	}
+}
+
+// Each benchmark takes the query shape as its first argument and the size of the lists in the
+// Today service as the second.
+void applyShapes(benchmark::internal::Benchmark* benchmark)
+{
+	benchmark->ArgNames({ "shape", "count" });
+
+	for (int64_t count : { 10, 10000 })
+	{
+		benchmark->Args({ 0, count });
+	}
+
+	benchmark->Args({ 1, 10 });
+	benchmark->Args({ 2, 100 });
+	benchmark->Args({ 3, 100 });
+	benchmark->Args({ 4, 10 });
+}
+
+void setLabel(benchmark::State& state)
+{
+	static const char* const c_shapes[] = { "list", "deep", "wide", "fragments", "introspection" };
+
+	state.SetLabel(c_shapes[state.range(0)]);
+}
+
+// Make sure the query shape actually resolves before we measure it.
+bool checkResult(benchmark::State& state, const web::json::value& result)
+{
+	if (result.as_object().find(_XPLATSTR("errors")) != result.as_object().cend())
+	{
+		state.SkipWithError(utility::conversions::to_utf8string(result.serialize()).c_str());
+		return false;
+	}
+
+	return true;
+}
+
+} /* namespace */
+
+// Just the libgraphqlparser AST.
+static void BM_Parse(benchmark::State& state)
+{
+	const auto& query = getQuery(state.range(0));
+
+	for (auto _ : state)
+	{
+		const char* error = nullptr;
+		auto ast = parseString(query.c_str(), &error);
+
+		benchmark::DoNotOptimize(ast);
+	}
+
+	setLabel(state);
+}
+BENCHMARK(BM_Parse)->Apply(applyShapes);
+
+// Parse the AST and compile the execution plans, which is what the DocumentCache saves.
+static void BM_Prepare(benchmark::State& state)
+{
+	const auto& query = getQuery(state.range(0));
+
+	for (auto _ : state)
+	{
+		auto document = service::ParsedDocument::parse(query);
+
+		benchmark::DoNotOptimize(document);
+	}
+
+	setLabel(state);
+}
+BENCHMARK(BM_Prepare)->Apply(applyShapes);
+
+// Execute a prepared document, including building the web::json::value result.
+static void BM_Execute(benchmark::State& state)
+{
+	auto service = makeService(static_cast<size_t>(state.range(1)));
+	auto document = service::ParsedDocument::parse(getQuery(state.range(0)));
+	const auto variables = web::json::value::object();
+
+	if (!checkResult(state, service->resolve(*document, "", variables.as_object())))
+	{
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		auto result = service->resolve(*document, "", variables.as_object());
+
+		benchmark::DoNotOptimize(result);
+	}
+
+	setLabel(state);
+}
+BENCHMARK(BM_Execute)->Apply(applyShapes);
+
+// Execute a prepared document and stream the response to a string.
+static void BM_ExecuteStream(benchmark::State& state)
+{
+	auto service = makeService(static_cast<size_t>(state.range(1)));
+	auto document = service::ParsedDocument::parse(getQuery(state.range(0)));
+	const auto variables = web::json::value::object();
+
+	for (auto _ : state)
+	{
+		std::string output;
+		service::ResponseWriter writer(output);
+
+		service->resolve(*document, "", variables.as_object(), writer);
+		benchmark::DoNotOptimize(output);
+	}
+
+	setLabel(state);
+}
+BENCHMARK(BM_ExecuteStream)->Apply(applyShapes);
+
+// Serialize a result which has already been resolved.
+static void BM_Serialize(benchmark::State& state)
+{
+	auto service = makeService(static_cast<size_t>(state.range(1)));
+	auto document = service::ParsedDocument::parse(getQuery(state.range(0)));
+	const auto result = service->resolve(*document, "", web::json::value::object().as_object());
+
+	if (!checkResult(state, result))
+	{
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		auto output = result.serialize();
+
+		benchmark::DoNotOptimize(output);
+	}
+
+	setLabel(state);
+}
+BENCHMARK(BM_Serialize)->Apply(applyShapes);
+
+BENCHMARK_MAIN();
@@ -121,360 +121,652 @@ web::json::value service::ModifiedResult<introspection::__TypeKind>::convert(con
 namespace introspection {
 namespace object {
 
+static const char* const s___SchemaFields[] = {
+	"__typename",
+	"directives",
+	"mutationType",
+	"queryType",
+	"subscriptionType",
+	"types",
+};
+
+static const bool s___SchemaNullableFields[] = {
+	false,
+	false,
+	true,
+	false,
+	true,
+	false,
+};
+
+static const service::ObjectType& get__SchemaType()
+{
+	static const service::ObjectType type {
+		"__Schema",
+		{
+			"__Schema"
+		},
+		{ s___SchemaFields, 6, s___SchemaNullableFields }
+	};
+
+	return type;
+}
+
 __Schema::__Schema()
-	: service::Object({
-		"__Schema"
-	}, {
-		{ "types", [this](service::ResolverParams&& params) { return resolveTypes(std::move(params)); } },
-		{ "queryType", [this](service::ResolverParams&& params) { return resolveQueryType(std::move(params)); } },
-		{ "mutationType", [this](service::ResolverParams&& params) { return resolveMutationType(std::move(params)); } },
-		{ "subscriptionType", [this](service::ResolverParams&& params) { return resolveSubscriptionType(std::move(params)); } },
-		{ "directives", [this](service::ResolverParams&& params) { return resolveDirectives(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__SchemaType())
+{
+}
+
+std::future<web::json::value> __Schema::resolveField(size_t index, service::ResolverParams&& params) const
 {
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveDirectives(std::move(params));
+
+		case 2:
+			return resolveMutationType(std::move(params));
+
+		case 3:
+			return resolveQueryType(std::move(params));
+
+		case 4:
+			return resolveSubscriptionType(std::move(params));
+
+		case 5:
+			return resolveTypes(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
 }
 
-web::json::value __Schema::resolveTypes(service::ResolverParams&& params)
+std::future<web::json::value> __Schema::resolveTypes(service::ResolverParams&& params) const
 {
-	auto result = getTypes();
+	auto result = getTypes(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__Type>>>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Schema::resolveQueryType(service::ResolverParams&& params)
+std::future<web::json::value> __Schema::resolveQueryType(service::ResolverParams&& params) const
 {
-	auto result = getQueryType();
+	auto result = getQueryType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Schema::resolveMutationType(service::ResolverParams&& params)
+std::future<web::json::value> __Schema::resolveMutationType(service::ResolverParams&& params) const
 {
-	auto result = getMutationType();
+	auto result = getMutationType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Schema::resolveSubscriptionType(service::ResolverParams&& params)
+std::future<web::json::value> __Schema::resolveSubscriptionType(service::ResolverParams&& params) const
 {
-	auto result = getSubscriptionType();
+	auto result = getSubscriptionType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Schema::resolveDirectives(service::ResolverParams&& params)
+std::future<web::json::value> __Schema::resolveDirectives(service::ResolverParams&& params) const
 {
-	auto result = getDirectives();
+	auto result = getDirectives(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Directive, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__Directive>>>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Schema::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __Schema::resolve__typename(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__Schema"));
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__Schema"), std::move(params));
+}
+
+static const char* const s___DirectiveFields[] = {
+	"__typename",
+	"args",
+	"description",
+	"locations",
+	"name",
+};
+
+static const bool s___DirectiveNullableFields[] = {
+	false,
+	false,
+	true,
+	false,
+	false,
+};
+
+static const service::ObjectType& get__DirectiveType()
+{
+	static const service::ObjectType type {
+		"__Directive",
+		{
+			"__Directive"
+		},
+		{ s___DirectiveFields, 5, s___DirectiveNullableFields }
+	};
+
+	return type;
 }
 
 __Directive::__Directive()
-	: service::Object({
-		"__Directive"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "locations", [this](service::ResolverParams&& params) { return resolveLocations(std::move(params)); } },
-		{ "args", [this](service::ResolverParams&& params) { return resolveArgs(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__DirectiveType())
 {
 }
 
-web::json::value __Directive::resolveName(service::ResolverParams&& params)
+std::future<web::json::value> __Directive::resolveField(size_t index, service::ResolverParams&& params) const
 {
-	auto result = getName();
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveArgs(std::move(params));
+
+		case 2:
+			return resolveDescription(std::move(params));
 
-	return service::ModifiedResult<std::string>::convert(result, std::move(params));
+		case 3:
+			return resolveLocations(std::move(params));
+
+		case 4:
+			return resolveName(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
 }
 
-web::json::value __Directive::resolveDescription(service::ResolverParams&& params)
+std::future<web::json::value> __Directive::resolveName(service::ResolverParams&& params) const
 {
-	auto result = getDescription();
+	auto result = getName(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Directive::resolveLocations(service::ResolverParams&& params)
+std::future<web::json::value> __Directive::resolveDescription(service::ResolverParams&& params) const
 {
-	auto result = getLocations();
+	auto result = getDescription(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__DirectiveLocation, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Directive::resolveArgs(service::ResolverParams&& params)
+std::future<web::json::value> __Directive::resolveLocations(service::ResolverParams&& params) const
 {
-	auto result = getArgs();
+	auto result = getLocations(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__InputValue, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<__DirectiveLocation, service::TypeModifier::List>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Directive::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __Directive::resolveArgs(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__Directive"));
+	auto result = getArgs(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__InputValue>>>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> __Directive::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__Directive"), std::move(params));
+}
+
+static const char* const s___TypeFields[] = {
+	"__typename",
+	"description",
+	"enumValues",
+	"fields",
+	"inputFields",
+	"interfaces",
+	"kind",
+	"name",
+	"ofType",
+	"possibleTypes",
+};
+
+static const bool s___TypeNullableFields[] = {
+	false,
+	true,
+	true,
+	true,
+	true,
+	true,
+	false,
+	true,
+	true,
+	true,
+};
+
+static const service::ObjectType& get__TypeType()
+{
+	static const service::ObjectType type {
+		"__Type",
+		{
+			"__Type"
+		},
+		{ s___TypeFields, 10, s___TypeNullableFields }
+	};
+
+	return type;
 }
 
 __Type::__Type()
-	: service::Object({
-		"__Type"
-	}, {
-		{ "kind", [this](service::ResolverParams&& params) { return resolveKind(std::move(params)); } },
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "fields", [this](service::ResolverParams&& params) { return resolveFields(std::move(params)); } },
-		{ "interfaces", [this](service::ResolverParams&& params) { return resolveInterfaces(std::move(params)); } },
-		{ "possibleTypes", [this](service::ResolverParams&& params) { return resolvePossibleTypes(std::move(params)); } },
-		{ "enumValues", [this](service::ResolverParams&& params) { return resolveEnumValues(std::move(params)); } },
-		{ "inputFields", [this](service::ResolverParams&& params) { return resolveInputFields(std::move(params)); } },
-		{ "ofType", [this](service::ResolverParams&& params) { return resolveOfType(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__TypeType())
 {
 }
 
-web::json::value __Type::resolveKind(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveField(size_t index, service::ResolverParams&& params) const
 {
-	auto result = getKind();
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveDescription(std::move(params));
+
+		case 2:
+			return resolveEnumValues(std::move(params));
 
-	return service::ModifiedResult<__TypeKind>::convert(result, std::move(params));
+		case 3:
+			return resolveFields(std::move(params));
+
+		case 4:
+			return resolveInputFields(std::move(params));
+
+		case 5:
+			return resolveInterfaces(std::move(params));
+
+		case 6:
+			return resolveKind(std::move(params));
+
+		case 7:
+			return resolveName(std::move(params));
+
+		case 8:
+			return resolveOfType(std::move(params));
+
+		case 9:
+			return resolvePossibleTypes(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
 }
 
-web::json::value __Type::resolveName(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveKind(service::ResolverParams&& params) const
 {
-	auto result = getName();
+	auto result = getKind(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<__TypeKind>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveDescription(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveName(service::ResolverParams&& params) const
 {
-	auto result = getDescription();
+	auto result = getName(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveFields(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveDescription(service::ResolverParams&& params) const
 {
-	static const auto defaultArguments = web::json::value::object({
-		{ _XPLATSTR("includeDeprecated"), web::json::value::parse(_XPLATSTR(R"js(false)js")) }
-	});
+	auto result = getDescription(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> __Type::resolveFields(service::ResolverParams&& params) const
+{
+	static const auto defaultIncludeDeprecated = web::json::value::parse(_XPLATSTR(R"js(false)js"));
 
-	auto pairIncludeDeprecated = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::find("includeDeprecated", params.arguments);
-	auto argIncludeDeprecated = (pairIncludeDeprecated.second
-		? std::move(pairIncludeDeprecated.first)
-		: service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("includeDeprecated", defaultArguments.as_object()));
-	auto result = getFields(std::move(argIncludeDeprecated));
+	auto argIncludeDeprecated = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("includeDeprecated", params.arguments, defaultIncludeDeprecated);
+	auto result = getFields(service::FieldParams { params.selection, params.operation }, std::move(argIncludeDeprecated));
 
-	return service::ModifiedResult<__Field, service::TypeModifier::Nullable, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__Field>>, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveInterfaces(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveInterfaces(service::ResolverParams&& params) const
 {
-	auto result = getInterfaces();
+	auto result = getInterfaces(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::Nullable, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__Type>>, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolvePossibleTypes(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolvePossibleTypes(service::ResolverParams&& params) const
 {
-	auto result = getPossibleTypes();
+	auto result = getPossibleTypes(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::Nullable, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__Type>>, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveEnumValues(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveEnumValues(service::ResolverParams&& params) const
 {
-	static const auto defaultArguments = web::json::value::object({
-		{ _XPLATSTR("includeDeprecated"), web::json::value::parse(_XPLATSTR(R"js(false)js")) }
-	});
+	static const auto defaultIncludeDeprecated = web::json::value::parse(_XPLATSTR(R"js(false)js"));
 
-	auto pairIncludeDeprecated = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::find("includeDeprecated", params.arguments);
-	auto argIncludeDeprecated = (pairIncludeDeprecated.second
-		? std::move(pairIncludeDeprecated.first)
-		: service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("includeDeprecated", defaultArguments.as_object()));
-	auto result = getEnumValues(std::move(argIncludeDeprecated));
+	auto argIncludeDeprecated = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("includeDeprecated", params.arguments, defaultIncludeDeprecated);
+	auto result = getEnumValues(service::FieldParams { params.selection, params.operation }, std::move(argIncludeDeprecated));
 
-	return service::ModifiedResult<__EnumValue, service::TypeModifier::Nullable, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__EnumValue>>, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveInputFields(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveInputFields(service::ResolverParams&& params) const
 {
-	auto result = getInputFields();
+	auto result = getInputFields(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__InputValue, service::TypeModifier::Nullable, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__InputValue>>, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolveOfType(service::ResolverParams&& params)
+std::future<web::json::value> __Type::resolveOfType(service::ResolverParams&& params) const
 {
-	auto result = getOfType();
+	auto result = getOfType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Type::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __Type::resolve__typename(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__Type"));
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__Type"), std::move(params));
+}
+
+static const char* const s___FieldFields[] = {
+	"__typename",
+	"args",
+	"deprecationReason",
+	"description",
+	"isDeprecated",
+	"name",
+	"type",
+};
+
+static const bool s___FieldNullableFields[] = {
+	false,
+	false,
+	true,
+	true,
+	false,
+	false,
+	false,
+};
+
+static const service::ObjectType& get__FieldType()
+{
+	static const service::ObjectType type {
+		"__Field",
+		{
+			"__Field"
+		},
+		{ s___FieldFields, 7, s___FieldNullableFields }
+	};
+
+	return type;
 }
 
 __Field::__Field()
-	: service::Object({
-		"__Field"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "args", [this](service::ResolverParams&& params) { return resolveArgs(std::move(params)); } },
-		{ "type", [this](service::ResolverParams&& params) { return resolveType(std::move(params)); } },
-		{ "isDeprecated", [this](service::ResolverParams&& params) { return resolveIsDeprecated(std::move(params)); } },
-		{ "deprecationReason", [this](service::ResolverParams&& params) { return resolveDeprecationReason(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__FieldType())
 {
 }
 
-web::json::value __Field::resolveName(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveField(size_t index, service::ResolverParams&& params) const
 {
-	auto result = getName();
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveArgs(std::move(params));
+
+		case 2:
+			return resolveDeprecationReason(std::move(params));
+
+		case 3:
+			return resolveDescription(std::move(params));
+
+		case 4:
+			return resolveIsDeprecated(std::move(params));
+
+		case 5:
+			return resolveName(std::move(params));
 
-	return service::ModifiedResult<std::string>::convert(result, std::move(params));
+		case 6:
+			return resolveType(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
 }
 
-web::json::value __Field::resolveDescription(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveName(service::ResolverParams&& params) const
 {
-	auto result = getDescription();
+	auto result = getName(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Field::resolveArgs(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveDescription(service::ResolverParams&& params) const
 {
-	auto result = getArgs();
+	auto result = getDescription(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__InputValue, service::TypeModifier::List>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Field::resolveType(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveArgs(service::ResolverParams&& params) const
 {
-	auto result = getType();
+	auto result = getArgs(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::vector<std::shared_ptr<__InputValue>>>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Field::resolveIsDeprecated(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveType(service::ResolverParams&& params) const
 {
-	auto result = getIsDeprecated();
+	auto result = getType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Field::resolveDeprecationReason(service::ResolverParams&& params)
+std::future<web::json::value> __Field::resolveIsDeprecated(service::ResolverParams&& params) const
 {
-	auto result = getDeprecationReason();
+	auto result = getIsDeprecated(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __Field::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __Field::resolveDeprecationReason(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__Field"));
+	auto result = getDeprecationReason(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> __Field::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__Field"), std::move(params));
+}
+
+static const char* const s___InputValueFields[] = {
+	"__typename",
+	"defaultValue",
+	"description",
+	"name",
+	"type",
+};
+
+static const bool s___InputValueNullableFields[] = {
+	false,
+	true,
+	true,
+	false,
+	false,
+};
+
+static const service::ObjectType& get__InputValueType()
+{
+	static const service::ObjectType type {
+		"__InputValue",
+		{
+			"__InputValue"
+		},
+		{ s___InputValueFields, 5, s___InputValueNullableFields }
+	};
+
+	return type;
 }
 
 __InputValue::__InputValue()
-	: service::Object({
-		"__InputValue"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "type", [this](service::ResolverParams&& params) { return resolveType(std::move(params)); } },
-		{ "defaultValue", [this](service::ResolverParams&& params) { return resolveDefaultValue(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__InputValueType())
 {
 }
 
-web::json::value __InputValue::resolveName(service::ResolverParams&& params)
+std::future<web::json::value> __InputValue::resolveField(size_t index, service::ResolverParams&& params) const
 {
-	auto result = getName();
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveDefaultValue(std::move(params));
+
+		case 2:
+			return resolveDescription(std::move(params));
+
+		case 3:
+			return resolveName(std::move(params));
+
+		case 4:
+			return resolveType(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> __InputValue::resolveName(service::ResolverParams&& params) const
+{
+	auto result = getName(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __InputValue::resolveDescription(service::ResolverParams&& params)
+std::future<web::json::value> __InputValue::resolveDescription(service::ResolverParams&& params) const
 {
-	auto result = getDescription();
+	auto result = getDescription(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __InputValue::resolveType(service::ResolverParams&& params)
+std::future<web::json::value> __InputValue::resolveType(service::ResolverParams&& params) const
 {
-	auto result = getType();
+	auto result = getType(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<__Type>::convert(result, std::move(params));
+	return service::ModifiedResult<__Type>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __InputValue::resolveDefaultValue(service::ResolverParams&& params)
+std::future<web::json::value> __InputValue::resolveDefaultValue(service::ResolverParams&& params) const
 {
-	auto result = getDefaultValue();
+	auto result = getDefaultValue(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __InputValue::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __InputValue::resolve__typename(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__InputValue"));
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__InputValue"), std::move(params));
+}
+
+static const char* const s___EnumValueFields[] = {
+	"__typename",
+	"deprecationReason",
+	"description",
+	"isDeprecated",
+	"name",
+};
+
+static const bool s___EnumValueNullableFields[] = {
+	false,
+	true,
+	true,
+	false,
+	false,
+};
+
+static const service::ObjectType& get__EnumValueType()
+{
+	static const service::ObjectType type {
+		"__EnumValue",
+		{
+			"__EnumValue"
+		},
+		{ s___EnumValueFields, 5, s___EnumValueNullableFields }
+	};
+
+	return type;
 }
 
 __EnumValue::__EnumValue()
-	: service::Object({
-		"__EnumValue"
-	}, {
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "description", [this](service::ResolverParams&& params) { return resolveDescription(std::move(params)); } },
-		{ "isDeprecated", [this](service::ResolverParams&& params) { return resolveIsDeprecated(std::move(params)); } },
-		{ "deprecationReason", [this](service::ResolverParams&& params) { return resolveDeprecationReason(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
+	: service::Object(get__EnumValueType())
 {
 }
 
-web::json::value __EnumValue::resolveName(service::ResolverParams&& params)
+std::future<web::json::value> __EnumValue::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveDeprecationReason(std::move(params));
+
+		case 2:
+			return resolveDescription(std::move(params));
+
+		case 3:
+			return resolveIsDeprecated(std::move(params));
+
+		case 4:
+			return resolveName(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> __EnumValue::resolveName(service::ResolverParams&& params) const
 {
-	auto result = getName();
+	auto result = getName(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __EnumValue::resolveDescription(service::ResolverParams&& params)
+std::future<web::json::value> __EnumValue::resolveDescription(service::ResolverParams&& params) const
 {
-	auto result = getDescription();
+	auto result = getDescription(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __EnumValue::resolveIsDeprecated(service::ResolverParams&& params)
+std::future<web::json::value> __EnumValue::resolveIsDeprecated(service::ResolverParams&& params) const
 {
-	auto result = getIsDeprecated();
+	auto result = getIsDeprecated(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __EnumValue::resolveDeprecationReason(service::ResolverParams&& params)
+std::future<web::json::value> __EnumValue::resolveDeprecationReason(service::ResolverParams&& params) const
 {
-	auto result = getDeprecationReason();
+	auto result = getDeprecationReason(service::FieldParams { params.selection, params.operation });
 
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
 }
 
-web::json::value __EnumValue::resolve__typename(service::ResolverParams&&)
+std::future<web::json::value> __EnumValue::resolve__typename(service::ResolverParams&& params) const
 {
-	return web::json::value::string(_XPLATSTR("__EnumValue"));
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("__EnumValue"), std::move(params));
 }
 
 } /* namespace object */
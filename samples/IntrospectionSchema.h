@@ -67,20 +67,22 @@ protected:
 	__Schema();
 
 public:
-	virtual std::vector<std::shared_ptr<__Type>> getTypes() const = 0;
-	virtual std::shared_ptr<__Type> getQueryType() const = 0;
-	virtual std::shared_ptr<__Type> getMutationType() const = 0;
-	virtual std::shared_ptr<__Type> getSubscriptionType() const = 0;
-	virtual std::vector<std::shared_ptr<__Directive>> getDirectives() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__Type>>>> getTypes(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getQueryType(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getMutationType(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getSubscriptionType(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__Directive>>>> getDirectives(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveTypes(service::ResolverParams&& params);
-	web::json::value resolveQueryType(service::ResolverParams&& params);
-	web::json::value resolveMutationType(service::ResolverParams&& params);
-	web::json::value resolveSubscriptionType(service::ResolverParams&& params);
-	web::json::value resolveDirectives(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveTypes(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveQueryType(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveMutationType(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveSubscriptionType(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDirectives(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class __Directive
@@ -90,18 +92,20 @@ protected:
 	__Directive();
 
 public:
-	virtual std::string getName() const = 0;
-	virtual std::unique_ptr<std::string> getDescription() const = 0;
-	virtual std::vector<__DirectiveLocation> getLocations() const = 0;
-	virtual std::vector<std::shared_ptr<__InputValue>> getArgs() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::vector<__DirectiveLocation>> getLocations(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__InputValue>>>> getArgs(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveDescription(service::ResolverParams&& params);
-	web::json::value resolveLocations(service::ResolverParams&& params);
-	web::json::value resolveArgs(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveLocations(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveArgs(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class __Type
@@ -111,28 +115,30 @@ protected:
 	__Type();
 
 public:
-	virtual __TypeKind getKind() const = 0;
-	virtual std::unique_ptr<std::string> getName() const = 0;
-	virtual std::unique_ptr<std::string> getDescription() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<__Field>>> getFields(std::unique_ptr<bool>&& includeDeprecated) const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<__Type>>> getInterfaces() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<__Type>>> getPossibleTypes() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<__EnumValue>>> getEnumValues(std::unique_ptr<bool>&& includeDeprecated) const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<__InputValue>>> getInputFields() const = 0;
-	virtual std::shared_ptr<__Type> getOfType() const = 0;
+	virtual service::FieldResult<__TypeKind> getKind(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__Field>>>> getFields(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__Type>>>> getInterfaces(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__Type>>>> getPossibleTypes(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__EnumValue>>>> getEnumValues(service::FieldParams&& params, std::unique_ptr<bool>&& includeDeprecated) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__InputValue>>>> getInputFields(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getOfType(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveKind(service::ResolverParams&& params);
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveDescription(service::ResolverParams&& params);
-	web::json::value resolveFields(service::ResolverParams&& params);
-	web::json::value resolveInterfaces(service::ResolverParams&& params);
-	web::json::value resolvePossibleTypes(service::ResolverParams&& params);
-	web::json::value resolveEnumValues(service::ResolverParams&& params);
-	web::json::value resolveInputFields(service::ResolverParams&& params);
-	web::json::value resolveOfType(service::ResolverParams&& params);
-
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveKind(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveFields(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveInterfaces(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolvePossibleTypes(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveEnumValues(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveInputFields(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveOfType(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class __Field
@@ -142,22 +148,24 @@ protected:
 	__Field();
 
 public:
-	virtual std::string getName() const = 0;
-	virtual std::unique_ptr<std::string> getDescription() const = 0;
-	virtual std::vector<std::shared_ptr<__InputValue>> getArgs() const = 0;
-	virtual std::shared_ptr<__Type> getType() const = 0;
-	virtual bool getIsDeprecated() const = 0;
-	virtual std::unique_ptr<std::string> getDeprecationReason() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<std::shared_ptr<__InputValue>>>> getArgs(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getType(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<bool> getIsDeprecated(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDeprecationReason(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveDescription(service::ResolverParams&& params);
-	web::json::value resolveArgs(service::ResolverParams&& params);
-	web::json::value resolveType(service::ResolverParams&& params);
-	web::json::value resolveIsDeprecated(service::ResolverParams&& params);
-	web::json::value resolveDeprecationReason(service::ResolverParams&& params);
-
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveArgs(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveType(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveIsDeprecated(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDeprecationReason(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class __InputValue
@@ -167,18 +175,20 @@ protected:
 	__InputValue();
 
 public:
-	virtual std::string getName() const = 0;
-	virtual std::unique_ptr<std::string> getDescription() const = 0;
-	virtual std::shared_ptr<__Type> getType() const = 0;
-	virtual std::unique_ptr<std::string> getDefaultValue() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<__Type>> getType(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDefaultValue(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveDescription(service::ResolverParams&& params);
-	web::json::value resolveType(service::ResolverParams&& params);
-	web::json::value resolveDefaultValue(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveType(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDefaultValue(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class __EnumValue
@@ -188,18 +198,20 @@ protected:
 	__EnumValue();
 
 public:
-	virtual std::string getName() const = 0;
-	virtual std::unique_ptr<std::string> getDescription() const = 0;
-	virtual bool getIsDeprecated() const = 0;
-	virtual std::unique_ptr<std::string> getDeprecationReason() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDescription(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<bool> getIsDeprecated(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getDeprecationReason(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveDescription(service::ResolverParams&& params);
-	web::json::value resolveIsDeprecated(service::ResolverParams&& params);
-	web::json::value resolveDeprecationReason(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDescription(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveIsDeprecated(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveDeprecationReason(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace object */
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_AppointmentFields[] = {
+	"__typename",
+	"id",
+	"isNow",
+	"subject",
+	"when",
+};
+
+static const bool s_AppointmentNullableFields[] = {
+	false,
+	false,
+	false,
+	true,
+	true,
+};
+
+static const service::ObjectType& getAppointmentType()
+{
+	static const service::ObjectType type {
+		"Appointment",
+		{
+			"Node",
+			"Appointment"
+		},
+		{ s_AppointmentFields, 5, s_AppointmentNullableFields }
+	};
+
+	return type;
+}
+
+Appointment::Appointment()
+	: service::Object(getAppointmentType())
+{
+}
+
+std::future<web::json::value> Appointment::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveId(std::move(params));
+
+		case 2:
+			return resolveIsNow(std::move(params));
+
+		case 3:
+			return resolveSubject(std::move(params));
+
+		case 4:
+			return resolveWhen(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Appointment::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::vector<unsigned char>>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Appointment::resolveWhen(service::ResolverParams&& params) const
+{
+	auto result = getWhen(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<web::json::value, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Appointment::resolveSubject(service::ResolverParams&& params) const
+{
+	auto result = getSubject(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Appointment::resolveIsNow(service::ResolverParams&& params) const
+{
+	auto result = getIsNow(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Appointment::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Appointment"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
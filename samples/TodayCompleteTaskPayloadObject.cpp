@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_CompleteTaskPayloadFields[] = {
+	"__typename",
+	"clientMutationId",
+	"task",
+};
+
+static const bool s_CompleteTaskPayloadNullableFields[] = {
+	false,
+	true,
+	true,
+};
+
+static const service::ObjectType& getCompleteTaskPayloadType()
+{
+	static const service::ObjectType type {
+		"CompleteTaskPayload",
+		{
+			"CompleteTaskPayload"
+		},
+		{ s_CompleteTaskPayloadFields, 3, s_CompleteTaskPayloadNullableFields }
+	};
+
+	return type;
+}
+
+CompleteTaskPayload::CompleteTaskPayload()
+	: service::Object(getCompleteTaskPayloadType())
+{
+}
+
+std::future<web::json::value> CompleteTaskPayload::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveClientMutationId(std::move(params));
+
+		case 2:
+			return resolveTask(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> CompleteTaskPayload::resolveTask(service::ResolverParams&& params) const
+{
+	auto result = getTask(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<Task, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> CompleteTaskPayload::resolveClientMutationId(service::ResolverParams&& params) const
+{
+	auto result = getClientMutationId(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> CompleteTaskPayload::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("CompleteTaskPayload"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_FolderConnectionFields[] = {
+	"__typename",
+	"edges",
+	"pageInfo",
+};
+
+static const bool s_FolderConnectionNullableFields[] = {
+	false,
+	true,
+	false,
+};
+
+static const service::ObjectType& getFolderConnectionType()
+{
+	static const service::ObjectType type {
+		"FolderConnection",
+		{
+			"FolderConnection"
+		},
+		{ s_FolderConnectionFields, 3, s_FolderConnectionNullableFields }
+	};
+
+	return type;
+}
+
+FolderConnection::FolderConnection()
+	: service::Object(getFolderConnectionType())
+{
+}
+
+std::future<web::json::value> FolderConnection::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveEdges(std::move(params));
+
+		case 2:
+			return resolvePageInfo(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> FolderConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	auto result = getPageInfo(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> FolderConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	auto result = getEdges(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<FolderEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> FolderConnection::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("FolderConnection"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
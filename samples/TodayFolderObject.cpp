@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_FolderFields[] = {
+	"__typename",
+	"id",
+	"name",
+	"unreadCount",
+};
+
+static const bool s_FolderNullableFields[] = {
+	false,
+	false,
+	true,
+	false,
+};
+
+static const service::ObjectType& getFolderType()
+{
+	static const service::ObjectType type {
+		"Folder",
+		{
+			"Node",
+			"Folder"
+		},
+		{ s_FolderFields, 4, s_FolderNullableFields }
+	};
+
+	return type;
+}
+
+Folder::Folder()
+	: service::Object(getFolderType())
+{
+}
+
+std::future<web::json::value> Folder::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveId(std::move(params));
+
+		case 2:
+			return resolveName(std::move(params));
+
+		case 3:
+			return resolveUnreadCount(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Folder::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::vector<unsigned char>>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Folder::resolveName(service::ResolverParams&& params) const
+{
+	service::addCacheHint(params.operation, { 300, service::CacheScope::Public });
+	auto result = getName(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Folder::resolveUnreadCount(service::ResolverParams&& params) const
+{
+	auto result = getUnreadCount(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<int>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Folder::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Folder"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
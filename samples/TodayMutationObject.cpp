@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_MutationFields[] = {
+	"__typename",
+	"completeTask",
+};
+
+static const bool s_MutationNullableFields[] = {
+	false,
+	false,
+};
+
+static const service::ObjectType& getMutationType()
+{
+	static const service::ObjectType type {
+		"Mutation",
+		{
+			"Mutation"
+		},
+		{ s_MutationFields, 2, s_MutationNullableFields }
+	};
+
+	return type;
+}
+
+Mutation::Mutation()
+	: service::Object(getMutationType())
+{
+}
+
+std::future<web::json::value> Mutation::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveCompleteTask(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Mutation::resolveCompleteTask(service::ResolverParams&& params) const
+{
+	auto argInput = service::ModifiedArgument<CompleteTaskInput>::require("input", params.arguments);
+	auto result = getCompleteTask(service::FieldParams { params.selection, params.operation }, std::move(argInput));
+
+	return service::ModifiedResult<CompleteTaskPayload>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Mutation::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Mutation"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_PageInfoFields[] = {
+	"__typename",
+	"hasNextPage",
+	"hasPreviousPage",
+};
+
+static const bool s_PageInfoNullableFields[] = {
+	false,
+	false,
+	false,
+};
+
+static const service::ObjectType& getPageInfoType()
+{
+	static const service::ObjectType type {
+		"PageInfo",
+		{
+			"PageInfo"
+		},
+		{ s_PageInfoFields, 3, s_PageInfoNullableFields }
+	};
+
+	return type;
+}
+
+PageInfo::PageInfo()
+	: service::Object(getPageInfoType())
+{
+}
+
+std::future<web::json::value> PageInfo::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveHasNextPage(std::move(params));
+
+		case 2:
+			return resolveHasPreviousPage(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> PageInfo::resolveHasNextPage(service::ResolverParams&& params) const
+{
+	auto result = getHasNextPage(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> PageInfo::resolveHasPreviousPage(service::ResolverParams&& params) const
+{
+	auto result = getHasPreviousPage(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> PageInfo::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("PageInfo"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
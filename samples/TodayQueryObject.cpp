@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_QueryFields[] = {
+	"__schema",
+	"__type",
+	"__typename",
+	"appointments",
+	"appointmentsById",
+	"node",
+	"tasks",
+	"tasksById",
+	"unreadCounts",
+	"unreadCountsById",
+};
+
+static const bool s_QueryNullableFields[] = {
+	false,
+	true,
+	false,
+	false,
+	false,
+	true,
+	false,
+	false,
+	false,
+	false,
+};
+
+static const service::ObjectType& getQueryType()
+{
+	static const service::ObjectType type {
+		"Query",
+		{
+			"Query"
+		},
+		{ s_QueryFields, 10, s_QueryNullableFields }
+	};
+
+	return type;
+}
+
+Query::Query()
+	: service::Object(getQueryType())
+	, _schema(std::make_shared<introspection::Schema>())
+{
+	introspection::AddTypesToSchema(_schema);
+	today::AddTypesToSchema(_schema);
+}
+
+std::future<web::json::value> Query::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__schema(std::move(params));
+
+		case 1:
+			return resolve__type(std::move(params));
+
+		case 2:
+			return resolve__typename(std::move(params));
+
+		case 3:
+			return resolveAppointments(std::move(params));
+
+		case 4:
+			return resolveAppointmentsById(std::move(params));
+
+		case 5:
+			return resolveNode(std::move(params));
+
+		case 6:
+			return resolveTasks(std::move(params));
+
+		case 7:
+			return resolveTasksById(std::move(params));
+
+		case 8:
+			return resolveUnreadCounts(std::move(params));
+
+		case 9:
+			return resolveUnreadCountsById(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Query::resolveNode(service::ResolverParams&& params) const
+{
+	auto argId = service::ModifiedArgument<std::vector<unsigned char>>::require("id", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getNode(service::FieldParams { params.selection, params.operation }, std::move(argId));
+
+	return service::ModifiedResult<service::Object, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveAppointments(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
+	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getAppointments(service::FieldParams { params.selection, params.operation }, std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<AppointmentConnection>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveTasks(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
+	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getTasks(service::FieldParams { params.selection, params.operation }, std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<TaskConnection>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveUnreadCounts(service::ResolverParams&& params) const
+{
+	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
+	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
+	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
+	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
+	service::addCacheHint(params.operation, { 30, service::CacheScope::Public });
+	auto result = getUnreadCounts(service::FieldParams { params.selection, params.operation }, std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
+
+	return service::ModifiedResult<FolderConnection>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveAppointmentsById(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getAppointmentsById(service::FieldParams { params.selection, params.operation }, std::move(argIds));
+
+	return service::ModifiedResult<Appointment, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveTasksById(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getTasksById(service::FieldParams { params.selection, params.operation }, std::move(argIds));
+
+	return service::ModifiedResult<Task, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolveUnreadCountsById(service::ResolverParams&& params) const
+{
+	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
+	service::addCacheHint(params.operation, { 0, service::CacheScope::Public });
+	auto result = getUnreadCountsById(service::FieldParams { params.selection, params.operation }, std::move(argIds));
+
+	return service::ModifiedResult<Folder, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Query::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Query"), std::move(params));
+}
+
+std::future<web::json::value> Query::resolve__schema(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<introspection::Schema>::convert(service::FieldResult<std::shared_ptr<introspection::Schema>>(_schema), std::move(params));
+}
+
+std::future<web::json::value> Query::resolve__type(service::ResolverParams&& params) const
+{
+	auto argName = service::ModifiedArgument<std::string>::require("name", params.arguments);
+
+	return service::ModifiedResult<introspection::object::__Type, service::TypeModifier::Nullable>::convert(service::FieldResult<std::shared_ptr<introspection::object::__Type>>(_schema->LookupType(argName)), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -48,16 +48,12 @@ web::json::value service::ModifiedResult<today::TaskState>::convert(const today:
 template <>
 today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(const web::json::value& value)
 {
-	static const auto defaultValue = web::json::value::object({
-		{ _XPLATSTR("isComplete"), web::json::value::parse(_XPLATSTR(R"js(true)js")) }
-	});
+	static const auto defaultIsComplete = web::json::value::parse(_XPLATSTR(R"js(true)js"));
 
-	auto valueId = service::ModifiedArgument<std::vector<unsigned char>>::require("id", value.as_object());
-	auto pairIsComplete = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::find("isComplete", value.as_object());
-	auto valueIsComplete = (pairIsComplete.second
-		? std::move(pairIsComplete.first)
-		: service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("isComplete", defaultValue.as_object()));
-	auto valueClientMutationId = service::ModifiedArgument<std::string, service::TypeModifier::Nullable>::require("clientMutationId", value.as_object());
+	const auto& members = value.as_object();
+	auto valueId = service::ModifiedArgument<std::vector<unsigned char>>::require("id", members);
+	auto valueIsComplete = service::ModifiedArgument<bool, service::TypeModifier::Nullable>::require("isComplete", members, defaultIsComplete);
+	auto valueClientMutationId = service::ModifiedArgument<std::string, service::TypeModifier::Nullable>::require("clientMutationId", members);
 
 	return {
 		std::move(valueId),
@@ -69,532 +65,13 @@ today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(con
 } /* namespace service */
 
 namespace today {
-namespace object {
-
-Query::Query()
-	: service::Object({
-		"Query"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "appointments", [this](service::ResolverParams&& params) { return resolveAppointments(std::move(params)); } },
-		{ "tasks", [this](service::ResolverParams&& params) { return resolveTasks(std::move(params)); } },
-		{ "unreadCounts", [this](service::ResolverParams&& params) { return resolveUnreadCounts(std::move(params)); } },
-		{ "appointmentsById", [this](service::ResolverParams&& params) { return resolveAppointmentsById(std::move(params)); } },
-		{ "tasksById", [this](service::ResolverParams&& params) { return resolveTasksById(std::move(params)); } },
-		{ "unreadCountsById", [this](service::ResolverParams&& params) { return resolveUnreadCountsById(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } },
-		{ "__schema", [this](service::ResolverParams&& params) { return resolve__schema(std::move(params)); } },
-		{ "__type", [this](service::ResolverParams&& params) { return resolve__type(std::move(params)); } }
-	})
-	, _schema(std::make_shared<introspection::Schema>())
-{
-	introspection::AddTypesToSchema(_schema);
-	today::AddTypesToSchema(_schema);
-}
-
-web::json::value Query::resolveNode(service::ResolverParams&& params)
-{
-	auto argId = service::ModifiedArgument<std::vector<unsigned char>>::require("id", params.arguments);
-	auto result = getNode(std::move(argId));
-
-	return service::ModifiedResult<service::Object, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveAppointments(service::ResolverParams&& params)
-{
-	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
-	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
-	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
-	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
-	auto result = getAppointments(std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
-
-	return service::ModifiedResult<AppointmentConnection>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveTasks(service::ResolverParams&& params)
-{
-	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
-	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
-	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
-	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
-	auto result = getTasks(std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
-
-	return service::ModifiedResult<TaskConnection>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveUnreadCounts(service::ResolverParams&& params)
-{
-	auto argFirst = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("first", params.arguments);
-	auto argAfter = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("after", params.arguments);
-	auto argLast = service::ModifiedArgument<int, service::TypeModifier::Nullable>::require("last", params.arguments);
-	auto argBefore = service::ModifiedArgument<web::json::value, service::TypeModifier::Nullable>::require("before", params.arguments);
-	auto result = getUnreadCounts(std::move(argFirst), std::move(argAfter), std::move(argLast), std::move(argBefore));
-
-	return service::ModifiedResult<FolderConnection>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveAppointmentsById(service::ResolverParams&& params)
-{
-	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
-	auto result = getAppointmentsById(std::move(argIds));
-
-	return service::ModifiedResult<Appointment, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveTasksById(service::ResolverParams&& params)
-{
-	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
-	auto result = getTasksById(std::move(argIds));
-
-	return service::ModifiedResult<Task, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolveUnreadCountsById(service::ResolverParams&& params)
-{
-	auto argIds = service::ModifiedArgument<std::vector<unsigned char>, service::TypeModifier::List>::require("ids", params.arguments);
-	auto result = getUnreadCountsById(std::move(argIds));
-
-	return service::ModifiedResult<Folder, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Query::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Query"));
-}
-
-web::json::value Query::resolve__schema(service::ResolverParams&& params)
-{
-	auto result = service::ModifiedResult<introspection::Schema>::convert(_schema, std::move(params));
-
-	return result;
-}
-
-web::json::value Query::resolve__type(service::ResolverParams&& params)
-{
-	auto argName = service::ModifiedArgument<std::string>::require("name", params.arguments);
-	auto result = service::ModifiedResult<introspection::object::__Type, service::TypeModifier::Nullable>::convert(_schema->LookupType(argName), std::move(params));
-
-	return result;
-}
-
-PageInfo::PageInfo()
-	: service::Object({
-		"PageInfo"
-	}, {
-		{ "hasNextPage", [this](service::ResolverParams&& params) { return resolveHasNextPage(std::move(params)); } },
-		{ "hasPreviousPage", [this](service::ResolverParams&& params) { return resolveHasPreviousPage(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value PageInfo::resolveHasNextPage(service::ResolverParams&& params)
-{
-	auto result = getHasNextPage();
-
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
-}
-
-web::json::value PageInfo::resolveHasPreviousPage(service::ResolverParams&& params)
-{
-	auto result = getHasPreviousPage();
-
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
-}
-
-web::json::value PageInfo::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("PageInfo"));
-}
-
-AppointmentEdge::AppointmentEdge()
-	: service::Object({
-		"AppointmentEdge"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "cursor", [this](service::ResolverParams&& params) { return resolveCursor(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value AppointmentEdge::resolveNode(service::ResolverParams&& params)
-{
-	auto result = getNode();
-
-	return service::ModifiedResult<Appointment, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value AppointmentEdge::resolveCursor(service::ResolverParams&& params)
-{
-	auto result = getCursor();
-
-	return service::ModifiedResult<web::json::value>::convert(result, std::move(params));
-}
-
-web::json::value AppointmentEdge::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("AppointmentEdge"));
-}
-
-AppointmentConnection::AppointmentConnection()
-	: service::Object({
-		"AppointmentConnection"
-	}, {
-		{ "pageInfo", [this](service::ResolverParams&& params) { return resolvePageInfo(std::move(params)); } },
-		{ "edges", [this](service::ResolverParams&& params) { return resolveEdges(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value AppointmentConnection::resolvePageInfo(service::ResolverParams&& params)
-{
-	auto result = getPageInfo();
-
-	return service::ModifiedResult<PageInfo>::convert(result, std::move(params));
-}
-
-web::json::value AppointmentConnection::resolveEdges(service::ResolverParams&& params)
-{
-	auto result = getEdges();
-
-	return service::ModifiedResult<AppointmentEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value AppointmentConnection::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("AppointmentConnection"));
-}
-
-TaskEdge::TaskEdge()
-	: service::Object({
-		"TaskEdge"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "cursor", [this](service::ResolverParams&& params) { return resolveCursor(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value TaskEdge::resolveNode(service::ResolverParams&& params)
-{
-	auto result = getNode();
-
-	return service::ModifiedResult<Task, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value TaskEdge::resolveCursor(service::ResolverParams&& params)
-{
-	auto result = getCursor();
-
-	return service::ModifiedResult<web::json::value>::convert(result, std::move(params));
-}
-
-web::json::value TaskEdge::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("TaskEdge"));
-}
-
-TaskConnection::TaskConnection()
-	: service::Object({
-		"TaskConnection"
-	}, {
-		{ "pageInfo", [this](service::ResolverParams&& params) { return resolvePageInfo(std::move(params)); } },
-		{ "edges", [this](service::ResolverParams&& params) { return resolveEdges(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value TaskConnection::resolvePageInfo(service::ResolverParams&& params)
-{
-	auto result = getPageInfo();
-
-	return service::ModifiedResult<PageInfo>::convert(result, std::move(params));
-}
-
-web::json::value TaskConnection::resolveEdges(service::ResolverParams&& params)
-{
-	auto result = getEdges();
-
-	return service::ModifiedResult<TaskEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value TaskConnection::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("TaskConnection"));
-}
-
-FolderEdge::FolderEdge()
-	: service::Object({
-		"FolderEdge"
-	}, {
-		{ "node", [this](service::ResolverParams&& params) { return resolveNode(std::move(params)); } },
-		{ "cursor", [this](service::ResolverParams&& params) { return resolveCursor(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value FolderEdge::resolveNode(service::ResolverParams&& params)
-{
-	auto result = getNode();
-
-	return service::ModifiedResult<Folder, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value FolderEdge::resolveCursor(service::ResolverParams&& params)
-{
-	auto result = getCursor();
-
-	return service::ModifiedResult<web::json::value>::convert(result, std::move(params));
-}
-
-web::json::value FolderEdge::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("FolderEdge"));
-}
-
-FolderConnection::FolderConnection()
-	: service::Object({
-		"FolderConnection"
-	}, {
-		{ "pageInfo", [this](service::ResolverParams&& params) { return resolvePageInfo(std::move(params)); } },
-		{ "edges", [this](service::ResolverParams&& params) { return resolveEdges(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value FolderConnection::resolvePageInfo(service::ResolverParams&& params)
-{
-	auto result = getPageInfo();
-
-	return service::ModifiedResult<PageInfo>::convert(result, std::move(params));
-}
-
-web::json::value FolderConnection::resolveEdges(service::ResolverParams&& params)
-{
-	auto result = getEdges();
-
-	return service::ModifiedResult<FolderEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value FolderConnection::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("FolderConnection"));
-}
-
-CompleteTaskPayload::CompleteTaskPayload()
-	: service::Object({
-		"CompleteTaskPayload"
-	}, {
-		{ "task", [this](service::ResolverParams&& params) { return resolveTask(std::move(params)); } },
-		{ "clientMutationId", [this](service::ResolverParams&& params) { return resolveClientMutationId(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value CompleteTaskPayload::resolveTask(service::ResolverParams&& params)
-{
-	auto result = getTask();
-
-	return service::ModifiedResult<Task, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value CompleteTaskPayload::resolveClientMutationId(service::ResolverParams&& params)
-{
-	auto result = getClientMutationId();
-
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value CompleteTaskPayload::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("CompleteTaskPayload"));
-}
-
-Mutation::Mutation()
-	: service::Object({
-		"Mutation"
-	}, {
-		{ "completeTask", [this](service::ResolverParams&& params) { return resolveCompleteTask(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value Mutation::resolveCompleteTask(service::ResolverParams&& params)
-{
-	auto argInput = service::ModifiedArgument<CompleteTaskInput>::require("input", params.arguments);
-	auto result = getCompleteTask(std::move(argInput));
-
-	return service::ModifiedResult<CompleteTaskPayload>::convert(result, std::move(params));
-}
-
-web::json::value Mutation::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Mutation"));
-}
-
-Subscription::Subscription()
-	: service::Object({
-		"Subscription"
-	}, {
-		{ "nextAppointmentChange", [this](service::ResolverParams&& params) { return resolveNextAppointmentChange(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value Subscription::resolveNextAppointmentChange(service::ResolverParams&& params)
-{
-	auto result = getNextAppointmentChange();
-
-	return service::ModifiedResult<Appointment, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Subscription::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Subscription"));
-}
-
-Appointment::Appointment()
-	: service::Object({
-		"Node",
-		"Appointment"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "when", [this](service::ResolverParams&& params) { return resolveWhen(std::move(params)); } },
-		{ "subject", [this](service::ResolverParams&& params) { return resolveSubject(std::move(params)); } },
-		{ "isNow", [this](service::ResolverParams&& params) { return resolveIsNow(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value Appointment::resolveId(service::ResolverParams&& params)
-{
-	auto result = getId();
-
-	return service::ModifiedResult<std::vector<unsigned char>>::convert(result, std::move(params));
-}
-
-web::json::value Appointment::resolveWhen(service::ResolverParams&& params)
-{
-	auto result = getWhen();
-
-	return service::ModifiedResult<web::json::value, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Appointment::resolveSubject(service::ResolverParams&& params)
-{
-	auto result = getSubject();
-
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Appointment::resolveIsNow(service::ResolverParams&& params)
-{
-	auto result = getIsNow();
-
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
-}
-
-web::json::value Appointment::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Appointment"));
-}
-
-Task::Task()
-	: service::Object({
-		"Node",
-		"Task"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "title", [this](service::ResolverParams&& params) { return resolveTitle(std::move(params)); } },
-		{ "isComplete", [this](service::ResolverParams&& params) { return resolveIsComplete(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value Task::resolveId(service::ResolverParams&& params)
-{
-	auto result = getId();
-
-	return service::ModifiedResult<std::vector<unsigned char>>::convert(result, std::move(params));
-}
-
-web::json::value Task::resolveTitle(service::ResolverParams&& params)
-{
-	auto result = getTitle();
-
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Task::resolveIsComplete(service::ResolverParams&& params)
-{
-	auto result = getIsComplete();
-
-	return service::ModifiedResult<bool>::convert(result, std::move(params));
-}
-
-web::json::value Task::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Task"));
-}
-
-Folder::Folder()
-	: service::Object({
-		"Node",
-		"Folder"
-	}, {
-		{ "id", [this](service::ResolverParams&& params) { return resolveId(std::move(params)); } },
-		{ "name", [this](service::ResolverParams&& params) { return resolveName(std::move(params)); } },
-		{ "unreadCount", [this](service::ResolverParams&& params) { return resolveUnreadCount(std::move(params)); } },
-		{ "__typename", [this](service::ResolverParams&& params) { return resolve__typename(std::move(params)); } }
-	})
-{
-}
-
-web::json::value Folder::resolveId(service::ResolverParams&& params)
-{
-	auto result = getId();
-
-	return service::ModifiedResult<std::vector<unsigned char>>::convert(result, std::move(params));
-}
-
-web::json::value Folder::resolveName(service::ResolverParams&& params)
-{
-	auto result = getName();
-
-	return service::ModifiedResult<std::string, service::TypeModifier::Nullable>::convert(result, std::move(params));
-}
-
-web::json::value Folder::resolveUnreadCount(service::ResolverParams&& params)
-{
-	auto result = getUnreadCount();
-
-	return service::ModifiedResult<int>::convert(result, std::move(params));
-}
-
-web::json::value Folder::resolve__typename(service::ResolverParams&&)
-{
-	return web::json::value::string(_XPLATSTR("Folder"));
-}
-
-} /* namespace object */
 
-Operations::Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription)
+Operations::Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription, service::RequestOptions options)
 	: service::Request({
 		{ "query", query },
 		{ "mutation", mutation },
 		{ "subscription", subscription }
-	})
+	}, std::move(options))
 	, _query(std::move(query))
 	, _mutation(std::move(mutation))
 	, _subscription(std::move(subscription))
@@ -37,7 +37,7 @@ struct CompleteTaskInput
 
 struct Node
 {
-	virtual std::vector<unsigned char> getId() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::vector<unsigned char>>> getId(service::FieldParams&& params) const = 0;
 };
 
 namespace object {
@@ -64,26 +64,28 @@ protected:
 	Query();
 
 public:
-	virtual std::shared_ptr<service::Object> getNode(std::vector<unsigned char>&& id) const = 0;
-	virtual std::shared_ptr<AppointmentConnection> getAppointments(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
-	virtual std::shared_ptr<TaskConnection> getTasks(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
-	virtual std::shared_ptr<FolderConnection> getUnreadCounts(std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
-	virtual std::vector<std::shared_ptr<Appointment>> getAppointmentsById(std::vector<std::vector<unsigned char>>&& ids) const = 0;
-	virtual std::vector<std::shared_ptr<Task>> getTasksById(std::vector<std::vector<unsigned char>>&& ids) const = 0;
-	virtual std::vector<std::shared_ptr<Folder>> getUnreadCountsById(std::vector<std::vector<unsigned char>>&& ids) const = 0;
+	virtual service::FieldResult<std::shared_ptr<service::Object>> getNode(service::FieldParams&& params, std::vector<unsigned char>&& id) const = 0;
+	virtual service::FieldResult<std::shared_ptr<AppointmentConnection>> getAppointments(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
+	virtual service::FieldResult<std::shared_ptr<TaskConnection>> getTasks(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
+	virtual service::FieldResult<std::shared_ptr<FolderConnection>> getUnreadCounts(service::FieldParams&& params, std::unique_ptr<int>&& first, std::unique_ptr<web::json::value>&& after, std::unique_ptr<int>&& last, std::unique_ptr<web::json::value>&& before) const = 0;
+	virtual service::FieldResult<std::vector<std::shared_ptr<Appointment>>> getAppointmentsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const = 0;
+	virtual service::FieldResult<std::vector<std::shared_ptr<Task>>> getTasksById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const = 0;
+	virtual service::FieldResult<std::vector<std::shared_ptr<Folder>>> getUnreadCountsById(service::FieldParams&& params, std::vector<std::vector<unsigned char>>&& ids) const = 0;
 
 private:
-	web::json::value resolveNode(service::ResolverParams&& params);
-	web::json::value resolveAppointments(service::ResolverParams&& params);
-	web::json::value resolveTasks(service::ResolverParams&& params);
-	web::json::value resolveUnreadCounts(service::ResolverParams&& params);
-	web::json::value resolveAppointmentsById(service::ResolverParams&& params);
-	web::json::value resolveTasksById(service::ResolverParams&& params);
-	web::json::value resolveUnreadCountsById(service::ResolverParams&& params);
-
-	web::json::value resolve__typename(service::ResolverParams&& params);
-	web::json::value resolve__schema(service::ResolverParams&& params);
-	web::json::value resolve__type(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveNode(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveAppointments(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveTasks(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveUnreadCounts(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveAppointmentsById(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveTasksById(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveUnreadCountsById(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolve__schema(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolve__type(service::ResolverParams&& params) const;
 
 	std::shared_ptr<introspection::Schema> _schema;
 };
@@ -95,14 +97,16 @@ protected:
 	PageInfo();
 
 public:
-	virtual bool getHasNextPage() const = 0;
-	virtual bool getHasPreviousPage() const = 0;
+	virtual service::FieldResult<bool> getHasNextPage(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<bool> getHasPreviousPage(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveHasNextPage(service::ResolverParams&& params);
-	web::json::value resolveHasPreviousPage(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveHasNextPage(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveHasPreviousPage(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class AppointmentEdge
@@ -112,14 +116,16 @@ protected:
 	AppointmentEdge();
 
 public:
-	virtual std::shared_ptr<Appointment> getNode() const = 0;
-	virtual web::json::value getCursor() const = 0;
+	virtual service::FieldResult<std::shared_ptr<Appointment>> getNode(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<web::json::value> getCursor(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveNode(service::ResolverParams&& params);
-	web::json::value resolveCursor(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveNode(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveCursor(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class AppointmentConnection
@@ -129,14 +135,16 @@ protected:
 	AppointmentConnection();
 
 public:
-	virtual std::shared_ptr<PageInfo> getPageInfo() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<AppointmentEdge>>> getEdges() const = 0;
+	virtual service::FieldResult<std::shared_ptr<PageInfo>> getPageInfo(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<AppointmentEdge>>>> getEdges(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolvePageInfo(service::ResolverParams&& params);
-	web::json::value resolveEdges(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveEdges(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class TaskEdge
@@ -146,14 +154,16 @@ protected:
 	TaskEdge();
 
 public:
-	virtual std::shared_ptr<Task> getNode() const = 0;
-	virtual web::json::value getCursor() const = 0;
+	virtual service::FieldResult<std::shared_ptr<Task>> getNode(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<web::json::value> getCursor(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveNode(service::ResolverParams&& params);
-	web::json::value resolveCursor(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveNode(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveCursor(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class TaskConnection
@@ -163,14 +173,16 @@ protected:
 	TaskConnection();
 
 public:
-	virtual std::shared_ptr<PageInfo> getPageInfo() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<TaskEdge>>> getEdges() const = 0;
+	virtual service::FieldResult<std::shared_ptr<PageInfo>> getPageInfo(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<TaskEdge>>>> getEdges(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolvePageInfo(service::ResolverParams&& params);
-	web::json::value resolveEdges(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveEdges(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class FolderEdge
@@ -180,14 +192,16 @@ protected:
 	FolderEdge();
 
 public:
-	virtual std::shared_ptr<Folder> getNode() const = 0;
-	virtual web::json::value getCursor() const = 0;
+	virtual service::FieldResult<std::shared_ptr<Folder>> getNode(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<web::json::value> getCursor(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveNode(service::ResolverParams&& params);
-	web::json::value resolveCursor(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveNode(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveCursor(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class FolderConnection
@@ -197,14 +211,16 @@ protected:
 	FolderConnection();
 
 public:
-	virtual std::shared_ptr<PageInfo> getPageInfo() const = 0;
-	virtual std::unique_ptr<std::vector<std::shared_ptr<FolderEdge>>> getEdges() const = 0;
+	virtual service::FieldResult<std::shared_ptr<PageInfo>> getPageInfo(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::unique_ptr<std::vector<std::shared_ptr<FolderEdge>>>> getEdges(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolvePageInfo(service::ResolverParams&& params);
-	web::json::value resolveEdges(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolvePageInfo(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveEdges(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class CompleteTaskPayload
@@ -214,14 +230,16 @@ protected:
 	CompleteTaskPayload();
 
 public:
-	virtual std::shared_ptr<Task> getTask() const = 0;
-	virtual std::unique_ptr<std::string> getClientMutationId() const = 0;
+	virtual service::FieldResult<std::shared_ptr<Task>> getTask(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getClientMutationId(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveTask(service::ResolverParams&& params);
-	web::json::value resolveClientMutationId(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveTask(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveClientMutationId(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class Mutation
@@ -231,12 +249,14 @@ protected:
 	Mutation();
 
 public:
-	virtual std::shared_ptr<CompleteTaskPayload> getCompleteTask(CompleteTaskInput&& input) const = 0;
+	virtual service::FieldResult<std::shared_ptr<CompleteTaskPayload>> getCompleteTask(service::FieldParams&& params, CompleteTaskInput&& input) const = 0;
 
 private:
-	web::json::value resolveCompleteTask(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveCompleteTask(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class Subscription
@@ -246,12 +266,14 @@ protected:
 	Subscription();
 
 public:
-	virtual std::shared_ptr<Appointment> getNextAppointmentChange() const = 0;
+	virtual service::FieldResult<std::shared_ptr<Appointment>> getNextAppointmentChange(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveNextAppointmentChange(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveNextAppointmentChange(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class Appointment
@@ -262,17 +284,19 @@ protected:
 	Appointment();
 
 public:
-	virtual std::unique_ptr<web::json::value> getWhen() const = 0;
-	virtual std::unique_ptr<std::string> getSubject() const = 0;
-	virtual bool getIsNow() const = 0;
+	virtual service::FieldResult<std::unique_ptr<web::json::value>> getWhen(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getSubject(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<bool> getIsNow(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveId(service::ResolverParams&& params);
-	web::json::value resolveWhen(service::ResolverParams&& params);
-	web::json::value resolveSubject(service::ResolverParams&& params);
-	web::json::value resolveIsNow(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveId(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveWhen(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveSubject(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveIsNow(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class Task
@@ -283,15 +307,17 @@ protected:
 	Task();
 
 public:
-	virtual std::unique_ptr<std::string> getTitle() const = 0;
-	virtual bool getIsComplete() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getTitle(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<bool> getIsComplete(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveId(service::ResolverParams&& params);
-	web::json::value resolveTitle(service::ResolverParams&& params);
-	web::json::value resolveIsComplete(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolveId(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveTitle(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveIsComplete(service::ResolverParams&& params) const;
+
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 class Folder
@@ -302,15 +328,17 @@ protected:
 	Folder();
 
 public:
-	virtual std::unique_ptr<std::string> getName() const = 0;
-	virtual int getUnreadCount() const = 0;
+	virtual service::FieldResult<std::shared_ptr<const std::string>> getName(service::FieldParams&& params) const = 0;
+	virtual service::FieldResult<int> getUnreadCount(service::FieldParams&& params) const = 0;
 
 private:
-	web::json::value resolveId(service::ResolverParams&& params);
-	web::json::value resolveName(service::ResolverParams&& params);
-	web::json::value resolveUnreadCount(service::ResolverParams&& params);
+	std::future<web::json::value> resolveField(size_t index, service::ResolverParams&& params) const override;
+
+	std::future<web::json::value> resolveId(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveName(service::ResolverParams&& params) const;
+	std::future<web::json::value> resolveUnreadCount(service::ResolverParams&& params) const;
 
-	web::json::value resolve__typename(service::ResolverParams&& params);
+	std::future<web::json::value> resolve__typename(service::ResolverParams&& params) const;
 };
 
 } /* namespace object */
@@ -319,7 +347,7 @@ class Operations
 	: public service::Request
 {
 public:
-	Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription);
+	Operations(std::shared_ptr<object::Query> query, std::shared_ptr<object::Mutation> mutation, std::shared_ptr<object::Subscription> subscription, service::RequestOptions options = {});
 
 private:
 	std::shared_ptr<object::Query> _query;
@@ -330,5 +358,18 @@ private:
 void AddTypesToSchema(std::shared_ptr<introspection::Schema> schema);
 
 } /* namespace today */
+
+namespace service {
+
+template <>
+today::TaskState ModifiedArgument<today::TaskState>::convert(const web::json::value& value);
+
+template <>
+web::json::value ModifiedResult<today::TaskState>::convert(const today::TaskState& value, ResolverParams&&);
+
+template <>
+today::CompleteTaskInput ModifiedArgument<today::CompleteTaskInput>::convert(const web::json::value& value);
+
+} /* namespace service */
 } /* namespace graphql */
 } /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_SubscriptionFields[] = {
+	"__typename",
+	"nextAppointmentChange",
+};
+
+static const bool s_SubscriptionNullableFields[] = {
+	false,
+	true,
+};
+
+static const service::ObjectType& getSubscriptionType()
+{
+	static const service::ObjectType type {
+		"Subscription",
+		{
+			"Subscription"
+		},
+		{ s_SubscriptionFields, 2, s_SubscriptionNullableFields }
+	};
+
+	return type;
+}
+
+Subscription::Subscription()
+	: service::Object(getSubscriptionType())
+{
+}
+
+std::future<web::json::value> Subscription::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveNextAppointmentChange(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Subscription::resolveNextAppointmentChange(service::ResolverParams&& params) const
+{
+	auto result = getNextAppointmentChange(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<Appointment, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Subscription::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Subscription"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
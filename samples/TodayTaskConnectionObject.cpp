@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_TaskConnectionFields[] = {
+	"__typename",
+	"edges",
+	"pageInfo",
+};
+
+static const bool s_TaskConnectionNullableFields[] = {
+	false,
+	true,
+	false,
+};
+
+static const service::ObjectType& getTaskConnectionType()
+{
+	static const service::ObjectType type {
+		"TaskConnection",
+		{
+			"TaskConnection"
+		},
+		{ s_TaskConnectionFields, 3, s_TaskConnectionNullableFields }
+	};
+
+	return type;
+}
+
+TaskConnection::TaskConnection()
+	: service::Object(getTaskConnectionType())
+{
+}
+
+std::future<web::json::value> TaskConnection::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveEdges(std::move(params));
+
+		case 2:
+			return resolvePageInfo(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> TaskConnection::resolvePageInfo(service::ResolverParams&& params) const
+{
+	auto result = getPageInfo(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<PageInfo>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> TaskConnection::resolveEdges(service::ResolverParams&& params) const
+{
+	auto result = getEdges(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<TaskEdge, service::TypeModifier::Nullable, service::TypeModifier::List, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> TaskConnection::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("TaskConnection"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_TaskEdgeFields[] = {
+	"__typename",
+	"cursor",
+	"node",
+};
+
+static const bool s_TaskEdgeNullableFields[] = {
+	false,
+	false,
+	true,
+};
+
+static const service::ObjectType& getTaskEdgeType()
+{
+	static const service::ObjectType type {
+		"TaskEdge",
+		{
+			"TaskEdge"
+		},
+		{ s_TaskEdgeFields, 3, s_TaskEdgeNullableFields }
+	};
+
+	return type;
+}
+
+TaskEdge::TaskEdge()
+	: service::Object(getTaskEdgeType())
+{
+}
+
+std::future<web::json::value> TaskEdge::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveCursor(std::move(params));
+
+		case 2:
+			return resolveNode(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> TaskEdge::resolveNode(service::ResolverParams&& params) const
+{
+	auto result = getNode(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<Task, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> TaskEdge::resolveCursor(service::ResolverParams&& params) const
+{
+	auto result = getCursor(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<web::json::value>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> TaskEdge::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("TaskEdge"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "TodaySchema.h"
+#include "Introspection.h"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+#include <exception>
+
+namespace facebook {
+namespace graphql {
+namespace today {
+namespace object {
+
+static const char* const s_TaskFields[] = {
+	"__typename",
+	"id",
+	"isComplete",
+	"title",
+};
+
+static const bool s_TaskNullableFields[] = {
+	false,
+	false,
+	false,
+	true,
+};
+
+static const service::ObjectType& getTaskType()
+{
+	static const service::ObjectType type {
+		"Task",
+		{
+			"Node",
+			"Task"
+		},
+		{ s_TaskFields, 4, s_TaskNullableFields }
+	};
+
+	return type;
+}
+
+Task::Task()
+	: service::Object(getTaskType())
+{
+}
+
+std::future<web::json::value> Task::resolveField(size_t index, service::ResolverParams&& params) const
+{
+	switch (index)
+	{
+		case 0:
+			return resolve__typename(std::move(params));
+
+		case 1:
+			return resolveId(std::move(params));
+
+		case 2:
+			return resolveIsComplete(std::move(params));
+
+		case 3:
+			return resolveTitle(std::move(params));
+
+		default:
+			return service::Object::resolveField(index, std::move(params));
+	}
+}
+
+std::future<web::json::value> Task::resolveId(service::ResolverParams&& params) const
+{
+	auto result = getId(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::vector<unsigned char>>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Task::resolveTitle(service::ResolverParams&& params) const
+{
+	auto result = getTitle(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<const std::string, service::TypeModifier::Nullable>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Task::resolveIsComplete(service::ResolverParams&& params) const
+{
+	auto result = getIsComplete(service::FieldParams { params.selection, params.operation });
+
+	return service::ModifiedResult<bool>::convert(std::move(result), std::move(params));
+}
+
+std::future<web::json::value> Task::resolve__typename(service::ResolverParams&& params) const
+{
+	return service::ModifiedResult<std::string>::convert(service::FieldResult<std::string>("Task"), std::move(params));
+}
+
+} /* namespace object */
+} /* namespace today */
+} /* namespace graphql */
+} /* namespace facebook */
\ No newline at end of file
@@ -0,0 +1,16 @@
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+
+# Run after schemagen regenerates a schema with --separate-files. Files from the list CMake was
+# configured with which schemagen didn't write this time are left empty, so the rest of this build
+# still compiles. The next build reconfigures with the new list and drops them.
+string(REPLACE "," ";" CONFIGURED_FILES "${CONFIGURED_FILES}")
+file(STRINGS ${SCHEMA_LIST} GENERATED_FILES)
+
+foreach(CONFIGURED_FILE ${CONFIGURED_FILES})
+  list(FIND GENERATED_FILES ${CONFIGURED_FILE} GENERATED_INDEX)
+
+  if(GENERATED_INDEX EQUAL -1)
+    file(WRITE ${CONFIGURED_FILE} "// ${CONFIGURED_FILE} is no longer generated, it's empty until CMake reconfigures.\n")
+  endif()
+endforeach()
@@ -4,9 +4,22 @@
 #include <gtest/gtest.h>
 
 #include "Today.h"
+#include "DocumentCache.h"
+#include "Executor.h"
+#include "Tracing.h"
+#include "Complexity.h"
+#include "PersistedQueries.h"
+#include "Subscriptions.h"
+#include "CacheControl.h"
+#include "Pagination.h"
+#include "Lazy.h"
+#include "Metrics.h"
 
 #include <graphqlparser/GraphQLParser.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace facebook::graphql;
 
 class TodayServiceCase : public ::testing::Test
@@ -26,7 +39,7 @@ protected:
 		_fakeFolderId.resize(fakeFolderId.size());
 		std::copy(fakeFolderId.cbegin(), fakeFolderId.cend(), _fakeFolderId.begin());
 		
-		auto query = std::make_shared<today::Query>(
+		_query = std::make_shared<today::Query>(
 			[this]() -> std::vector<std::shared_ptr<today::Appointment>>
 		{
 			++_getAppointmentsCount;
@@ -40,7 +53,7 @@ protected:
 			++_getUnreadCountsCount;
 			return { std::make_shared<today::Folder>(std::vector<unsigned char>(_fakeFolderId), "\"Fake\" Inbox", 3) };
 		});
-		auto mutation = std::make_shared<today::Mutation>(
+		_mutation = std::make_shared<today::Mutation>(
 			[](today::CompleteTaskInput&& input) -> std::shared_ptr<today::CompleteTaskPayload>
 		{
 			return std::make_shared<today::CompleteTaskPayload>(
@@ -48,15 +61,20 @@ protected:
 				std::move(input.clientMutationId)
 			);
 		});
-		auto subscription = std::make_shared<today::Subscription>();
+		_subscription = std::make_shared<today::Subscription>();
 
-		_service = std::make_shared<today::Operations>(query, mutation, subscription);
+		_documentCache = std::make_shared<service::DocumentCache>();
+		_service = std::make_shared<today::Operations>(_query, _mutation, _subscription, service::RequestOptions { _documentCache, nullptr, 0, nullptr });
 	}
 
 	std::vector<unsigned char> _fakeAppointmentId;
 	std::vector<unsigned char> _fakeTaskId;
 	std::vector<unsigned char> _fakeFolderId;
 
+	std::shared_ptr<today::Query> _query;
+	std::shared_ptr<today::Mutation> _mutation;
+	std::shared_ptr<today::Subscription> _subscription;
+	std::shared_ptr<service::DocumentCache> _documentCache;
 	std::shared_ptr<today::Operations> _service;
 	size_t _getAppointmentsCount = 0;
 	size_t _getTasksCount = 0;
@@ -468,171 +486,1409 @@ TEST_F(TodayServiceCase, Introspection)
 	}
 }
 
-TEST(ArgumentsCase, ListArgumentStrings)
+TEST_F(TodayServiceCase, CachedIntrospection)
 {
-	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
-		"string1",
-		"string2",
-		"string3"
-	]})js"));
-	std::vector<std::string> actual;
+	auto document = service::ParsedDocument::parse(R"gql({
+			__schema {
+				types {
+					kind
+					name
+					fields {
+						name
+						type {
+							kind
+							name
+						}
+					}
+				}
+				queryType {
+					name
+				}
+			}
+		})gql");
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { nullptr, nullptr, 0, nullptr, true });
+	const auto variables = web::json::value::object();
+	auto expected = _service->resolve(*document, "", variables.as_object());
+	auto first = service->resolve(*document, "", variables.as_object());
+	auto second = service->resolve(*document, "", variables.as_object());
+	std::string output;
+	service::ResponseWriter writer(output);
+
+	service->resolve(*document, "", variables.as_object(), writer);
+
+	ASSERT_TRUE(expected.is_object());
+	EXPECT_TRUE(expected.as_object().find(_XPLATSTR("errors")) == expected.as_object().cend()) << "should not have any errors";
+	EXPECT_EQ(expected, first) << "should match the uncached result";
+	EXPECT_EQ(expected, second) << "should match the cached result";
+	EXPECT_EQ(expected, web::json::value::parse(utility::conversions::to_string_t(output))) << "should match the pre-serialized result";
+}
 
-	try
+TEST_F(TodayServiceCase, CachedIntrospectionWithoutDocumentCache)
+{
+	const std::string query(R"gql({
+			__schema {
+				queryType {
+					name
+				}
+			}
+		})gql");
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { nullptr, nullptr, 0, nullptr, true });
+	const auto variables = web::json::value::object();
+	const auto expected = _service->resolve(query, "", variables.as_object());
+
+	for (int i = 0; i < 3; ++i)
 	{
-		actual = service::StringArgument<service::TypeModifier::List>::require("value", jsonListOfStrings.as_object());
+		EXPECT_EQ(expected, service->resolve(query, "", variables.as_object()));
 	}
-	catch (const service::schema_exception& ex)
-	{
-		utility::ostringstream_t errors;
 
-		errors << ex.getErrors();
-		FAIL() << errors.str();
-	}
+	EXPECT_EQ(1, service->getIntrospectionCacheSize()) << "should share the response between documents parsed from the same text";
 
-	ASSERT_EQ(3, actual.size()) << "should get 3 entries";
-	EXPECT_EQ("string1", actual[0]) << "entry should match";
-	EXPECT_EQ("string2", actual[1]) << "entry should match";
-	EXPECT_EQ("string3", actual[2]) << "entry should match";
+	const char* error = nullptr;
+	auto ast = parseString(query.c_str(), &error);
+
+	ASSERT_EQ(nullptr, error) << error;
+	EXPECT_EQ(expected, service->resolve(*ast, "", variables.as_object()));
+	EXPECT_EQ(1, service->getIntrospectionCacheSize()) << "should not cache documents without query text";
 }
 
-TEST(ArgumentsCase, ListArgumentStringsNonNullable)
+TEST_F(TodayServiceCase, ComplexityLimits)
 {
-	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
-		"string1",
-		null,
-		"string2",
-		"string3"
-	]})js"));
-	bool caughtException = false;
-	std::string exceptionWhat;
+	auto limits = std::make_shared<service::ComplexityLimits>();
 
-	try
-	{
-		service::StringArgument<service::TypeModifier::List>::require("value", jsonListOfStrings.as_object());
-	}
-	catch (const service::schema_exception& ex)
-	{
-		utility::ostringstream_t errors;
+	limits->maxDepth = 4;
+	limits->maxCost = 1000;
 
-		errors << ex.getErrors();
-		exceptionWhat = utility::conversions::to_utf8string(errors.str());
-		caughtException = true;
-	}
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { nullptr, nullptr, 0, nullptr, false, limits });
+	auto document = service::ParsedDocument::parse(R"gql(query Appointments($count: Int) {
+			appointments(first: $count) {
+				edges {
+					node {
+						id
+						subject
+					}
+				}
+			}
+		})gql");
+	auto allowed = web::json::value::object({
+		{ _XPLATSTR("count"), web::json::value::number(10) }
+		});
+	auto rejected = web::json::value::object({
+		{ _XPLATSTR("count"), web::json::value::number(1000) }
+		});
+	auto result = service->resolve(*document, "", rejected.as_object());
 
-	ASSERT_TRUE(caughtException);
-	EXPECT_EQ(R"js([{"message":"Invalid argument: value message: not a string"}])js", exceptionWhat) << "exception should match";
+	EXPECT_EQ(0, _getAppointmentsCount) << "should reject the query before resolving anything";
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"Query is too complex, cost: 1001 limit: 1000"}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should report the cost";
+
+	result = service->resolve(*document, "", allowed.as_object());
+
+	EXPECT_EQ(1, _getAppointmentsCount) << "should resolve a query within the limits";
+	EXPECT_TRUE(result.as_object().find(_XPLATSTR("errors")) == result.as_object().cend()) << "should not have any errors";
+
+	result = service->resolve(R"gql({ appointments { edges { node { id } } } __schema { types { fields { type { name } } } } })gql", "", allowed.as_object());
+
+	EXPECT_EQ(1, _getAppointmentsCount) << "should reject the query before resolving anything";
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"Query is too deep, depth: 5 limit: 4"}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should report the depth";
 }
 
-TEST(ArgumentsCase, ListArgumentStringsNullable)
+TEST_F(TodayServiceCase, PersistedQueries)
 {
-	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
-		"string1",
-		"string2",
-		null,
-		"string3"
-	]})js"));
-	std::vector<std::unique_ptr<std::string>> actual;
+	auto store = std::make_shared<service::PersistedQueryStore>();
+	service::RequestOptions options {};
 
-	try
-	{
-		actual = service::StringArgument<
-			service::TypeModifier::List,
-			service::TypeModifier::Nullable
-		>::require("value", jsonListOfStrings.as_object());
-	}
-	catch (const service::schema_exception& ex)
-	{
-		utility::ostringstream_t errors;
+	options.persistedQueries = store;
 
-		errors << ex.getErrors();
-		FAIL() << errors.str();
-	}
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription, std::move(options));
+	const std::string query(R"gql({ appointments { edges { node { subject } } } })gql");
+	const auto hash = service::sha256Hex(query);
+	const auto variables = web::json::value::object();
+	const auto expected = _service->resolve(query, "", variables.as_object());
 
-	ASSERT_EQ(4, actual.size()) << "should get 4 entries";
-	ASSERT_NE(nullptr, actual[0]) << "should not be null";
-	EXPECT_EQ("string1", *actual[0]) << "entry should match";
-	ASSERT_NE(nullptr, actual[1]) << "should not be null";
-	EXPECT_EQ("string2", *actual[1]) << "entry should match";
-	EXPECT_EQ(nullptr, actual[2]) << "should be null";
-	ASSERT_NE(nullptr, actual[3]) << "should not be null";
-	EXPECT_EQ("string3", *actual[3]) << "entry should match";
+	auto result = service->resolve(service::PersistedQuery { hash, "" }, "", variables.as_object());
+
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"PersistedQueryNotFound"}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should ask for the query text";
+
+	result = service->resolve(service::PersistedQuery { hash, query }, "", variables.as_object());
+
+	EXPECT_EQ(expected, result) << "should register and resolve the query";
+	EXPECT_EQ(1, store->size()) << "should register the query";
+
+	result = service->resolve(service::PersistedQuery { hash, "" }, "", variables.as_object());
+
+	EXPECT_EQ(expected, result) << "should resolve the query by its hash";
+
+	result = service->resolve(service::PersistedQuery { service::sha256Hex("{ tasks }"), query }, "", variables.as_object());
+
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"provided sha does not match query"}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should verify the hash";
+	EXPECT_EQ(1, store->size()) << "should not register a query with the wrong hash";
 }
 
-TEST(ArgumentsCase, ListArgumentListArgumentStrings)
+TEST_F(TodayServiceCase, PersistedQueriesFull)
 {
-	auto jsonListOfListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
-		["list1string1", "list1string2"],
-		["list2string1", "list2string2"]
-	]})js"));
-	std::vector<std::vector<std::string>> actual;
+	auto store = std::make_shared<service::PersistedQueryStore>(true, 1);
+	service::RequestOptions options {};
 
-	try
-	{
-		actual = service::StringArgument<
-			service::TypeModifier::List,
-			service::TypeModifier::List
-		>::require("value", jsonListOfListOfStrings.as_object());
-	}
-	catch (const service::schema_exception& ex)
-	{
-		utility::ostringstream_t errors;
+	options.persistedQueries = store;
 
-		errors << ex.getErrors();
-		FAIL() << errors.str();
-	}
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription, std::move(options));
+	const std::string filler(R"gql({ tasks { edges { node { title } } } })gql");
+	const std::string query(R"gql({ appointments { edges { node { subject } } } })gql");
+	const auto hash = service::sha256Hex(query);
+	const auto variables = web::json::value::object();
+	const auto expected = _service->resolve(query, "", variables.as_object());
 
-	ASSERT_EQ(2, actual.size()) << "should get 2 entries";
-	ASSERT_EQ(2, actual[0].size()) << "should get 2 entries";
-	EXPECT_EQ("list1string1", actual[0][0]) << "entry should match";
-	EXPECT_EQ("list1string2", actual[0][1]) << "entry should match";
-	ASSERT_EQ(2, actual[1].size()) << "should get 2 entries";
-	EXPECT_EQ("list2string1", actual[1][0]) << "entry should match";
-	EXPECT_EQ("list2string2", actual[1][1]) << "entry should match";
+	service->resolve(service::PersistedQuery { service::sha256Hex(filler), filler }, "", variables.as_object());
+	ASSERT_EQ(1, store->size());
+
+	auto result = service->resolve(service::PersistedQuery { hash, query }, "", variables.as_object());
+
+	EXPECT_EQ(expected, result) << "should resolve the query text when the store is full";
+	EXPECT_EQ(1, store->size()) << "should not register past maxEntries";
+
+	result = service->resolve(service::PersistedQuery { hash, "" }, "", variables.as_object());
+
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"PersistedQueryNotFound"}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should keep asking for the query text";
+	EXPECT_THROW(store->add(query), service::schema_exception) << "explicit registration should still fail";
 }
 
-TEST(ArgumentsCase, ListArgumentNullableListArgumentStrings)
+TEST_F(TodayServiceCase, QueryEverythingAsync)
 {
-	auto jsonListOfListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
-		null,
-		["list2string1", "list2string2"]
-	]})js"));
-	std::vector<std::unique_ptr<std::vector<std::string>>> actual;
+	auto document = service::ParsedDocument::parse(R"gql(
+		query Everything {
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						when
+						isNow
+					}
+				}
+			}
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+					}
+				}
+			}
+			unreadCounts {
+				edges {
+					node {
+						id
+						name
+						unreadCount
+					}
+				}
+			}
+		})gql");
+	auto expected = _service->resolve(*document, "Everything", web::json::value::object().as_object());
+	auto result = _service->resolve(*document, "Everything", web::json::value::object().as_object(), std::launch::async);
 
-	try
-	{
-		actual = service::StringArgument<
-			service::TypeModifier::List,
-			service::TypeModifier::Nullable,
-			service::TypeModifier::List
-		>::require("value", jsonListOfListOfStrings.as_object());
-	}
-	catch (const service::schema_exception& ex)
-	{
-		utility::ostringstream_t errors;
+	EXPECT_EQ(expected, result) << "resolving fields on other threads should produce the same result";
+	EXPECT_EQ(1, _getAppointmentsCount) << "today service lazy loads the appointments and caches the result";
+	EXPECT_EQ(1, _getTasksCount) << "today service lazy loads the tasks and caches the result";
+	EXPECT_EQ(1, _getUnreadCountsCount) << "today service lazy loads the unreadCounts and caches the result";
+}
 
-		errors << ex.getErrors();
-		FAIL() << errors.str();
-	}
+TEST_F(TodayServiceCase, QueryEverythingThreadPool)
+{
+	auto document = service::ParsedDocument::parse(R"gql(
+		query Everything {
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						when
+						isNow
+					}
+				}
+			}
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+					}
+				}
+			}
+			unreadCounts {
+				edges {
+					node {
+						id
+						name
+						unreadCount
+					}
+				}
+			}
+		})gql");
+	auto executorService = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { _documentCache, std::make_shared<service::ThreadPool>(2), 4, nullptr });
+	auto expected = _service->resolve(*document, "Everything", web::json::value::object().as_object());
+	auto result = executorService->resolve(*document, "Everything", web::json::value::object().as_object());
 
-	ASSERT_EQ(2, actual.size()) << "should get 2 entries";
-	EXPECT_EQ(nullptr, actual[0].get()) << "should be null";
-	ASSERT_EQ(2, actual[1]->size()) << "should get 2 entries";
-	EXPECT_EQ("list2string1", (*actual[1])[0]) << "entry should match";
-	EXPECT_EQ("list2string2", (*actual[1])[1]) << "entry should match";
+	EXPECT_EQ(expected, result) << "resolving fields on the thread pool should produce the same result";
+	EXPECT_EQ(1, _getAppointmentsCount) << "today service lazy loads the appointments and caches the result";
+	EXPECT_EQ(1, _getTasksCount) << "today service lazy loads the tasks and caches the result";
+	EXPECT_EQ(1, _getUnreadCountsCount) << "today service lazy loads the unreadCounts and caches the result";
 }
 
-TEST(ArgumentsCase, TaskStateEnum)
+TEST_F(TodayServiceCase, ParallelListElements)
 {
-	auto jsonTaskState = web::json::value::parse(_XPLATSTR(R"js({"status":"Started"})js"));
-	today::TaskState actual = static_cast<today::TaskState>(-1);
+	auto document = service::ParsedDocument::parse(R"gql({
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql");
+	auto manyAppointments = std::make_shared<today::Query>(
+		[]() -> std::vector<std::shared_ptr<today::Appointment>>
+	{
+		std::vector<std::shared_ptr<today::Appointment>> appointments;
 
-	try
+		for (int i = 0; i < 10; ++i)
+		{
+			appointments.push_back(std::make_shared<today::Appointment>(std::vector<unsigned char> { static_cast<unsigned char>(i) }, "tomorrow", std::to_string(i), false));
+		}
+
+		return appointments;
+	}, []() -> std::vector<std::shared_ptr<today::Task>>
 	{
-		actual = service::ModifiedArgument<today::TaskState>::require("status", jsonTaskState.as_object());
-	}
-	catch (const service::schema_exception& ex)
+		return {};
+	}, []() -> std::vector<std::shared_ptr<today::Folder>>
 	{
-		utility::ostringstream_t errors;
+		return {};
+	});
+	auto sequentialService = std::make_shared<today::Operations>(manyAppointments, _mutation, _subscription);
+	auto parallelService = std::make_shared<today::Operations>(manyAppointments, _mutation, _subscription,
+		service::RequestOptions { nullptr, std::make_shared<service::ThreadPool>(2), 0, nullptr, false, nullptr, nullptr, nullptr, 3 });
+	auto expected = sequentialService->resolve(*document, "", web::json::value::object().as_object());
+	auto result = parallelService->resolve(*document, "", web::json::value::object().as_object());
+
+	EXPECT_EQ(expected, result) << "resolving the list in chunks should produce the same result";
+
+	auto data = service::ScalarArgument<>::require("data", result.as_object());
+	auto appointmentEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+		service::ScalarArgument<>::require("appointments", data.as_object()).as_object());
+	ASSERT_EQ(10, appointmentEdges.size()) << "should resolve every element";
+
+	for (size_t i = 0; i < appointmentEdges.size(); ++i)
+	{
+		auto appointmentNode = service::ScalarArgument<>::require("node", appointmentEdges[i].as_object());
+
+		EXPECT_EQ(std::to_string(i), service::StringArgument<>::require("subject", appointmentNode.as_object())) << "should keep the elements in order";
+	}
+}
+
+TEST_F(TodayServiceCase, BatchOperations)
+{
+	const std::string query = R"gql(query Tasks($taskId: ID!) {
+			tasksById(ids: [$taskId]) {
+				title
+			}
+		}
+		query Appointments {
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql";
+	auto variables = web::json::value::object({
+		{ _XPLATSTR("taskId"), web::json::value::string(utility::conversions::to_base64(_fakeTaskId)) }
+		});
+	auto batchService = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { nullptr, std::make_shared<service::ThreadPool>(2), 0, nullptr });
+	auto results = batchService->resolveBatch({
+		{ query, "Tasks", variables, true },
+		{ "query {", "", web::json::value::null(), false },
+		{ query, "Appointments", web::json::value::null(), true }
+		});
+
+	ASSERT_EQ(3, results.size()) << "should return a response for each operation";
+	EXPECT_EQ(_service->resolve(query, "Tasks", variables.as_object()), results[0]) << "should match resolving the operation on its own";
+	EXPECT_TRUE(results[1].as_object().find(_XPLATSTR("errors")) != results[1].as_object().end()) << "should report the syntax error";
+	EXPECT_EQ(_service->resolve(query, "Appointments", web::json::value::object().as_object()), results[2]) << "should keep the responses in order";
+	EXPECT_EQ(1, _getAppointmentsCount) << "today service lazy loads the appointments and caches the result";
+	EXPECT_EQ(1, _getTasksCount) << "today service lazy loads the tasks and caches the result";
+}
+
+TEST_F(TodayServiceCase, VariableCoercion)
+{
+	const std::string query = R"gql(query TasksById($ids: [ID!]!) {
+			tasksById(ids: $ids) {
+				title
+			}
+		})gql";
+	auto result = _service->resolve(query, "", web::json::value::object({
+		{ _XPLATSTR("ids"), web::json::value::string(utility::conversions::to_base64(_fakeTaskId)) }
+		}).as_object());
+
+	try
+	{
+		auto data = service::ScalarArgument<>::require("data", result.as_object());
+		auto tasks = service::ScalarArgument<service::TypeModifier::List>::require("tasksById", data.as_object());
+
+		ASSERT_EQ(1, tasks.size()) << "should wrap a single ID in a list";
+		EXPECT_EQ("Don't forget", service::StringArgument<>::require("title", tasks[0].as_object()));
+	}
+	catch (const service::schema_exception& ex)
+	{
+		FAIL() << utility::conversions::to_utf8string(ex.getErrors().serialize());
+	}
+
+	result = _service->resolve(query, "", web::json::value::object({
+		{ _XPLATSTR("ids"), web::json::value::array({ web::json::value::number(1) }) }
+		}).as_object());
+
+	auto errors = service::ScalarArgument<service::TypeModifier::List>::require("errors", result.as_object());
+	ASSERT_EQ(1, errors.size());
+	EXPECT_EQ("Invalid value for variable: ids expected: ID line: 1 column: 17", service::StringArgument<>::require("message", errors[0].as_object())) << "should check the type of each element";
+
+	result = _service->resolve(query, "", web::json::value::object().as_object());
+	errors = service::ScalarArgument<service::TypeModifier::List>::require("errors", result.as_object());
+	ASSERT_EQ(1, errors.size());
+	EXPECT_EQ("Missing value for non-null variable: ids line: 1 column: 17", service::StringArgument<>::require("message", errors[0].as_object())) << "should require non-null variables";
+}
+
+TEST_F(TodayServiceCase, ValidateDocuments)
+{
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { _documentCache, nullptr, 0, nullptr, false, nullptr, nullptr, nullptr, 0, true });
+	auto result = service->resolve(R"gql(query Appointments($unused: Int, $count: Int) {
+			appointments(first: $count) {
+				edges {
+					node {
+						subjectLine
+						...TaskFields
+					}
+				}
+			}
+		}
+
+		fragment TaskFields on Task {
+			title
+		})gql", "", web::json::value::object().as_object());
+
+	EXPECT_EQ(0, _getAppointmentsCount) << "should reject the query before resolving anything";
+
+	auto data = result.as_object().find(_XPLATSTR("data"));
+	ASSERT_TRUE(data != result.as_object().cend());
+	EXPECT_TRUE(data->second.is_null());
+
+	auto errors = service::ScalarArgument<service::TypeModifier::List>::require("errors", result.as_object());
+	ASSERT_EQ(3, errors.size()) << "should report every error";
+	EXPECT_EQ("Unknown field name: subjectLine type: Appointment line: 5 column: 7", service::StringArgument<>::require("message", errors[0].as_object()));
+	EXPECT_EQ("Fragment cannot be spread here: TaskFields type: Task parent: Appointment line: 6 column: 7", service::StringArgument<>::require("message", errors[1].as_object()));
+	EXPECT_EQ("Unused variable: unused line: 1 column: 20", service::StringArgument<>::require("message", errors[2].as_object()));
+
+	result = service->resolve(R"gql(query Appointments($count: Int) {
+			appointments(first: $count) {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql", "", web::json::value::object({
+			{ _XPLATSTR("count"), web::json::value::number(1) }
+		}).as_object());
+
+	EXPECT_EQ(1, _getAppointmentsCount) << "should resolve a valid query";
+	EXPECT_TRUE(result.as_object().find(_XPLATSTR("errors")) == result.as_object().cend()) << "should not have any errors";
+}
+
+TEST_F(TodayServiceCase, PartialResults)
+{
+	const std::string query = R"gql({
+			node(id: "abc") {
+				id
+			}
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql";
+	const std::string expected = R"js({"data":{"node":null,"appointments":{"edges":[{"node":{"subject":"Lunch?"}}]}},"errors":[{"message":"Error decoding base64 ID: length of base64 string is not an even multiple of 4","locations":[{"line":2,"column":4}],"path":["node"]}]})js";
+	auto result = _service->resolve(query, "", web::json::value::object().as_object());
+
+	EXPECT_EQ(1, _getAppointmentsCount) << "should resolve the fields which didn't fail";
+	EXPECT_EQ(expected, utility::conversions::to_utf8string(result.serialize())) << "should only null the nullable field";
+
+	std::string output;
+	service::ResponseWriter writer(output);
+
+	_service->resolve(query, "", web::json::value::object().as_object(), writer);
+
+	EXPECT_EQ(expected, output) << "should write the same partial result";
+
+	result = _service->resolve(R"gql({
+			appointments(first: -1) {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql", "", web::json::value::object().as_object());
+
+	EXPECT_EQ(R"js({"data":null,"errors":[{"message":"Invalid argument: first value: -1","locations":[{"line":2,"column":4}],"path":["appointments"]}]})js",
+		utility::conversions::to_utf8string(result.serialize())) << "should null the parent of a non-null field";
+}
+
+TEST_F(TodayServiceCase, RequestMetrics)
+{
+	auto metrics = std::make_shared<service::Metrics>();
+	auto service = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { std::make_shared<service::DocumentCache>(), nullptr, 0, nullptr, false, nullptr, nullptr, nullptr, 0, false, metrics });
+	const std::string query = R"gql({
+			node(id: "abc") {
+				id
+			}
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql";
+	std::string output;
+	service::ResponseWriter writer(output);
+
+	service->resolve(query, "", web::json::value::object().as_object());
+	service->resolve(query, "", web::json::value::object().as_object(), writer);
+
+	const auto snapshot = metrics->getSnapshot();
+
+	EXPECT_EQ(2, snapshot.getCounter(service::MetricCounter::Requests));
+	EXPECT_EQ(1, snapshot.getCounter(service::MetricCounter::DocumentCacheMisses));
+	EXPECT_EQ(1, snapshot.getCounter(service::MetricCounter::DocumentCacheHits));
+	EXPECT_EQ(1, snapshot.getLatency(service::MetricStage::Parse).count) << "should only time the parse which missed the cache";
+	EXPECT_EQ(2, snapshot.getLatency(service::MetricStage::Execute).count);
+	EXPECT_EQ(0, snapshot.getLatency(service::MetricStage::Validate).count) << "validation is off";
+	EXPECT_EQ(output.size(), snapshot.getCounter(service::MetricCounter::BytesWritten));
+	EXPECT_LT(0, snapshot.getCounter(service::MetricCounter::ArenaAllocations)) << "should count the allocations in each operation's arena";
+	EXPECT_LE(snapshot.getCounter(service::MetricCounter::ArenaAllocations), snapshot.getCounter(service::MetricCounter::ArenaBytes));
+	EXPECT_EQ(0, snapshot.activeRequests);
+	ASSERT_EQ(1, snapshot.fieldErrors.size());
+	EXPECT_EQ(2, snapshot.fieldErrors.at("Query.node")) << "should count the field which failed";
+
+	const auto exported = metrics->toPrometheus();
+
+	EXPECT_NE(std::string::npos, exported.find("graphql_requests_total 2\n"));
+	EXPECT_NE(std::string::npos, exported.find("graphql_field_errors_total{type=\"Query\",field=\"node\"} 2\n"));
+}
+
+TEST_F(TodayServiceCase, SelectionLookahead)
+{
+	auto document = service::ParsedDocument::parse(R"gql(query Lookahead($withSubject: Boolean!) {
+			appointments {
+				edges {
+					node {
+						id
+						subject @include(if: $withSubject)
+						...on Appointment {
+							when
+						}
+					}
+				}
+			}
+		})gql");
+	const auto& plan = document->getOperation("");
+	auto variables = web::json::value::object({
+		{ _XPLATSTR("withSubject"), web::json::value::boolean(false) }
+		});
+	service::SelectionLookahead appointments(plan.selection->fields[0].selection.get(), variables.as_object());
+	auto node = appointments.getChild("edges").getChild("node");
+
+	EXPECT_TRUE(appointments.isSelected("edges"));
+	EXPECT_FALSE(appointments.isSelected("pageInfo"));
+	EXPECT_TRUE(node.isSelected("id"));
+	EXPECT_FALSE(node.isSelected("subject")) << "should evaluate @include with the variables";
+	EXPECT_TRUE(node.isSelected("when")) << "should look inside of fragments";
+	EXPECT_FALSE(node.getChild("id").isSelected("id")) << "should not have anything beneath a scalar";
+
+	auto result = _service->resolve(R"gql({
+			appointments {
+				__typename
+			}
+		})gql", "", web::json::value::object().as_object());
+
+	EXPECT_EQ(0, _getAppointmentsCount) << "should not load the appointments without the edges or pageInfo";
+	EXPECT_EQ(R"js({"data":{"appointments":{"__typename":"AppointmentConnection"}}})js", utility::conversions::to_utf8string(result.serialize()));
+
+	result = _service->resolve(R"gql({
+			appointments {
+				pageInfo {
+					hasNextPage
+				}
+			}
+		})gql", "", web::json::value::object().as_object());
+
+	EXPECT_EQ(1, _getAppointmentsCount) << "should load the appointments for the pageInfo";
+}
+
+TEST_F(TodayServiceCase, SharedQueryRoot)
+{
+	std::vector<std::thread> threads;
+	std::atomic<size_t> matches(0);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([this, &matches]()
+		{
+			auto result = _service->resolve(R"gql({
+					appointments {
+						edges {
+							node {
+								subject
+							}
+						}
+					}
+					tasks {
+						edges {
+							node {
+								title
+							}
+						}
+					}
+				})gql", "", web::json::value::object().as_object());
+
+			if (result.as_object().find(_XPLATSTR("errors")) == result.as_object().cend())
+			{
+				++matches;
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(8, matches) << "every request should succeed";
+	EXPECT_EQ(1, _getAppointmentsCount) << "should load the appointments once for every thread";
+	EXPECT_EQ(1, _getTasksCount) << "should load the tasks once for every thread";
+}
+
+TEST_F(TodayServiceCase, QueryNodesById)
+{
+	auto document = service::ParsedDocument::parse(R"gql(
+		query NodesById($appointmentId: ID!, $taskId: ID!) {
+			appointment: node(id: $appointmentId) {
+				...on Appointment {
+					subject
+				}
+			}
+			task: node(id: $taskId) {
+				...on Task {
+					title
+				}
+			}
+			tasksById(ids: [$taskId, $appointmentId]) {
+				title
+			}
+		})gql");
+	auto variables = web::json::value::object({
+		{ _XPLATSTR("appointmentId"), web::json::value::string(utility::conversions::to_base64(_fakeAppointmentId)) },
+		{ _XPLATSTR("taskId"), web::json::value::string(utility::conversions::to_base64(_fakeTaskId)) }
+		});
+	auto result = _service->resolve(*document, "NodesById", variables.as_object());
+	auto expected = web::json::value::parse(_XPLATSTR(R"js({"data":{
+			"appointment": { "subject": "Lunch?" },
+			"task": { "title": "Don't forget" },
+			"tasksById": [ { "title": "Don't forget" }, null ]
+		}})js"));
+
+	EXPECT_EQ(expected, result) << "should find each of the nodes by id";
+	EXPECT_EQ(1, _getAppointmentsCount) << "today service lazy loads the appointments and caches the result";
+	EXPECT_EQ(1, _getTasksCount) << "today service lazy loads the tasks and caches the result";
+	EXPECT_EQ(0, _getUnreadCountsCount) << "should find every node before it needs the unreadCounts";
+}
+
+TEST_F(TodayServiceCase, ApolloTracing)
+{
+	auto tracedService = std::make_shared<today::Operations>(_query, _mutation, _subscription,
+		service::RequestOptions { _documentCache, nullptr, 0, std::make_shared<service::ApolloTracing>() });
+	auto document = service::ParsedDocument::parse(R"gql({
+			appointments {
+				edges {
+					node {
+						id
+					}
+				}
+			}
+		})gql");
+	auto expected = _service->resolve(*document, "", web::json::value::object().as_object());
+	auto result = tracedService->resolve(*document, "", web::json::value::object().as_object());
+
+	try
+	{
+		ASSERT_TRUE(result.is_object());
+		EXPECT_EQ(service::ScalarArgument<>::require("data", expected.as_object()), service::ScalarArgument<>::require("data", result.as_object())) << "tracing should not change the data";
+
+		auto extensions = service::ScalarArgument<>::require("extensions", result.as_object());
+		auto tracing = service::ScalarArgument<>::require("tracing", extensions.as_object());
+		EXPECT_EQ(1, service::IntArgument<>::require("version", tracing.as_object())) << "should follow version 1 of the format";
+
+		auto execution = service::ScalarArgument<>::require("execution", tracing.as_object());
+		auto resolvers = service::ScalarArgument<service::TypeModifier::List>::require("resolvers", execution.as_object());
+		ASSERT_EQ(4, resolvers.size()) << "should trace every resolver";
+
+		auto idPath = web::json::value::array(5);
+		idPath[0] = web::json::value::string(_XPLATSTR("appointments"));
+		idPath[1] = web::json::value::string(_XPLATSTR("edges"));
+		idPath[2] = web::json::value::number(0);
+		idPath[3] = web::json::value::string(_XPLATSTR("node"));
+		idPath[4] = web::json::value::string(_XPLATSTR("id"));
+
+		auto itrId = std::find_if(resolvers.cbegin(), resolvers.cend(),
+			[&idPath](const web::json::value& resolver)
+		{
+			return resolver.as_object().find(_XPLATSTR("path"))->second == idPath;
+		});
+		ASSERT_TRUE(itrId != resolvers.cend()) << "should include the path through the list";
+		EXPECT_EQ("Appointment", service::StringArgument<>::require("parentType", itrId->as_object())) << "parentType should match";
+		EXPECT_EQ("id", service::StringArgument<>::require("fieldName", itrId->as_object())) << "fieldName should match";
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+}
+
+TEST_F(TodayServiceCase, QueryTextCache)
+{
+	const std::string query(R"gql({
+			tasks {
+				edges {
+					node {
+						title
+					}
+				}
+			}
+		})gql");
+
+	auto first = _service->resolve(query, "", web::json::value::object().as_object());
+	auto second = _service->resolve(query, "", web::json::value::object().as_object());
+	auto stats = _documentCache->getStats();
+
+	EXPECT_EQ(1, stats.misses) << "the first request should parse the query";
+	EXPECT_EQ(1, stats.hits) << "the second request should reuse the parsed query";
+	EXPECT_EQ(1, stats.entries) << "there should be a single cached document";
+	EXPECT_EQ(first, second) << "cached documents should resolve to the same result";
+
+	try
+	{
+		ASSERT_TRUE(second.is_object());
+		ASSERT_TRUE(second.as_object().find(_XPLATSTR("errors")) == second.as_object().cend()) << "should not have any errors";
+		auto data = service::ScalarArgument<>::require("data", second.as_object());
+		auto taskEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+			service::ScalarArgument<>::require("tasks", data.as_object()).as_object());
+		ASSERT_EQ(1, taskEdges.size()) << "tasks should have 1 entry";
+		auto taskNode = service::ScalarArgument<>::require("node", taskEdges[0].as_object());
+		EXPECT_EQ("Don't forget", service::StringArgument<>::require("title", taskNode.as_object())) << "title should match";
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+}
+
+TEST_F(TodayServiceCase, QueryTextSyntaxError)
+{
+	auto result = _service->resolve(std::string("{ tasks { edges "), "", web::json::value::object().as_object());
+	auto stats = _documentCache->getStats();
+
+	EXPECT_EQ(0, stats.entries) << "documents with syntax errors should not be cached";
+
+	ASSERT_TRUE(result.is_object());
+	auto errorsItr = result.as_object().find(_XPLATSTR("errors"));
+	ASSERT_TRUE(errorsItr != result.as_object().cend()) << "should report the syntax error";
+	EXPECT_TRUE(result.as_object().find(_XPLATSTR("data"))->second.is_null()) << "data should be null";
+}
+
+TEST_F(TodayServiceCase, ReusePlanWithVariables)
+{
+	auto document = service::ParsedDocument::parse(R"gql(
+		query Folders($withName: Boolean!) {
+			unreadCounts {
+				edges {
+					node {
+						...FolderFields
+					}
+				}
+			}
+		}
+
+		fragment FolderFields on Folder {
+			unreadCount
+			... @include(if: $withName) {
+				name
+			}
+			id @skip(if: true)
+		})gql");
+
+	for (bool withName : { true, false })
+	{
+		auto variables = web::json::value::object({
+			{ _XPLATSTR("withName"), web::json::value::boolean(withName) }
+		});
+		auto result = _service->resolve(*document, "", variables.as_object());
+
+		try
+		{
+			ASSERT_TRUE(result.is_object());
+			ASSERT_TRUE(result.as_object().find(_XPLATSTR("errors")) == result.as_object().cend()) << "should not have any errors";
+			auto data = service::ScalarArgument<>::require("data", result.as_object());
+			auto unreadCountEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+				service::ScalarArgument<>::require("unreadCounts", data.as_object()).as_object());
+			ASSERT_EQ(1, unreadCountEdges.size()) << "unreadCounts should have 1 entry";
+			auto unreadCountNode = service::ScalarArgument<>::require("node", unreadCountEdges[0].as_object());
+			const web::json::object& folder = unreadCountNode.as_object();
+			EXPECT_EQ(3, service::IntArgument<>::require("unreadCount", folder)) << "unreadCount should match";
+			EXPECT_EQ(withName, folder.find(_XPLATSTR("name")) != folder.cend()) << "name should depend on the variable";
+			EXPECT_TRUE(folder.find(_XPLATSTR("id")) == folder.cend()) << "id should always be skipped";
+		}
+		catch (const service::schema_exception& ex)
+		{
+			utility::ostringstream_t errors;
+
+			errors << ex.getErrors();
+			FAIL() << errors.str();
+		}
+	}
+
+	EXPECT_EQ(1, _getUnreadCountsCount) << "today service lazy loads the unreadCounts and caches the result";
+}
+
+TEST_F(TodayServiceCase, FragmentCycle)
+{
+	auto result = _service->resolve(std::string(R"gql({
+			unreadCounts {
+				...First
+			}
+		}
+
+		fragment First on FolderConnection {
+			...Second
+		}
+
+		fragment Second on FolderConnection {
+			...First
+		})gql"), "", web::json::value::object().as_object());
+
+	ASSERT_TRUE(result.is_object());
+	auto errorsItr = result.as_object().find(_XPLATSTR("errors"));
+	ASSERT_TRUE(errorsItr != result.as_object().cend()) << "should report the fragment cycle";
+	EXPECT_TRUE(result.as_object().find(_XPLATSTR("data"))->second.is_null()) << "data should be null";
+	EXPECT_EQ(0, _getUnreadCountsCount) << "should not execute the operation";
+}
+
+TEST_F(TodayServiceCase, StreamResponse)
+{
+	auto document = service::ParsedDocument::parse(R"gql({
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						when
+						isNow
+					}
+				}
+			}
+			tasks {
+				edges {
+					node {
+						id
+						title
+						isComplete
+					}
+				}
+			}
+			unreadCounts {
+				edges {
+					node {
+						id
+						name
+						unreadCount
+					}
+				}
+			}
+		})gql");
+	auto expected = _service->resolve(*document, "", web::json::value::object().as_object());
+	std::vector<std::string> chunks;
+	service::ResponseWriter writer([&chunks](const std::string& chunk)
+	{
+		chunks.push_back(chunk);
+	}, 64);
+
+	_service->resolve(*document, "", web::json::value::object().as_object(), writer);
+
+	std::string output;
+
+	for (const auto& chunk : chunks)
+	{
+		output.append(chunk);
+	}
+
+	EXPECT_LT(1, chunks.size()) << "should write the response in multiple chunks";
+	EXPECT_EQ(expected, web::json::value::parse(utility::conversions::to_string_t(output))) << "should match the JSON value result";
+}
+
+TEST_F(TodayServiceCase, CborResponse)
+{
+	std::string output;
+	service::ResponseWriter writer(output, service::ResponseEncoding::Cbor);
+
+	_service->resolve(std::string(R"gql({
+			appointments {
+				edges {
+					node {
+						id
+						subject
+						isNow
+					}
+				}
+			}
+		})gql"), "", web::json::value::object().as_object(), writer);
+
+	const auto text = [](const std::string& value)
+	{
+		return std::string(1, static_cast<char>(0x60 + value.size())) + value;
+	};
+	const std::string expected = "\xBF" + text("data")
+		+ "\xBF" + text("appointments")
+		+ "\xBF" + text("edges")
+		+ "\x9F\xBF" + text("node")
+		+ "\xBF" + text("id") + "\x51" + std::string(_fakeAppointmentId.cbegin(), _fakeAppointmentId.cend())
+		+ text("subject") + text("Lunch?")
+		+ text("isNow") + "\xF4"
+		+ "\xFF\xFF\xFF\xFF\xFF\xFF";
+
+	EXPECT_EQ(expected, output) << "should write CBOR with the ID as a byte string";
+}
+
+TEST_F(TodayServiceCase, StreamResponseError)
+{
+	std::string output;
+	service::ResponseWriter writer(output);
+
+	_service->resolve(std::string(R"gql({
+			tasks {
+				edges {
+					node {
+						title
+					}
+				}
+			}
+			unreadCounts {
+				edges {
+					node {
+						unknownField
+					}
+				}
+			}
+		})gql"), "", web::json::value::object().as_object(), writer);
+
+	auto result = web::json::value::parse(utility::conversions::to_string_t(output));
+
+	ASSERT_TRUE(result.is_object());
+	ASSERT_TRUE(result.as_object().find(_XPLATSTR("errors")) != result.as_object().cend()) << "should report the unknown field";
+	auto data = service::ScalarArgument<>::require("data", result.as_object());
+	auto taskEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+		service::ScalarArgument<>::require("tasks", data.as_object()).as_object());
+	ASSERT_EQ(1, taskEdges.size()) << "tasks should have 1 entry";
+	auto taskNode = service::ScalarArgument<>::require("node", taskEdges[0].as_object());
+	EXPECT_EQ("Don't forget", service::StringArgument<>::require("title", taskNode.as_object())) << "should keep the data written before the error";
+}
+
+TEST_F(TodayServiceCase, IncrementalDelivery)
+{
+	auto document = service::ParsedDocument::parse(R"gql({
+			appointments {
+				edges @stream(initialCount: 0) {
+					node {
+						subject
+					}
+				}
+			}
+			... @defer(label: "tasks") {
+				tasks {
+					edges {
+						node {
+							title
+						}
+					}
+				}
+			}
+		})gql");
+	std::vector<web::json::value> payloads;
+
+	_service->resolveIncremental(*document, "", web::json::value::object().as_object(),
+		[&payloads](web::json::value&& payload)
+	{
+		payloads.push_back(std::move(payload));
+	});
+
+	ASSERT_EQ(3, payloads.size()) << "should deliver the initial payload and 2 patches";
+
+	auto initial = service::ScalarArgument<>::require("data", payloads[0].as_object());
+	auto appointmentEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+		service::ScalarArgument<>::require("appointments", initial.as_object()).as_object());
+	EXPECT_TRUE(appointmentEdges.empty()) << "should stream every appointment edge later";
+	EXPECT_TRUE(initial.as_object().find(_XPLATSTR("tasks")) == initial.as_object().cend()) << "should defer the tasks";
+	EXPECT_TRUE(service::BooleanArgument<>::require("hasNext", payloads[0].as_object())) << "should have more payloads";
+
+	auto deferred = service::ScalarArgument<>::require("data", payloads[1].as_object());
+	auto taskEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+		service::ScalarArgument<>::require("tasks", deferred.as_object()).as_object());
+	ASSERT_EQ(1, taskEdges.size()) << "tasks should have 1 entry";
+	auto taskNode = service::ScalarArgument<>::require("node", taskEdges[0].as_object());
+	EXPECT_EQ("Don't forget", service::StringArgument<>::require("title", taskNode.as_object())) << "should resolve the deferred fields";
+	EXPECT_EQ("tasks", service::StringArgument<>::require("label", payloads[1].as_object())) << "should pass along the label";
+	EXPECT_TRUE(service::ScalarArgument<service::TypeModifier::List>::require("path", payloads[1].as_object()).empty()) << "should defer the root selection set";
+	EXPECT_TRUE(service::BooleanArgument<>::require("hasNext", payloads[1].as_object())) << "should have more payloads";
+
+	auto items = service::ScalarArgument<service::TypeModifier::List>::require("items", payloads[2].as_object());
+	ASSERT_EQ(1, items.size()) << "should stream 1 appointment edge";
+	auto appointmentNode = service::ScalarArgument<>::require("node", items[0].as_object());
+	EXPECT_EQ("Lunch?", service::StringArgument<>::require("subject", appointmentNode.as_object())) << "should resolve the streamed element";
+	EXPECT_EQ(web::json::value::parse(_XPLATSTR(R"js(["appointments","edges",0])js")),
+		payloads[2].at(_XPLATSTR("path"))) << "should end the path with the index of the element";
+	EXPECT_FALSE(service::BooleanArgument<>::require("hasNext", payloads[2].as_object())) << "should be the last payload";
+
+	auto result = _service->resolve(*document, "", web::json::value::object().as_object());
+	auto data = service::ScalarArgument<>::require("data", result.as_object());
+	EXPECT_TRUE(data.as_object().find(_XPLATSTR("tasks")) != data.as_object().cend()) << "should resolve deferred fields inline without incremental delivery";
+	appointmentEdges = service::ScalarArgument<service::TypeModifier::List>::require("edges",
+		service::ScalarArgument<>::require("appointments", data.as_object()).as_object());
+	EXPECT_EQ(1, appointmentEdges.size()) << "should resolve streamed lists inline without incremental delivery";
+}
+
+TEST_F(TodayServiceCase, ResultCache)
+{
+	auto resultCache = std::make_shared<service::MemoryResultCache>();
+	service::RequestOptions options { _documentCache, nullptr, 0, nullptr, false, nullptr, nullptr, resultCache };
+	auto cachedService = std::make_shared<today::Operations>(_query, _mutation, _subscription, options);
+	const std::string query(R"gql({
+			unreadCounts {
+				edges {
+					node {
+						name
+						unreadCount
+					}
+				}
+			}
+		})gql");
+	auto result = cachedService->resolve(query, "", web::json::value::object().as_object());
+	auto cacheControl = service::ScalarArgument<>::require("cacheControl",
+		service::ScalarArgument<>::require("extensions", result.as_object()).as_object());
+
+	EXPECT_EQ(30, service::IntArgument<>::require("maxAge", cacheControl.as_object())) << "should use the shortest maxAge";
+	EXPECT_EQ("PUBLIC", service::StringArgument<>::require("scope", cacheControl.as_object())) << "should be public";
+	EXPECT_EQ(1, resultCache->size()) << "should cache the result";
+
+	size_t getUnreadCountsCount = 0;
+	auto otherQuery = std::make_shared<today::Query>(
+		[]() -> std::vector<std::shared_ptr<today::Appointment>>
+	{
+		return {};
+	}, []() -> std::vector<std::shared_ptr<today::Task>>
+	{
+		return {};
+	}, [&getUnreadCountsCount]() -> std::vector<std::shared_ptr<today::Folder>>
+	{
+		++getUnreadCountsCount;
+		return {};
+	});
+	auto otherService = std::make_shared<today::Operations>(otherQuery, _mutation, _subscription, options);
+
+	auto cachedResult = otherService->resolve(query, "", web::json::value::object().as_object());
+
+	EXPECT_EQ(result[_XPLATSTR("data")], cachedResult[_XPLATSTR("data")]) << "should return the cached result";
+	EXPECT_GE(30, cachedResult[_XPLATSTR("extensions")][_XPLATSTR("cacheControl")][_XPLATSTR("maxAge")].as_integer()) << "should not report more than the original maxAge";
+	EXPECT_EQ(0, getUnreadCountsCount) << "should not execute the cached query";
+
+	result = cachedService->resolve(std::string(R"gql({
+			unreadCounts {
+				edges {
+					node {
+						name
+					}
+				}
+			}
+			appointments {
+				edges {
+					node {
+						subject
+					}
+				}
+			}
+		})gql"), "", web::json::value::object().as_object());
+
+	EXPECT_TRUE(result.as_object().find(_XPLATSTR("extensions")) == result.as_object().cend()) << "should not be cacheable with a root field that has no hint";
+	EXPECT_EQ(1, resultCache->size()) << "should not cache the result";
+
+	service::MemoryResultCache disabled(0);
+
+	disabled.store("key", std::make_shared<const service::CachedResult>(service::CachedResult { web::json::value::object(), { 30, service::CacheScope::Public }, std::chrono::steady_clock::now() }));
+	EXPECT_EQ(0, disabled.size()) << "should not store anything with maxEntries of 0";
+}
+
+// Pretend every result was stored 10 seconds before it actually was.
+class AgedResultCache : public service::MemoryResultCache
+{
+public:
+	void store(const std::string& key, std::shared_ptr<const service::CachedResult> result) override
+	{
+		service::MemoryResultCache::store(key, std::make_shared<const service::CachedResult>(service::CachedResult {
+			result->data, result->hint, result->stored - std::chrono::seconds(10) }));
+	}
+};
+
+TEST_F(TodayServiceCase, ResultCacheRemainingAge)
+{
+	service::RequestOptions options { _documentCache, nullptr, 0, nullptr, false, nullptr, nullptr, std::make_shared<AgedResultCache>() };
+	auto cachedService = std::make_shared<today::Operations>(_query, _mutation, _subscription, options);
+	const std::string query(R"gql({
+			unreadCounts {
+				edges {
+					node {
+						unreadCount
+					}
+				}
+			}
+		})gql");
+
+	cachedService->resolve(query, "", web::json::value::object().as_object());
+
+	auto result = cachedService->resolve(query, "", web::json::value::object().as_object());
+	auto cacheControl = service::ScalarArgument<>::require("cacheControl",
+		service::ScalarArgument<>::require("extensions", result.as_object()).as_object());
+	const auto maxAge = service::IntArgument<>::require("maxAge", cacheControl.as_object());
+
+	EXPECT_GE(20, maxAge) << "should only report the time left on a cached result";
+	EXPECT_LE(19, maxAge) << "should only report the time left on a cached result";
+}
+
+class NextAppointmentChange : public today::object::Subscription
+{
+public:
+	explicit NextAppointmentChange(std::shared_ptr<today::Appointment> appointment)
+		: _appointment(std::move(appointment))
+	{
+	}
+
+	service::FieldResult<std::shared_ptr<today::object::Appointment>> getNextAppointmentChange(service::FieldParams&& /*params*/) const override
+	{
+		++_resolveCount;
+		return std::static_pointer_cast<today::object::Appointment>(_appointment);
+	}
+
+	size_t getResolveCount() const
+	{
+		return _resolveCount;
+	}
+
+private:
+	std::shared_ptr<today::Appointment> _appointment;
+	mutable size_t _resolveCount = 0;
+};
+
+TEST_F(TodayServiceCase, SubscriptionManager)
+{
+	const std::string query(R"gql(subscription TestSubscription($withSubject: Boolean = true) {
+			nextAppointmentChange {
+				when
+				subject @include(if: $withSubject)
+			}
+		})gql");
+	service::SubscriptionManager subscriptions(_service);
+	std::vector<web::json::value> first;
+	std::vector<web::json::value> second;
+	std::vector<web::json::value> withoutSubject;
+
+	auto firstKey = subscriptions.subscribe(query, "TestSubscription", web::json::value::object().as_object(),
+		[&first](const web::json::value& payload)
+	{
+		first.push_back(payload);
+	});
+	subscriptions.subscribe(query, "TestSubscription", web::json::value::object().as_object(),
+		[&second](const web::json::value& payload)
+	{
+		second.push_back(payload);
+	});
+	subscriptions.subscribe(query, "TestSubscription", web::json::value::parse(_XPLATSTR(R"js({"withSubject":false})js")).as_object(),
+		[&withoutSubject](const web::json::value& payload)
+	{
+		withoutSubject.push_back(payload);
+	});
+
+	EXPECT_EQ(3, subscriptions.getSubscriptionCount()) << "should register every subscriber";
+	EXPECT_EQ(2, subscriptions.getGroupCount()) << "should share a group for the same query and variables";
+
+	auto event = std::make_shared<NextAppointmentChange>(std::make_shared<today::Appointment>(std::vector<unsigned char>(_fakeAppointmentId), "tomorrow", "Lunch?", false));
+
+	subscriptions.deliver("nextAppointmentChange", event);
+	subscriptions.deliver("someOtherField", event);
+
+	EXPECT_EQ(2, event->getResolveCount()) << "should resolve the event once for each group";
+	ASSERT_EQ(1, first.size()) << "should only deliver events for the selected field";
+	ASSERT_EQ(1, second.size()) << "should only deliver events for the selected field";
+	ASSERT_EQ(1, withoutSubject.size()) << "should only deliver events for the selected field";
+	EXPECT_EQ(first.front(), second.front()) << "should share the payload within a group";
+
+	auto data = service::ScalarArgument<>::require("data", first.front().as_object());
+	auto appointment = service::ScalarArgument<>::require("nextAppointmentChange", data.as_object());
+	EXPECT_EQ("Lunch?", service::StringArgument<>::require("subject", appointment.as_object())) << "should resolve the selection set against the event";
+	data = service::ScalarArgument<>::require("data", withoutSubject.front().as_object());
+	appointment = service::ScalarArgument<>::require("nextAppointmentChange", data.as_object());
+	EXPECT_TRUE(appointment.as_object().find(_XPLATSTR("subject")) == appointment.as_object().cend()) << "should use the variables for each group";
+
+	subscriptions.unsubscribe(firstKey);
+	subscriptions.deliver("nextAppointmentChange", event);
+
+	EXPECT_EQ(1, first.size()) << "should not deliver events after unsubscribing";
+	EXPECT_EQ(2, second.size()) << "should keep delivering to the rest of the group";
+	EXPECT_EQ(2, subscriptions.getGroupCount()) << "should keep the group while it has subscribers";
+
+	try
+	{
+		subscriptions.subscribe("{ appointments { pageInfo { hasNextPage } } }", "", web::json::value::object().as_object(), [](const web::json::value&) {});
+		FAIL() << "should reject operations which aren't subscriptions";
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		EXPECT_NE(std::string::npos, utility::conversions::to_utf8string(errors.str()).find("Not a subscription operation: query")) << "should report the operation type";
+	}
+}
+
+TEST(ArgumentsCase, ListArgumentStrings)
+{
+	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
+		"string1",
+		"string2",
+		"string3"
+	]})js"));
+	std::vector<std::string> actual;
+
+	try
+	{
+		actual = service::StringArgument<service::TypeModifier::List>::require("value", jsonListOfStrings.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+
+	ASSERT_EQ(3, actual.size()) << "should get 3 entries";
+	EXPECT_EQ("string1", actual[0]) << "entry should match";
+	EXPECT_EQ("string2", actual[1]) << "entry should match";
+	EXPECT_EQ("string3", actual[2]) << "entry should match";
+}
+
+TEST(ArgumentsCase, ListArgumentStringsNonNullable)
+{
+	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
+		"string1",
+		null,
+		"string2",
+		"string3"
+	]})js"));
+	bool caughtException = false;
+	std::string exceptionWhat;
+
+	try
+	{
+		service::StringArgument<service::TypeModifier::List>::require("value", jsonListOfStrings.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		exceptionWhat = utility::conversions::to_utf8string(errors.str());
+		caughtException = true;
+	}
+
+	ASSERT_TRUE(caughtException);
+	EXPECT_EQ(R"js([{"message":"Invalid argument: value message: not a string"}])js", exceptionWhat) << "exception should match";
+}
+
+TEST(ArgumentsCase, ListArgumentStringsNullable)
+{
+	auto jsonListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
+		"string1",
+		"string2",
+		null,
+		"string3"
+	]})js"));
+	std::vector<std::unique_ptr<std::string>> actual;
+
+	try
+	{
+		actual = service::StringArgument<
+			service::TypeModifier::List,
+			service::TypeModifier::Nullable
+		>::require("value", jsonListOfStrings.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+
+	ASSERT_EQ(4, actual.size()) << "should get 4 entries";
+	ASSERT_NE(nullptr, actual[0]) << "should not be null";
+	EXPECT_EQ("string1", *actual[0]) << "entry should match";
+	ASSERT_NE(nullptr, actual[1]) << "should not be null";
+	EXPECT_EQ("string2", *actual[1]) << "entry should match";
+	EXPECT_EQ(nullptr, actual[2]) << "should be null";
+	ASSERT_NE(nullptr, actual[3]) << "should not be null";
+	EXPECT_EQ("string3", *actual[3]) << "entry should match";
+}
+
+TEST(ArgumentsCase, ListArgumentListArgumentStrings)
+{
+	auto jsonListOfListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
+		["list1string1", "list1string2"],
+		["list2string1", "list2string2"]
+	]})js"));
+	std::vector<std::vector<std::string>> actual;
+
+	try
+	{
+		actual = service::StringArgument<
+			service::TypeModifier::List,
+			service::TypeModifier::List
+		>::require("value", jsonListOfListOfStrings.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+
+	ASSERT_EQ(2, actual.size()) << "should get 2 entries";
+	ASSERT_EQ(2, actual[0].size()) << "should get 2 entries";
+	EXPECT_EQ("list1string1", actual[0][0]) << "entry should match";
+	EXPECT_EQ("list1string2", actual[0][1]) << "entry should match";
+	ASSERT_EQ(2, actual[1].size()) << "should get 2 entries";
+	EXPECT_EQ("list2string1", actual[1][0]) << "entry should match";
+	EXPECT_EQ("list2string2", actual[1][1]) << "entry should match";
+}
+
+TEST(ArgumentsCase, ListArgumentNullableListArgumentStrings)
+{
+	auto jsonListOfListOfStrings = web::json::value::parse(_XPLATSTR(R"js({"value":[
+		null,
+		["list2string1", "list2string2"]
+	]})js"));
+	std::vector<std::unique_ptr<std::vector<std::string>>> actual;
+
+	try
+	{
+		actual = service::StringArgument<
+			service::TypeModifier::List,
+			service::TypeModifier::Nullable,
+			service::TypeModifier::List
+		>::require("value", jsonListOfListOfStrings.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+
+	ASSERT_EQ(2, actual.size()) << "should get 2 entries";
+	EXPECT_EQ(nullptr, actual[0].get()) << "should be null";
+	ASSERT_EQ(2, actual[1]->size()) << "should get 2 entries";
+	EXPECT_EQ("list2string1", (*actual[1])[0]) << "entry should match";
+	EXPECT_EQ("list2string2", (*actual[1])[1]) << "entry should match";
+}
+
+TEST(ArgumentsCase, FloatVariableFromInt)
+{
+	auto document = service::ParsedDocument::parse(R"gql(query Float($value: Float, $list: [Float!], $defaulted: Float = 1) {
+			__typename
+		})gql");
+	const auto variables = service::getOperationVariables(*document->getOperation("").definition, web::json::value::object({
+		{ _XPLATSTR("value"), web::json::value::number(2) },
+		{ _XPLATSTR("list"), web::json::value::array({ web::json::value::number(3), web::json::value::number(4.5) }) }
+		}).as_object());
+
+	try
+	{
+		const auto& members = variables.as_object();
+
+		EXPECT_EQ(2.0, service::FloatArgument<>::require("value", members)) << "should accept an Int value for a Float";
+		EXPECT_EQ(1.0, service::FloatArgument<>::require("defaulted", members)) << "should accept an Int default value";
+
+		auto list = service::FloatArgument<service::TypeModifier::List>::require("list", members);
+
+		ASSERT_EQ(2, list.size());
+		EXPECT_EQ(3.0, list[0]);
+		EXPECT_EQ(4.5, list[1]);
+	}
+	catch (const service::schema_exception& ex)
+	{
+		FAIL() << utility::conversions::to_utf8string(ex.getErrors().serialize());
+	}
+}
+
+TEST(ArgumentsCase, TaskStateEnum)
+{
+	auto jsonTaskState = web::json::value::parse(_XPLATSTR(R"js({"status":"Started"})js"));
+	today::TaskState actual = static_cast<today::TaskState>(-1);
+
+	try
+	{
+		actual = service::ModifiedArgument<today::TaskState>::require("status", jsonTaskState.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
 
 		errors << ex.getErrors();
 		FAIL() << errors.str();
@@ -641,3 +1897,646 @@ TEST(ArgumentsCase, TaskStateEnum)
 	EXPECT_EQ(today::TaskState::Started, actual) << "should parse the enum";
 }
 
+TEST(ArgumentsCase, ListArgumentInputDefaults)
+{
+	auto jsonListOfInputs = web::json::value::parse(_XPLATSTR(R"js({"inputs":[
+		{"id":"ZmFrZQ=="},
+		{"id":"ZmFrZQ==","isComplete":false,"clientMutationId":"Hi There!"},
+		{"id":"ZmFrZQ==","isComplete":null}
+	]})js"));
+	std::vector<today::CompleteTaskInput> actual;
+
+	try
+	{
+		actual = service::ModifiedArgument<today::CompleteTaskInput, service::TypeModifier::List>::require("inputs", jsonListOfInputs.as_object());
+	}
+	catch (const service::schema_exception& ex)
+	{
+		utility::ostringstream_t errors;
+
+		errors << ex.getErrors();
+		FAIL() << errors.str();
+	}
+
+	const std::vector<unsigned char> fakeId { 'f', 'a', 'k', 'e' };
+
+	ASSERT_EQ(3, actual.size()) << "should get 3 entries";
+	EXPECT_EQ(fakeId, actual[0].id) << "id should match";
+	ASSERT_TRUE(actual[0].isComplete) << "should get the default value";
+	EXPECT_TRUE(*actual[0].isComplete) << "should get the default value";
+	EXPECT_FALSE(actual[0].clientMutationId) << "should be null";
+	ASSERT_TRUE(actual[1].isComplete) << "should be set";
+	EXPECT_FALSE(*actual[1].isComplete) << "should override the default value";
+	ASSERT_TRUE(actual[1].clientMutationId) << "should be set";
+	EXPECT_EQ("Hi There!", *actual[1].clientMutationId) << "clientMutationId should match";
+	EXPECT_FALSE(actual[2].isComplete) << "explicit null should override the default value";
+}
+
+
+TEST(DocumentCacheCase, EvictLeastRecentlyUsed)
+{
+	service::DocumentCache cache(2);
+	auto first = cache.get("{ first: __typename }");
+
+	cache.get("{ second: __typename }");
+	EXPECT_EQ(first, cache.get("{ first: __typename }")) << "should reuse the cached document";
+	cache.get("{ third: __typename }");
+
+	auto stats = cache.getStats();
+
+	EXPECT_EQ(2, stats.entries) << "should be limited to 2 entries";
+	EXPECT_EQ(1, stats.evictions) << "should evict 1 entry";
+	EXPECT_EQ(1, stats.hits) << "should hit the cache once";
+	EXPECT_EQ(3, stats.misses) << "should miss the cache for each new query";
+
+	EXPECT_EQ(first, cache.get("{ first: __typename }")) << "recently used document should still be cached";
+	cache.get("{ second: __typename }");
+	EXPECT_EQ(4, cache.getStats().misses) << "least recently used document should have been evicted";
+}
+
+TEST(DocumentCacheCase, MemoryLimit)
+{
+	service::DocumentCache cache(service::DocumentCache::c_defaultMaxEntries, 1);
+	auto document = cache.get("{ __typename }");
+	auto stats = cache.getStats();
+
+	ASSERT_NE(nullptr, document.get()) << "should still parse the document";
+	EXPECT_EQ(0, stats.entries) << "documents larger than the limit should not be cached";
+	EXPECT_EQ(0, stats.bytes) << "should not use any memory";
+}
+
+TEST(FieldResultCase, ValueOrFuture)
+{
+	service::FieldResult<std::string> value("ready");
+	service::FieldResult<std::string> future(std::async(std::launch::async, []()
+	{
+		return std::string("later");
+	}));
+
+	EXPECT_TRUE(value.is_ready()) << "values should be ready right away";
+	EXPECT_EQ("ready", value.get()) << "should return the value";
+	EXPECT_FALSE(future.is_ready()) << "futures need to be joined";
+	EXPECT_EQ("later", future.get()) << "should wait for the future";
+}
+
+TEST(FieldResultCase, SharedStrings)
+{
+	auto variables = web::json::value::object();
+	auto arguments = web::json::value::object();
+	service::DataLoaderScope loaders;
+	auto arena = std::make_shared<service::RequestArena>();
+	service::OperationParams operation { variables.as_object(), nullptr, std::launch::deferred, nullptr, loaders, nullptr, *arena, nullptr, nullptr, 0, nullptr, nullptr };
+	today::Task task(std::vector<unsigned char> { 'i', 'd' }, "Shared", false);
+
+	auto first = task.getTitle(service::FieldParams { nullptr, operation }).get();
+	auto second = task.getTitle(service::FieldParams { nullptr, operation }).get();
+
+	ASSERT_TRUE(first) << "should return the title";
+	EXPECT_EQ(first.get(), second.get()) << "every call should share the same string";
+	EXPECT_EQ(web::json::value::string(_XPLATSTR("Shared")),
+		service::SharedStringResult<service::TypeModifier::Nullable>::convert(first, service::ResolverParams { arguments.as_object(), nullptr, operation, nullptr, nullptr }))
+		<< "should convert the shared string";
+	EXPECT_TRUE(service::SharedStringResult<service::TypeModifier::Nullable>::convert(std::shared_ptr<const std::string>(),
+		service::ResolverParams { arguments.as_object(), nullptr, operation, nullptr, nullptr }).is_null())
+		<< "an empty shared_ptr should be null";
+	EXPECT_THROW(service::SharedStringResult<>::convert(std::shared_ptr<const std::string>(),
+		service::ResolverParams { arguments.as_object(), nullptr, operation, nullptr, nullptr }), service::schema_exception)
+		<< "non-nullable fields need a value";
+	EXPECT_EQ(web::json::value::string(_XPLATSTR("aWQ=")),
+		service::SharedIdResult<>::convert(task.getId(service::FieldParams { nullptr, operation }).get(),
+			service::ResolverParams { arguments.as_object(), nullptr, operation, nullptr, nullptr }))
+		<< "should encode the shared ID";
+}
+
+TEST(FieldTableCase, FindSortedNames)
+{
+	static const char* const names[] = {
+		"__typename",
+		"id",
+		"name",
+		"unreadCount",
+	};
+	const service::FieldTable fields { names, 4 };
+
+	EXPECT_EQ(0, fields.find("__typename")) << "should find the first name";
+	EXPECT_EQ(2, fields.find("name")) << "should find the index in the table";
+	EXPECT_EQ(3, fields.find("unreadCount")) << "should find the last name";
+	EXPECT_EQ(4, fields.find("nam")) << "should not match a prefix";
+	EXPECT_EQ(4, fields.find("names")) << "should not match a longer name";
+	EXPECT_EQ(4, fields.find("zzz")) << "should not find names past the end";
+}
+
+TEST(FieldTableCase, SharedObjectType)
+{
+	today::Task first(std::vector<unsigned char> { '1' }, "First", false);
+	today::Task second(std::vector<unsigned char> { '2' }, "Second", true);
+
+	EXPECT_EQ("Task", first.getTypeName()) << "should have the type name";
+	EXPECT_EQ(&first.getTypeName(), &second.getTypeName()) << "every instance should share the same ObjectType";
+}
+
+TEST(ExecutorCase, NestedTasks)
+{
+	service::ThreadPool pool(2);
+	service::OperationExecutor executor(pool, 0);
+	std::vector<std::future<web::json::value>> futures;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		futures.push_back(executor.submit([&executor, i]()
+		{
+			auto nested = executor.submit([i]()
+			{
+				return web::json::value::number(i * 2);
+			});
+
+			return executor.join(nested);
+		}));
+	}
+
+	for (int i = 0; i < 100; ++i)
+	{
+		EXPECT_EQ(i * 2, executor.join(futures[i]).as_integer()) << "should join every task in order";
+	}
+}
+
+TEST(ExecutorCase, MaxConcurrentTasks)
+{
+	service::ThreadPool pool(2);
+	service::OperationExecutor executor(pool, 1);
+	std::promise<void> release;
+	auto blocked = release.get_future().share();
+	auto first = executor.submit([blocked]()
+	{
+		blocked.wait();
+		return web::json::value::boolean(true);
+	});
+	const auto callerThread = std::this_thread::get_id();
+	auto second = executor.submit([callerThread]()
+	{
+		return web::json::value::boolean(std::this_thread::get_id() == callerThread);
+	});
+
+	EXPECT_EQ(std::future_status::ready, second.wait_for(std::chrono::seconds(0))) << "should run the task right away once the operation is at its limit";
+	EXPECT_TRUE(second.get().as_bool()) << "should run the task on the calling thread";
+
+	release.set_value();
+	EXPECT_TRUE(executor.join(first).as_bool()) << "should still finish the first task";
+}
+
+TEST(DataLoaderCase, BatchAndMemoize)
+{
+	std::vector<std::vector<int>> batches;
+	service::DataLoader<int, int> loader([&batches](const std::vector<int>& keys)
+	{
+		std::vector<int> values(keys.size());
+
+		batches.push_back(keys);
+		std::transform(keys.cbegin(), keys.cend(), values.begin(),
+			[](int key)
+		{
+			return key * 10;
+		});
+
+		return values;
+	});
+	auto variables = web::json::value::object();
+	service::DataLoaderScope loaders;
+	auto arena = std::make_shared<service::RequestArena>();
+	service::OperationParams operation { variables.as_object(), nullptr, std::launch::deferred, nullptr, loaders, nullptr, *arena, nullptr, nullptr, 0, nullptr, nullptr };
+	service::FieldParams params { nullptr, operation };
+
+	auto first = loader.load(params, 1);
+	auto second = loader.load(params, 2);
+	auto duplicate = loader.load(params, 1);
+
+	EXPECT_TRUE(batches.empty()) << "should not load anything until a value is joined";
+	EXPECT_EQ(20, second.get()) << "should return the loaded value";
+	EXPECT_EQ(10, first.get()) << "should return the loaded value";
+	EXPECT_EQ(10, duplicate.get()) << "should return the loaded value";
+	ASSERT_EQ(1, batches.size()) << "should load all of the keys in a single batch";
+	EXPECT_EQ((std::vector<int> { 1, 2 }), batches.front()) << "should load each key once";
+
+	auto memoized = loader.load(params, 2);
+
+	EXPECT_TRUE(memoized.is_ready()) << "should memoize the values for the rest of the operation";
+	EXPECT_EQ(20, memoized.get()) << "should return the memoized value";
+
+	auto many = loader.loadMany(params, { 2, 3 });
+
+	EXPECT_EQ((std::vector<int> { 20, 30 }), many.get()) << "should return the values in order";
+	ASSERT_EQ(2, batches.size()) << "should only load the new key";
+	EXPECT_EQ((std::vector<int> { 3 }), batches.back()) << "should only load the new key";
+}
+
+TEST(DataLoaderCase, BatchInParallel)
+{
+	constexpr int c_keyCount = 8;
+	std::mutex batchesMutex;
+	std::vector<std::vector<int>> batches;
+	service::DataLoader<int, int> loader([&batchesMutex, &batches](const std::vector<int>& keys)
+	{
+		std::lock_guard<std::mutex> lock(batchesMutex);
+
+		batches.push_back(keys);
+		return keys;
+	});
+	const auto loadValue = [&loader](int key, service::ResolverParams&& params)
+	{
+		return service::ModifiedResult<int>::convert(loader.load(service::FieldParams { params.selection, params.operation }, key), std::move(params));
+	};
+	auto query = std::make_shared<service::Object>("Query", service::TypeNames { "Query" }, service::ResolverMap {
+		{ "value", [&loadValue](service::ResolverParams&& params)
+		{
+			const auto key = service::ModifiedArgument<int>::require("key", params.arguments);
+
+			return loadValue(key, std::move(params));
+		} },
+		{ "items", [&loadValue](service::ResolverParams&& params)
+		{
+			std::vector<std::shared_ptr<service::Object>> items;
+
+			for (int i = 0; i < c_keyCount; ++i)
+			{
+				items.push_back(std::make_shared<service::Object>("Item", service::TypeNames { "Item" }, service::ResolverMap {
+					{ "value", [&loadValue, i](service::ResolverParams&& paramsArg)
+					{
+						return loadValue(i, std::move(paramsArg));
+					} }
+					}));
+			}
+
+			return service::ModifiedResult<service::Object, service::TypeModifier::List>::convert(
+				service::FieldResult<std::vector<std::shared_ptr<service::Object>>>(std::move(items)), std::move(params));
+		} }
+		});
+	std::ostringstream siblings;
+
+	siblings << "{";
+
+	for (int i = 0; i < c_keyCount; ++i)
+	{
+		siblings << " v" << i << ": value(key: " << i << ")";
+	}
+
+	siblings << " }";
+
+	const service::RequestOptions threadPool { nullptr, std::make_shared<service::ThreadPool>(4), 0, nullptr, false, nullptr, nullptr, nullptr, 0, false, nullptr };
+	const std::vector<std::pair<std::launch, service::RequestOptions>> configurations {
+		{ std::launch::deferred, {} },
+		{ std::launch::async, {} },
+		{ std::launch::deferred, threadPool },
+	};
+
+	for (const auto& configuration : configurations)
+	{
+		service::Request request(service::TypeMap { { "query", query } }, configuration.second);
+		auto result = request.resolve(siblings.str(), "", web::json::value::object().as_object(), configuration.first);
+
+		ASSERT_EQ(1, batches.size()) << "should load the sibling fields in a single batch";
+		EXPECT_EQ(c_keyCount, batches.front().size()) << "should load every sibling";
+		EXPECT_EQ(c_keyCount - 1, result[_XPLATSTR("data")][_XPLATSTR("v7")].as_integer());
+		batches.clear();
+
+		result = request.resolve("{ items { value } }", "", web::json::value::object().as_object(), configuration.first);
+
+		ASSERT_EQ(1, batches.size()) << "should load every element of the list in a single batch";
+		EXPECT_EQ(c_keyCount, batches.front().size()) << "should load every element";
+		EXPECT_EQ(c_keyCount - 1, result[_XPLATSTR("data")][_XPLATSTR("items")][c_keyCount - 1][_XPLATSTR("value")].as_integer());
+		batches.clear();
+	}
+}
+
+TEST(ArenaCase, AllocateAndRelease)
+{
+	auto arena = std::make_shared<service::RequestArena>(256);
+
+	{
+		std::vector<int, service::ArenaAllocator<int>> values { service::ArenaAllocator<int>(*arena) };
+
+		for (int i = 0; i < 100; ++i)
+		{
+			values.push_back(i);
+		}
+
+		EXPECT_EQ(99, values.back()) << "should grow the vector in the arena";
+	}
+
+	auto small = arena->allocate(1, 1);
+	auto aligned = arena->allocate(sizeof(double), alignof(double));
+	auto large = arena->allocate(1024, alignof(double));
+
+	EXPECT_NE(nullptr, small);
+	EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(aligned) % alignof(double)) << "should align the allocation";
+	EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(large) % alignof(double)) << "should align blocks of their own";
+	EXPECT_LE(1024 + 100 * sizeof(int), arena->getAllocatedBytes()) << "should count all of the allocations";
+
+	auto shared = arena->make_shared<std::string>("still here");
+	std::weak_ptr<service::RequestArena> weakArena(arena);
+
+	arena.reset();
+
+	EXPECT_FALSE(weakArena.expired()) << "objects from the arena should keep it alive";
+	EXPECT_EQ("still here", *shared);
+
+	shared.reset();
+
+	EXPECT_TRUE(weakArena.expired()) << "should release the arena with the last object";
+}
+
+TEST(ArenaCase, ConcurrentAllocations)
+{
+	constexpr size_t c_threadCount = 4;
+	constexpr size_t c_allocationCount = 1000;
+	service::RequestArena arena(1024);
+	std::vector<std::vector<size_t*>> allocations(c_threadCount);
+	std::vector<std::thread> threads;
+
+	for (size_t i = 0; i < c_threadCount; ++i)
+	{
+		threads.emplace_back([&arena, &allocations, i]()
+		{
+			for (size_t j = 0; j < c_allocationCount; ++j)
+			{
+				auto value = static_cast<size_t*>(arena.allocate(sizeof(size_t), alignof(size_t)));
+
+				*value = i * c_allocationCount + j;
+				allocations[i].push_back(value);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (size_t i = 0; i < c_threadCount; ++i)
+	{
+		for (size_t j = 0; j < c_allocationCount; ++j)
+		{
+			ASSERT_EQ(i * c_allocationCount + j, *allocations[i][j]) << "allocations should not overlap";
+		}
+	}
+
+	EXPECT_EQ(c_threadCount * c_allocationCount, arena.getAllocationCount());
+	EXPECT_LE(c_threadCount * c_allocationCount * sizeof(size_t), arena.getAllocatedBytes());
+}
+
+TEST(ComplexityCase, FieldCostsAndListSizes)
+{
+	auto document = service::ParsedDocument::parse(R"gql(query {
+			appointments(first: 10) {
+				edges {
+					node {
+						id
+						...Subject
+					}
+				}
+			}
+			unreadCounts(last: 3) {
+				edges {
+					node {
+						unreadCount
+					}
+				}
+			}
+		}
+
+		fragment Subject on Appointment {
+			subject
+		})gql");
+	service::ComplexityLimits limits { 0, 0, { { "unreadCount", 5 } } };
+	const auto complexity = service::measureComplexity(*document->getOperation("").selection, web::json::value::object().as_object(), limits);
+
+	EXPECT_EQ(4, complexity.depth) << "should count the nested selection sets";
+	EXPECT_EQ((1 + 10 * 4) + (1 + 3 * (2 + 5)), complexity.cost) << "should multiply by the list sizes and apply the field costs";
+}
+
+TEST(ComplexityCase, FragmentExplosion)
+{
+	std::ostringstream query;
+
+	query << "{ ...F0 }";
+
+	for (int i = 0; i < 20; ++i)
+	{
+		query << " fragment F" << i << " on Query { a" << i << ": __typename ...F" << (i + 1) << " b" << i << ": __typename ...F" << (i + 1) << " }";
+	}
+
+	query << " fragment F20 on Query { __typename }";
+
+	auto document = service::ParsedDocument::parse(query.str());
+	const auto& plan = document->getOperation("");
+
+	ASSERT_TRUE(plan.error) << "should refuse to expand all of the fragments";
+
+	utility::ostringstream_t errors;
+
+	errors << plan.error->getErrors();
+	EXPECT_NE(std::string::npos, utility::conversions::to_utf8string(errors.str()).find("Too many fields after expanding fragments")) << "should report the limit";
+}
+
+TEST(CacheControlCase, FieldCache)
+{
+	service::FieldCache<int, std::string> cache({ 60, service::CacheScope::Private });
+	size_t loadCount = 0;
+	const auto loader = [&loadCount](int key)
+	{
+		++loadCount;
+		return std::to_string(key);
+	};
+	auto variables = web::json::value::object();
+	service::DataLoaderScope loaders;
+	auto arena = std::make_shared<service::RequestArena>();
+	service::CachePolicy policy;
+	service::OperationParams operation { variables.as_object(), nullptr, std::launch::deferred, nullptr, loaders, nullptr, *arena, nullptr, &policy, 0, nullptr, nullptr };
+	service::FieldParams params { nullptr, operation };
+
+	EXPECT_EQ("1", cache.get(params, 1, loader)) << "should load the value";
+	EXPECT_EQ("1", cache.get(params, 1, loader)) << "should return the cached value";
+	EXPECT_EQ(1, loadCount) << "should only load the value once";
+	EXPECT_EQ("2", cache.get(params, 2, loader)) << "should load each key";
+	EXPECT_EQ(2, loadCount) << "should load each key";
+
+	ASSERT_TRUE(policy.isCacheable()) << "should add a cache hint";
+	EXPECT_GE(60, policy.getHint().maxAge) << "should not cache the response for longer than the value";
+	EXPECT_TRUE(service::CacheScope::Private == policy.getHint().scope) << "should keep the scope";
+
+	policy.addHint({ 0, service::CacheScope::Public });
+	EXPECT_FALSE(policy.isCacheable()) << "should not be cacheable with a maxAge of 0";
+}
+
+TEST(PaginationCase, ConnectionIndex)
+{
+	std::vector<std::shared_ptr<today::Task>> tasks;
+
+	for (unsigned char i = 0; i < 10; ++i)
+	{
+		// Reverse the ids so the index order doesn't match the connection order.
+		tasks.push_back(std::make_shared<today::Task>(std::vector<unsigned char>({ 'p', static_cast<unsigned char>('9' - i) }), "Task " + std::to_string(i), false));
+	}
+
+	service::ConnectionIndex<today::Task> index(std::move(tasks),
+		[](const today::Task& task) -> const std::vector<unsigned char>&
+	{
+		return task.id();
+	});
+	const auto cursorAt = [&index](size_t position)
+	{
+		return service::makeCursor(index.nodes()[position]->id());
+	};
+
+	EXPECT_TRUE(index.find({ 'p', '6' }) == index.nodes()[3]) << "should find each id";
+	EXPECT_TRUE(index.find({ 'q', '0' }) == nullptr) << "should not find missing ids";
+
+	const int first = 3;
+	const auto after = cursorAt(2);
+	auto page = index.slice(&first, &after, nullptr, nullptr);
+
+	EXPECT_EQ(3, page.offset) << "should start after the cursor";
+	EXPECT_EQ(3, page.size()) << "should take the first 3";
+	EXPECT_TRUE(page.nodes.get() == &index.nodes()) << "should share the nodes";
+	EXPECT_TRUE(page.hasNextPage);
+	EXPECT_TRUE(page.hasPreviousPage);
+
+	const int last = 2;
+	const auto before = cursorAt(8);
+	page = index.slice(nullptr, &after, &last, &before);
+
+	EXPECT_EQ(6, page.offset) << "should end before the cursor";
+	EXPECT_EQ(2, page.size()) << "should take the last 2";
+	EXPECT_TRUE(*page.cbegin() == index.nodes()[6]);
+
+	page = index.slice(nullptr, nullptr, nullptr, nullptr);
+	EXPECT_EQ(10, page.size()) << "should return everything";
+	EXPECT_FALSE(page.hasNextPage);
+	EXPECT_FALSE(page.hasPreviousPage);
+
+	const int negative = -1;
+	const auto invalid = web::json::value::number(1);
+
+	EXPECT_THROW(index.slice(&negative, nullptr, nullptr, nullptr), service::schema_exception);
+	EXPECT_THROW(index.slice(nullptr, &invalid, nullptr, nullptr), service::schema_exception);
+}
+
+TEST(PersistedQueryCase, Sha256)
+{
+	EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", service::sha256Hex(""));
+	EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", service::sha256Hex("abc"));
+	EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+		service::sha256Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")) << "should pad into a second block";
+}
+
+TEST(LazyCase, LoadOnce)
+{
+	std::atomic<size_t> loadCount(0);
+	service::Lazy<std::string> lazy([&loadCount]()
+	{
+		if (loadCount++ == 0)
+		{
+			throw std::runtime_error("try again");
+		}
+
+		return std::string("loaded");
+	});
+
+	EXPECT_THROW(lazy.get(), std::runtime_error) << "should pass the exception to the caller";
+	EXPECT_FALSE(lazy.isLoaded());
+
+	std::vector<std::thread> threads;
+	std::atomic<size_t> matches(0);
+
+	for (size_t i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([&lazy, &matches]()
+		{
+			if (lazy.get() == "loaded")
+			{
+				++matches;
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(2, loadCount) << "should only load once after the first attempt failed";
+	EXPECT_EQ(8, matches);
+	EXPECT_TRUE(lazy.isLoaded());
+}
+
+TEST(LazyCase, LazyMap)
+{
+	std::atomic<size_t> loadCount(0);
+	service::LazyMap<int, std::string> lazy([&loadCount](const int& key)
+	{
+		++loadCount;
+		return std::to_string(key);
+	});
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([&lazy, i]()
+		{
+			lazy.get(i % 2);
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(2, loadCount) << "should load each key once";
+	EXPECT_EQ(2, lazy.size());
+	EXPECT_EQ("1", lazy.get(1));
+}
+
+TEST(MetricsCase, ShardedCounters)
+{
+	service::Metrics metrics;
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < 8; ++i)
+	{
+		threads.emplace_back([&metrics]()
+		{
+			for (int j = 0; j < 1000; ++j)
+			{
+				metrics.add(service::MetricCounter::Requests);
+			}
+
+			metrics.addFieldError("Query", "node");
+		});
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	metrics.recordLatency(service::MetricStage::Parse, std::chrono::microseconds(40));
+	metrics.recordLatency(service::MetricStage::Parse, std::chrono::microseconds(300));
+	metrics.recordLatency(service::MetricStage::Parse, std::chrono::seconds(10));
+
+	const auto snapshot = metrics.getSnapshot();
+	const auto& parse = snapshot.getLatency(service::MetricStage::Parse);
+
+	EXPECT_EQ(8000, snapshot.getCounter(service::MetricCounter::Requests)) << "should add up every shard";
+	EXPECT_EQ(8, snapshot.fieldErrors.at("Query.node"));
+	EXPECT_EQ(3, parse.count);
+	EXPECT_EQ(10000340, parse.sum.count());
+	EXPECT_EQ(1, parse.buckets[0]);
+	EXPECT_EQ(1, parse.buckets[3]);
+	EXPECT_EQ(1, parse.buckets[service::LatencyHistogram::c_bucketCount - 1]) << "should put slow requests in the last bucket";
+
+	const auto exported = metrics.toPrometheus("test");
+
+	EXPECT_NE(std::string::npos, exported.find("test_stage_duration_seconds_bucket{stage=\"parse\",le=\"0.0005\"} 2\n")) << "buckets should be cumulative";
+	EXPECT_NE(std::string::npos, exported.find("test_stage_duration_seconds_bucket{stage=\"parse\",le=\"+Inf\"} 3\n"));
+	EXPECT_NE(std::string::npos, exported.find("test_stage_duration_seconds_count{stage=\"parse\"} 3\n"));
+}